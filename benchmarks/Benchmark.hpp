@@ -0,0 +1,53 @@
+#ifndef __UNIQUE_BENCHMARK_HPP__
+#define __UNIQUE_BENCHMARK_HPP__
+
+// ─────────────────────────────────────────────────────────────
+//                  INCLUDE
+// ─────────────────────────────────────────────────────────────
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+// ─────────────────────────────────────────────────────────────
+//                  DECLARATION
+// ─────────────────────────────────────────────────────────────
+
+namespace unique {
+namespace benchmark {
+
+/** Written by doNotOptimize so that the compiler keep the computation of benchmarked values */
+inline volatile std::uint64_t& sink()
+{
+    static volatile std::uint64_t value = 0;
+    return value;
+}
+
+template<typename T>
+void doNotOptimize(const T& value)
+{
+    sink() = sink() + static_cast<std::uint64_t>(value);
+}
+
+/**
+ * Run function once and print its duration divided by operations.
+ * \return Nanoseconds per operation
+ */
+template<class Function>
+double measure(const char* name, const std::size_t operations, Function function)
+{
+    const auto start = std::chrono::steady_clock::now();
+    function();
+    const auto end = std::chrono::steady_clock::now();
+
+    const auto nanoseconds = std::chrono::duration<double, std::nano>(end - start).count();
+    const auto perOperation = operations ? nanoseconds / double(operations) : nanoseconds;
+    std::printf("%-48s %12.2f ns/op\n", name, perOperation);
+    return perOperation;
+}
+
+}
+}
+
+#endif
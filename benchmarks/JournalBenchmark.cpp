@@ -0,0 +1,82 @@
+// C++ Header
+
+// Unique
+#include <Unique/IdProvider.hpp>
+#include <Unique/JournaledIdProvider.hpp>
+
+// Std
+#include <cstdio>
+#include <optional>
+#include <string>
+
+// Benchmark
+#include "Benchmark.hpp"
+
+using namespace unique;
+
+using Ids = IdProvider<uint32_t, 1, 0xFFFFFFFF>;
+
+/** Id taken by a provider, JournaledIdProvider return it as an optional */
+template<class T>
+T idValue(const T id)
+{
+    return id;
+}
+
+template<class T>
+T idValue(const std::optional<T>& id)
+{
+    return *id;
+}
+
+/** Take count ids then release them, the same workload with and without journal */
+template<class Provider>
+void takeRelease(Provider& idProvider, const std::size_t count)
+{
+    for(std::size_t i = 0; i < count; ++i) benchmark::doNotOptimize(idValue(idProvider.takeNextId()));
+    for(std::size_t i = 0; i < count; i += 2) idProvider.releaseId(static_cast<uint32_t>(1 + i));
+    for(std::size_t i = 0; i < count; i += 2) benchmark::doNotOptimize(idValue(idProvider.takeNextId()));
+}
+
+int main()
+{
+    constexpr std::size_t count = 200000;
+    constexpr std::size_t operations = count + count / 2 + count / 2;
+    const std::string checkpointPath = "JournalBenchmark.checkpoint";
+    const std::string journalPath = "JournalBenchmark.journal";
+
+    {
+        Ids idProvider;
+        benchmark::measure("IdProvider, no journal", operations, [&]() { takeRelease(idProvider, count); });
+    }
+
+    // ) Each commit is a write and an fsync, the group size amortize it
+    const std::size_t groupSizes[] = {1, 16, 256, 4096};
+    for(const auto groupSize: groupSizes)
+    {
+        // ) Start each group size from empty files, not from the ids left by the previous run
+        std::remove(checkpointPath.c_str());
+        std::remove(journalPath.c_str());
+
+        JournaledIdProvider<Ids> idProvider(groupSize);
+        if(!idProvider.open(checkpointPath, journalPath))
+        {
+            std::printf("Can't open %s\n", journalPath.c_str());
+            return 1;
+        }
+
+        // ) Group size 1 sync every record, keep the run short
+        const auto runCount = groupSize == 1 ? count / 100 : count;
+        const std::string name = "JournaledIdProvider, group of " + std::to_string(groupSize);
+        benchmark::measure(name.c_str(), runCount + runCount / 2 + runCount / 2, [&]()
+        {
+            takeRelease(idProvider, runCount);
+            idProvider.commit();
+        });
+        benchmark::measure("  checkpoint", 1, [&]() { idProvider.checkpoint(); });
+    }
+
+    std::remove(checkpointPath.c_str());
+    std::remove(journalPath.c_str());
+    return 0;
+}
@@ -0,0 +1,174 @@
+// C++ Header
+
+// Unique
+#include <Unique/BTreeMap.hpp>
+#include <Unique/DenseMap.hpp>
+#include <Unique/FlatUnorderedMap.hpp>
+#include <Unique/FlatMap.hpp>
+#include <Unique/Map.hpp>
+#include <Unique/UnorderedMap.hpp>
+
+// Std
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Benchmark
+#include "Benchmark.hpp"
+
+using namespace unique;
+
+namespace {
+
+/** Bytes allocated and not freed yet, to compare the memory of each map */
+std::size_t liveBytes = 0;
+std::size_t allocationCount = 0;
+
+}
+
+void* operator new(std::size_t size)
+{
+    // ) The size is stored in front of the block to be given back in delete
+    auto* block = static_cast<std::size_t*>(std::malloc(size + sizeof(std::max_align_t)));
+    if(!block)
+        throw std::bad_alloc();
+    *block = size;
+    liveBytes += size;
+    ++allocationCount;
+    return reinterpret_cast<char*>(block) + sizeof(std::max_align_t);
+}
+
+void operator delete(void* pointer) noexcept
+{
+    if(!pointer)
+        return;
+    auto* block = reinterpret_cast<std::size_t*>(static_cast<char*>(pointer) - sizeof(std::max_align_t));
+    liveBytes -= *block;
+    std::free(block);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept { operator delete(pointer); }
+
+/** Over aligned blocks, as the cache line aligned nodes of BPlusTree, keep the size in front of the alignment */
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    const auto align = static_cast<std::size_t>(alignment);
+    auto* block = static_cast<std::size_t*>(std::aligned_alloc(align, (size + 2 * align - 1) / align * align));
+    if(!block)
+        throw std::bad_alloc();
+    *block = size;
+    liveBytes += size;
+    ++allocationCount;
+    return reinterpret_cast<char*>(block) + align;
+}
+
+void operator delete(void* pointer, std::align_val_t alignment) noexcept
+{
+    if(!pointer)
+        return;
+    auto* block = reinterpret_cast<std::size_t*>(static_cast<char*>(pointer) - static_cast<std::size_t>(alignment));
+    liveBytes -= *block;
+    std::free(block);
+}
+
+void operator delete(void* pointer, std::size_t, std::align_val_t alignment) noexcept
+{
+    operator delete(pointer, alignment);
+}
+
+/** Key2 longer than the small string buffer, as paths or names would be */
+std::string nameOf(const uint32_t id) { return "/objects/by-id/" + std::to_string(id) + "/name"; }
+
+template<class Bimap, class = void>
+struct HasReserve : std::false_type
+{
+};
+
+template<class Bimap>
+struct HasReserve<Bimap, std::void_t<decltype(std::declval<Bimap&>().reserve(std::size_t()))>> : std::true_type
+{
+};
+
+/** Call map.reserve(count) on the maps that have it */
+template<class Bimap>
+void reserveIfSupported(Bimap& map, const std::size_t count)
+{
+    if constexpr(HasReserve<Bimap>::value)
+        map.reserve(count);
+}
+
+template<class Bimap>
+void run(const char* name, const std::vector<uint32_t>& ids, const std::vector<std::string>& names,
+    const std::vector<std::size_t>& order, const bool reserve = false)
+{
+    std::printf("%s\n", name);
+    const auto bytesBefore = liveBytes;
+    const auto allocationsBefore = allocationCount;
+    {
+        Bimap map;
+        benchmark::measure("  insert", ids.size(), [&]()
+        {
+            if(reserve)
+                reserveIfSupported(map, ids.size());
+            // ) One insert per pair would shift the arrays of FlatMap, it is built with a single batch
+            if constexpr(std::is_same<Bimap, FlatMap<uint32_t, std::string>>::value)
+            {
+                std::vector<std::pair<uint32_t, std::string>> pairs;
+                pairs.reserve(ids.size());
+                for(std::size_t i = 0; i < ids.size(); ++i) pairs.emplace_back(ids[i], names[i]);
+                map.insert(pairs.begin(), pairs.end());
+            }
+            else
+            {
+                for(std::size_t i = 0; i < ids.size(); ++i) map.insert({ids[i], names[i]});
+            }
+        });
+        std::printf("  %-46s %12.2f bytes/pair, %.2f allocations/pair\n", "memory",
+            double(liveBytes - bytesBefore) / double(ids.size()),
+            double(allocationCount - allocationsBefore) / double(ids.size()));
+
+        // ) Lookups in another order than inserts, so that dense storages don't get sequential accesses
+        benchmark::measure("  find by Key1", ids.size(), [&]()
+        {
+            for(const auto i: order) benchmark::doNotOptimize(map.find(ids[i])->second.size());
+        });
+        benchmark::measure("  find by Key2", ids.size(), [&]()
+        {
+            for(const auto i: order) benchmark::doNotOptimize(map.find(names[i])->second);
+        });
+        benchmark::measure("  iterate Key2", ids.size(), [&]()
+        {
+            for(auto it = map.begin2(); it != map.end2(); ++it) benchmark::doNotOptimize(it->second);
+        });
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const std::size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    std::vector<uint32_t> ids(count);
+    std::vector<std::string> names(count);
+    for(std::size_t i = 0; i < count; ++i)
+    {
+        ids[i] = static_cast<uint32_t>(i * 2654435761u);
+        names[i] = nameOf(ids[i]);
+    }
+    std::vector<std::size_t> order(count);
+    for(std::size_t i = 0; i < count; ++i) order[i] = i;
+    std::shuffle(order.begin(), order.end(), std::mt19937(42));
+
+    run<Map<uint32_t, std::string>>("Map", ids, names, order);
+    run<UnorderedMap<uint32_t, std::string>>("UnorderedMap", ids, names, order);
+    run<DenseMap<uint32_t, std::string>>("DenseMap", ids, names, order);
+    run<FlatUnorderedMap<uint32_t, std::string>>("FlatUnorderedMap", ids, names, order);
+    run<FlatUnorderedMap<uint32_t, std::string>>("FlatUnorderedMap, reserve", ids, names, order, true);
+    run<FlatMap<uint32_t, std::string>>("FlatMap, batch insert", ids, names, order);
+    run<BTreeMap<uint32_t, std::string>>("BTreeMap", ids, names, order);
+    return 0;
+}
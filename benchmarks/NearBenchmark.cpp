@@ -0,0 +1,102 @@
+// C++ Header
+
+// Unique
+#include <Unique/BitmapIdStorage.hpp>
+#include <Unique/IdProvider.hpp>
+
+// Std
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+// Benchmark
+#include "Benchmark.hpp"
+
+using namespace unique;
+
+/** One cache line per object, as a structure of arrays indexed by id would touch */
+struct Transform
+{
+    float values[16];
+};
+
+constexpr std::size_t objectCount = 1 << 21;
+constexpr std::size_t parentCount = 1 << 16;
+constexpr std::size_t childCount = 8;
+
+/** Fragment the provider like a long running process would: half of the ids are released at random */
+template<class Ids>
+void fragment(Ids& idProvider)
+{
+    std::vector<uint32_t> ids(objectCount);
+    idProvider.takeNextIds(objectCount, ids.begin());
+    std::mt19937 rng(42);
+    std::shuffle(ids.begin(), ids.end(), rng);
+    ids.resize(objectCount / 2);
+    std::sort(ids.begin(), ids.end());
+    idProvider.releaseIds(ids.begin(), ids.end());
+}
+
+/** Every parent read the transform of its children, as a per frame hierarchy update would */
+float sweep(const std::vector<Transform>& transforms, const std::vector<uint32_t>& parents,
+    const std::vector<uint32_t>& children)
+{
+    float sum = 0;
+    for(std::size_t p = 0; p < parents.size(); ++p)
+    {
+        auto value = transforms[parents[p]].values[0];
+        for(std::size_t c = 0; c < childCount; ++c)
+            value += transforms[children[p * childCount + c]].values[0];
+        sum += value;
+    }
+    return sum;
+}
+
+template<class Ids, class Allocate>
+void run(const char* name, Allocate allocate)
+{
+    Ids idProvider;
+    fragment(idProvider);
+
+    std::vector<uint32_t> parents(parentCount);
+    std::vector<uint32_t> children(parentCount * childCount);
+
+    // ) Parents are spread over the id space, and swept in id order
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<uint32_t> anywhere(0, objectCount - 1);
+    for(std::size_t p = 0; p < parentCount; ++p) parents[p] = idProvider.takeIdNear(anywhere(rng));
+    std::sort(parents.begin(), parents.end());
+
+    // ) Children are spawned over time for random parents, not parent after parent
+    std::vector<uint32_t> spawns(children.size());
+    for(std::size_t i = 0; i < spawns.size(); ++i) spawns[i] = static_cast<uint32_t>(i);
+    std::shuffle(spawns.begin(), spawns.end(), rng);
+
+    std::printf("%s\n", name);
+    benchmark::measure("  allocate children", children.size(), [&]()
+    {
+        for(const auto child: spawns)
+            children[child] = allocate(idProvider, parents[child / childCount]);
+    });
+
+    std::vector<Transform> transforms(idProvider.getNextEndId(), Transform {{1.f}});
+    constexpr int frames = 20;
+    benchmark::measure("  sweep, per child", frames * children.size(), [&]()
+    {
+        for(int frame = 0; frame < frames; ++frame)
+            benchmark::doNotOptimize(sweep(transforms, parents, children));
+    });
+}
+
+int main()
+{
+    using Intervals = IdProvider<uint32_t, 0, 0xFFFFFFFF>;
+    using Bitmap = IdProvider<uint32_t, 0, 0xFFFFFFFF, BitmapIdStorage>;
+
+    run<Intervals>("takeNextId", [](Intervals& ids, uint32_t) { return ids.takeNextId(); });
+    run<Intervals>("takeIdNear(parent)", [](Intervals& ids, uint32_t parent) { return ids.takeIdNear(parent); });
+    run<Bitmap>("takeIdNear(parent), BitmapIdStorage",
+        [](Bitmap& ids, uint32_t parent) { return ids.takeIdNear(parent); });
+    return 0;
+}
@@ -0,0 +1,93 @@
+// C++ Header
+
+// Unique
+#include <Unique/BTreeMap.hpp>
+#include <Unique/Map.hpp>
+
+// Std
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+// Benchmark
+#include "Benchmark.hpp"
+
+using namespace unique;
+
+/**
+ * Ordered bimaps of uint64_t and int64_t ids under a write heavy load with range scans, from 10^4 pairs to the
+ * count given as argument (10^6 by default). Map need about 130 bytes per pair, so 10^8 pairs need
+ * a machine with more than 16 GB of memory.
+ */
+template<class Bimap>
+void run(const char* name, const std::vector<uint64_t>& keys1, const std::vector<int64_t>& keys2)
+{
+    // ) Both keys are integers, the pair type choose the side to insert from
+    using Pair = typename Bimap::Key1ValueType;
+    const auto count = keys1.size();
+    std::printf("%s, %zu pairs\n", name, count);
+
+    std::vector<std::size_t> order(count);
+    for(std::size_t i = 0; i < count; ++i) order[i] = i;
+    std::shuffle(order.begin(), order.end(), std::mt19937(42));
+
+    Bimap map;
+    benchmark::measure("  insert random", count, [&]()
+    {
+        for(const auto i: order) map.insert(Pair(keys1[i], keys2[i]));
+    });
+    benchmark::measure("  find by Key1", count, [&]()
+    {
+        for(const auto i: order) benchmark::doNotOptimize(map.find(keys1[i])->second);
+    });
+    benchmark::measure("  find by Key2", count, [&]()
+    {
+        for(const auto i: order) benchmark::doNotOptimize(map.find(keys2[i])->second);
+    });
+    benchmark::measure("  scan Key1", count, [&]()
+    {
+        for(auto it = map.begin1(); it != map.end1(); ++it) benchmark::doNotOptimize(it->second);
+    });
+
+    // ) Short range scans from random keys, as paging through an ordered index would
+    const std::size_t rangeCount = count / 16;
+    benchmark::measure("  scan 16 from Key2", rangeCount * 16, [&]()
+    {
+        const auto& key2Map = map.key2Map();
+        for(std::size_t r = 0; r < rangeCount; ++r)
+        {
+            auto it = key2Map.lower_bound(keys2[order[r]]);
+            for(int i = 0; i < 16 && it != key2Map.end(); ++i, ++it) benchmark::doNotOptimize(it->second);
+        }
+    });
+    benchmark::measure("  erase half", count / 2, [&]()
+    {
+        for(std::size_t i = 0; i < count / 2; ++i) map.erase(keys1[order[i]]);
+    });
+    benchmark::measure("  insert back", count / 2, [&]()
+    {
+        for(std::size_t i = 0; i < count / 2; ++i) map.insert(Pair(keys1[order[i]], keys2[order[i]]));
+    });
+}
+
+int main(int argc, char** argv)
+{
+    const std::size_t maxCount = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    for(std::size_t count = 10000; count <= maxCount; count *= 10)
+    {
+        std::vector<uint64_t> keys1(count);
+        std::vector<int64_t> keys2(count);
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            keys1[i] = i * 0x9E3779B97F4A7C15ull;
+            keys2[i] = static_cast<int64_t>((i + 1) * 0xC2B2AE3D27D4EB4Full);
+        }
+        run<Map<uint64_t, int64_t>>("Map", keys1, keys2);
+        run<BTreeMap<uint64_t, int64_t>>("BTreeMap", keys1, keys2);
+    }
+    return 0;
+}
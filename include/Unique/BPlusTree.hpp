@@ -0,0 +1,788 @@
+#ifndef __UNIQUE_B_PLUS_TREE_HPP__
+#define __UNIQUE_B_PLUS_TREE_HPP__
+
+// ─────────────────────────────────────────────────────────────
+//                  INCLUDE
+// ─────────────────────────────────────────────────────────────
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+// ─────────────────────────────────────────────────────────────
+//                  DECLARATION
+// ─────────────────────────────────────────────────────────────
+
+namespace unique {
+namespace detail {
+
+/** Uninitialized array of N T. Elements are constructed and destroyed by the node that own the array */
+template<class T, std::size_t N>
+class NodeArray
+{
+    alignas(T) unsigned char _storage[N * sizeof(T)];
+
+public:
+    T* data() noexcept { return std::launder(reinterpret_cast<T*>(_storage)); }
+    const T* data() const noexcept { return std::launder(reinterpret_cast<const T*>(_storage)); }
+
+    T& operator[](const std::size_t index) noexcept { return data()[index]; }
+    const T& operator[](const std::size_t index) const noexcept { return data()[index]; }
+};
+
+/** Construct value at index of an array of count elements, shifting the elements after index */
+template<class T>
+void insertAt(T* data, const std::size_t count, const std::size_t index, T&& value)
+{
+    if(index == count)
+    {
+        ::new(static_cast<void*>(data + count)) T(std::move(value));
+        return;
+    }
+    ::new(static_cast<void*>(data + count)) T(std::move(data[count - 1]));
+    std::move_backward(data + index, data + count - 1, data + count);
+    data[index] = std::move(value);
+}
+
+/** Remove the element at index of an array of count elements, shifting the elements after index */
+template<class T>
+void eraseAt(T* data, const std::size_t count, const std::size_t index)
+{
+    std::move(data + index + 1, data + count, data + index);
+    data[count - 1].~T();
+}
+
+/** Move count elements to uninitialized destination, then destroy the sources */
+template<class T>
+void relocate(T* destination, T* source, const std::size_t count)
+{
+    std::uninitialized_move(source, source + count, destination);
+    std::destroy(source, source + count);
+}
+
+/** Count of elements of elementBytes that fit in bytes, keeping one for the overflow before a split */
+constexpr std::size_t nodeCapacity(const std::size_t bytes, const std::size_t elementBytes)
+{
+    return bytes / elementBytes > 5 ? bytes / elementBytes - 1 : 4;
+}
+
+}
+
+// ─────────────────────────────────────────────────────────────
+//                  CLASS
+// ─────────────────────────────────────────────────────────────
+
+/**
+ * Ordered map in a B+ tree, usable as Map1 or Map2 of TMap.
+ * Nodes are NODE_BYTES wide and aligned on cache lines: an inner node hold a sorted array of
+ * separator keys and its children, so a lookup read a few lines per level instead of one node per
+ * compare as in std::map. Pairs are only stored in leaves, linked both ways, so a scan is a sweep of
+ * contiguous arrays that only follow a pointer every LEAF_CAPACITY pairs.
+ *
+ * Insert split a full node in two halves, erase borrow from a sibling or merge with it, so every
+ * node but the root stay at least half full. Like SortedVectorMap, value_type is
+ * std::pair<Key, Value> so that pairs can be shifted in the leaves: keys must not be changed through
+ * iterators, and iterators are invalidated by every insert and erase.
+ * Keys are copied in the inner nodes, so Key must be copyable.
+ */
+template<class Key, class Value, class Compare = std::less<Key>>
+class BPlusTree
+{
+    // ──────── TYPES ──────────
+public:
+    using key_type = Key;
+    using mapped_type = Value;
+    using value_type = std::pair<Key, Value>;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using key_compare = Compare;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+
+    static constexpr std::size_t CACHE_LINE_BYTES = 64;
+    static constexpr std::size_t NODE_BYTES = 8 * CACHE_LINE_BYTES;
+
+    /** Count of pairs in a leaf */
+    static constexpr std::size_t LEAF_CAPACITY =
+        detail::nodeCapacity(NODE_BYTES - 3 * sizeof(void*), sizeof(value_type));
+
+    /** Count of separator keys in an inner node, that has one more child */
+    static constexpr std::size_t INNER_CAPACITY =
+        detail::nodeCapacity(NODE_BYTES - 3 * sizeof(void*), sizeof(Key) + sizeof(void*));
+
+private:
+    struct Leaf;
+
+    struct Node
+    {
+        explicit Node(const bool leaf) : isLeaf(leaf) {}
+
+        const bool isLeaf;
+        /** Pairs of a leaf, separator keys of an inner node */
+        std::size_t count = 0;
+    };
+
+    /** Each array has one more element than the capacity, filled before the node is split */
+    struct alignas(CACHE_LINE_BYTES) Leaf : Node
+    {
+        Leaf() : Node(true) {}
+
+        Leaf* prev = nullptr;
+        Leaf* next = nullptr;
+        detail::NodeArray<value_type, LEAF_CAPACITY + 1> values;
+    };
+
+    struct alignas(CACHE_LINE_BYTES) Inner : Node
+    {
+        Inner() : Node(false) {}
+
+        detail::NodeArray<Key, INNER_CAPACITY + 1> keys;
+        /** Keys of children[i] are less than keys[i], keys of children[i + 1] aren't */
+        Node* children[INNER_CAPACITY + 2];
+    };
+
+public:
+    template<bool Const>
+    class Iterator
+    {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = typename BPlusTree::value_type;
+        using difference_type = std::ptrdiff_t;
+        using reference = typename std::conditional<Const, const value_type&, value_type&>::type;
+        using pointer = typename std::conditional<Const, const value_type*, value_type*>::type;
+
+        Iterator() = default;
+
+        /** iterator convert to const_iterator */
+        template<bool OtherConst, class = typename std::enable_if<Const && !OtherConst>::type>
+        Iterator(const Iterator<OtherConst>& other) : _leaf(other._leaf), _index(other._index)
+        {
+        }
+
+        reference operator*() const { return _leaf->values[_index]; }
+        pointer operator->() const { return &_leaf->values[_index]; }
+
+        Iterator& operator++()
+        {
+            if(++_index == _leaf->count && _leaf->next)
+            {
+                _leaf = _leaf->next;
+                _index = 0;
+            }
+            return *this;
+        }
+
+        Iterator operator++(int)
+        {
+            auto result = *this;
+            ++*this;
+            return result;
+        }
+
+        Iterator& operator--()
+        {
+            if(!_index)
+            {
+                _leaf = _leaf->prev;
+                _index = _leaf->count;
+            }
+            --_index;
+            return *this;
+        }
+
+        Iterator operator--(int)
+        {
+            auto result = *this;
+            --*this;
+            return result;
+        }
+
+        friend bool operator==(const Iterator& a, const Iterator& b) { return a._leaf == b._leaf && a._index == b._index; }
+        friend bool operator!=(const Iterator& a, const Iterator& b) { return !(a == b); }
+
+    private:
+        friend class BPlusTree;
+        template<bool>
+        friend class Iterator;
+
+        Iterator(Leaf* leaf, const std::size_t index) : _leaf(leaf), _index(index) {}
+
+        /** index is only the count of the leaf in end(), on the last leaf */
+        Leaf* _leaf = nullptr;
+        std::size_t _index = 0;
+    };
+
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+private:
+    /** Inner node crossed by a descent, and the index of the child taken */
+    struct Step
+    {
+        Inner* node;
+        std::size_t child;
+    };
+
+    /** Inner nodes have at least 3 children, except the root */
+    static constexpr std::size_t MAX_DEPTH = 64;
+
+    static constexpr std::size_t LEAF_MIN = LEAF_CAPACITY / 2;
+    static constexpr std::size_t INNER_MIN = INNER_CAPACITY / 2;
+
+    Node* _root = nullptr;
+    Leaf* _first = nullptr;
+    Leaf* _last = nullptr;
+    std::size_t _size = 0;
+    Compare _compare {};
+
+private:
+    /** Index of the child of node whose keys may contain key */
+    std::size_t childIndex(const Inner* node, const Key& key) const;
+
+    /** Index of the first pair of leaf whose key isn't less than key */
+    std::size_t leafIndex(const Leaf* leaf, const Key& key) const;
+
+    /** Leaf that contain key if it is in the tree. The inner nodes crossed are written in path */
+    Leaf* descend(const Key& key, Step* path, std::size_t& depth) const;
+
+    /** Iterator on index of leaf, or on the first pair of the next leaf if index is past the leaf */
+    iterator normalize(Leaf* leaf, const std::size_t index) const;
+
+    /** Construct value at index of leaf, then split the leaf and its parents while they overflow */
+    iterator insertInLeaf(Leaf* leaf, const std::size_t index, value_type&& value, Step* path, std::size_t depth);
+
+    /** Add right after left in the parent of left, separated by separator, growing the tree if left is the root */
+    void insertInParent(Node* left, Key separator, Node* right, Step* path, std::size_t depth);
+
+    /** Erase the pair at index of leaf, then borrow or merge while nodes are less than half full */
+    iterator eraseInLeaf(Leaf* leaf, std::size_t index, Step* path, const std::size_t depth);
+
+    /** Remove the key at keyIndex of path[level] and the child after it, then rebalance the node */
+    void eraseInInner(Step* path, const std::size_t level, const std::size_t keyIndex);
+
+    /** Move the pairs of right at the end of left, and unlink right */
+    void mergeLeaves(Leaf* left, Leaf* right);
+
+    /** Move the keys and children of right at the end of left, separated by the key at keyIndex of parent */
+    static void mergeInner(Inner* left, Inner* right, Inner* parent, const std::size_t keyIndex);
+
+    /** Destroy node, its pairs or keys, and its children */
+    static void destroy(Node* node);
+
+    // ──────── C++ API ──────────
+public:
+    BPlusTree() = default;
+    BPlusTree(const BPlusTree& other);
+    BPlusTree(BPlusTree&& other) noexcept;
+    BPlusTree& operator=(const BPlusTree& other);
+    BPlusTree& operator=(BPlusTree&& other) noexcept;
+    ~BPlusTree() { clear(); }
+
+    iterator begin() noexcept { return {_first, 0}; }
+    iterator end() noexcept { return {_last, _last ? _last->count : 0}; }
+    const_iterator begin() const noexcept { return cbegin(); }
+    const_iterator end() const noexcept { return cend(); }
+    const_iterator cbegin() const noexcept { return iterator(_first, 0); }
+    const_iterator cend() const noexcept { return iterator(_last, _last ? _last->count : 0); }
+
+    bool empty() const noexcept { return !_size; }
+    std::size_t size() const noexcept { return _size; }
+    std::size_t max_size() const noexcept { return std::numeric_limits<difference_type>::max() / sizeof(value_type); }
+
+    void clear() noexcept;
+    void swap(BPlusTree& other) noexcept;
+
+    iterator lower_bound(const Key& key);
+    const_iterator lower_bound(const Key& key) const { return const_cast<BPlusTree*>(this)->lower_bound(key); }
+
+    iterator find(const Key& key);
+    const_iterator find(const Key& key) const { return const_cast<BPlusTree*>(this)->find(key); }
+
+    bool contains(const Key& key) const { return find(key) != end(); }
+    std::size_t count(const Key& key) const { return contains(key) ? 1 : 0; }
+
+    /** \brief Insert value if its key isn't in the tree */
+    std::pair<iterator, bool> insert(const value_type& value) { return try_emplace(value.first, value.second); }
+    std::pair<iterator, bool> insert(value_type&& value) { return try_emplace(std::move(value.first), std::move(value.second)); }
+
+    /**
+     * \brief Insert value, in the leaf of hint without descending from the root if value sort right
+     * before hint and the leaf isn't full. Appending in order with end() as hint only descend once per leaf
+     */
+    iterator insert(const_iterator hint, const value_type& value) { return try_emplace(hint, value.first, value.second); }
+    iterator insert(const_iterator hint, value_type&& value)
+    {
+        return try_emplace(hint, std::move(value.first), std::move(value.second));
+    }
+
+    /** \brief Construct the pair from args, kept only if its key isn't in the tree */
+    template<class... Args>
+    std::pair<iterator, bool> emplace(Args&&... args);
+
+    /** \brief Construct Value from args only if key isn't in the tree */
+    template<class K, class... Args>
+    std::pair<iterator, bool> try_emplace(K&& key, Args&&... args);
+
+    /** \brief Construct Value from args only if key isn't in the tree, in the leaf of hint if it is the right position */
+    template<class K, class... Args>
+    iterator try_emplace(const_iterator hint, K&& key, Args&&... args);
+
+    /** \brief Erase the pair at pos. \return Iterator following pos */
+    iterator erase(const_iterator pos);
+
+    /** \brief Erase the pair of key. \return Count of erased pairs, 0 or 1 */
+    std::size_t erase(const Key& key);
+};
+
+template<class Key, class Value, class Compare>
+constexpr std::size_t BPlusTree<Key, Value, Compare>::CACHE_LINE_BYTES;
+template<class Key, class Value, class Compare>
+constexpr std::size_t BPlusTree<Key, Value, Compare>::NODE_BYTES;
+template<class Key, class Value, class Compare>
+constexpr std::size_t BPlusTree<Key, Value, Compare>::LEAF_CAPACITY;
+template<class Key, class Value, class Compare>
+constexpr std::size_t BPlusTree<Key, Value, Compare>::INNER_CAPACITY;
+template<class Key, class Value, class Compare>
+constexpr std::size_t BPlusTree<Key, Value, Compare>::MAX_DEPTH;
+template<class Key, class Value, class Compare>
+constexpr std::size_t BPlusTree<Key, Value, Compare>::LEAF_MIN;
+template<class Key, class Value, class Compare>
+constexpr std::size_t BPlusTree<Key, Value, Compare>::INNER_MIN;
+
+template<class Key, class Value, class Compare>
+BPlusTree<Key, Value, Compare>::BPlusTree(const BPlusTree& other) : _compare(other._compare)
+{
+    for(const auto& value: other) insert(cend(), value);
+}
+
+template<class Key, class Value, class Compare>
+BPlusTree<Key, Value, Compare>::BPlusTree(BPlusTree&& other) noexcept
+{
+    swap(other);
+}
+
+template<class Key, class Value, class Compare>
+BPlusTree<Key, Value, Compare>& BPlusTree<Key, Value, Compare>::operator=(const BPlusTree& other)
+{
+    if(this != &other)
+    {
+        BPlusTree copy(other);
+        swap(copy);
+    }
+    return *this;
+}
+
+template<class Key, class Value, class Compare>
+BPlusTree<Key, Value, Compare>& BPlusTree<Key, Value, Compare>::operator=(BPlusTree&& other) noexcept
+{
+    if(this != &other)
+    {
+        clear();
+        swap(other);
+    }
+    return *this;
+}
+
+template<class Key, class Value, class Compare>
+std::size_t BPlusTree<Key, Value, Compare>::childIndex(const Inner* node, const Key& key) const
+{
+    const auto* keys = node->keys.data();
+    return static_cast<std::size_t>(std::upper_bound(keys, keys + node->count, key, _compare) - keys);
+}
+
+template<class Key, class Value, class Compare>
+std::size_t BPlusTree<Key, Value, Compare>::leafIndex(const Leaf* leaf, const Key& key) const
+{
+    const auto* values = leaf->values.data();
+    const auto it = std::lower_bound(values, values + leaf->count, key,
+        [this](const value_type& value, const Key& k) { return _compare(value.first, k); });
+    return static_cast<std::size_t>(it - values);
+}
+
+template<class Key, class Value, class Compare>
+typename BPlusTree<Key, Value, Compare>::Leaf* BPlusTree<Key, Value, Compare>::descend(
+    const Key& key, Step* path, std::size_t& depth) const
+{
+    depth = 0;
+    Node* node = _root;
+    while(!node->isLeaf)
+    {
+        auto* inner = static_cast<Inner*>(node);
+        const auto child = childIndex(inner, key);
+        assert(depth < MAX_DEPTH);
+        path[depth++] = {inner, child};
+        node = inner->children[child];
+    }
+    return static_cast<Leaf*>(node);
+}
+
+template<class Key, class Value, class Compare>
+typename BPlusTree<Key, Value, Compare>::iterator BPlusTree<Key, Value, Compare>::normalize(
+    Leaf* leaf, const std::size_t index) const
+{
+    if(index == leaf->count && leaf->next)
+        return {leaf->next, 0};
+    return {leaf, index};
+}
+
+template<class Key, class Value, class Compare>
+typename BPlusTree<Key, Value, Compare>::iterator BPlusTree<Key, Value, Compare>::insertInLeaf(
+    Leaf* leaf, const std::size_t index, value_type&& value, Step* path, std::size_t depth)
+{
+    // ) The sibling is allocated first, so that a throwing allocation leave the tree unchanged
+    std::unique_ptr<Leaf> right(leaf->count == LEAF_CAPACITY ? new Leaf : nullptr);
+    detail::insertAt(leaf->values.data(), leaf->count, index, std::move(value));
+    ++leaf->count;
+    ++_size;
+    if(!right)
+        return {leaf, index};
+
+    // ) Split the overflowing leaf in two halves, linked after each other
+    const auto keep = (LEAF_CAPACITY + 1) / 2;
+    detail::relocate(right->values.data(), leaf->values.data() + keep, leaf->count - keep);
+    right->count = leaf->count - keep;
+    leaf->count = keep;
+    right->prev = leaf;
+    right->next = leaf->next;
+    if(leaf->next)
+        leaf->next->prev = right.get();
+    else
+        _last = right.get();
+    leaf->next = right.get();
+
+    const iterator result = index < keep ? iterator(leaf, index) : iterator(right.get(), index - keep);
+    auto* sibling = right.release();
+    insertInParent(leaf, sibling->values[0].first, sibling, path, depth);
+    return result;
+}
+
+template<class Key, class Value, class Compare>
+void BPlusTree<Key, Value, Compare>::insertInParent(Node* left, Key separator, Node* right, Step* path, std::size_t depth)
+{
+    while(depth)
+    {
+        const auto step = path[--depth];
+        Inner* node = step.node;
+        detail::insertAt(node->keys.data(), node->count, step.child, std::move(separator));
+        std::copy_backward(node->children + step.child + 1, node->children + node->count + 1,
+            node->children + node->count + 2);
+        node->children[step.child + 1] = right;
+        ++node->count;
+        if(node->count <= INNER_CAPACITY)
+            return;
+
+        // ) The middle key move up, the keys after it go to the new sibling
+        auto* sibling = new Inner;
+        const auto middle = (INNER_CAPACITY + 1) / 2;
+        separator = std::move(node->keys[middle]);
+        node->keys[middle].~Key();
+        sibling->count = node->count - middle - 1;
+        detail::relocate(sibling->keys.data(), node->keys.data() + middle + 1, sibling->count);
+        std::copy(node->children + middle + 1, node->children + node->count + 1, sibling->children);
+        node->count = middle;
+        left = node;
+        right = sibling;
+    }
+
+    // ) The root was split, the tree grow by one level
+    auto* root = new Inner;
+    ::new(static_cast<void*>(root->keys.data())) Key(std::move(separator));
+    root->children[0] = left;
+    root->children[1] = right;
+    root->count = 1;
+    _root = root;
+}
+
+template<class Key, class Value, class Compare>
+typename BPlusTree<Key, Value, Compare>::iterator BPlusTree<Key, Value, Compare>::eraseInLeaf(
+    Leaf* leaf, std::size_t index, Step* path, const std::size_t depth)
+{
+    // ) The pair following the erased one is at index, in leaf or as the first pair of the next leaf
+    detail::eraseAt(leaf->values.data(), leaf->count, index);
+    --leaf->count;
+    --_size;
+
+    if(!depth)
+    {
+        if(leaf->count)
+            return normalize(leaf, index);
+        delete leaf;
+        _root = nullptr;
+        _first = _last = nullptr;
+        return end();
+    }
+    if(leaf->count >= LEAF_MIN)
+        return normalize(leaf, index);
+
+    Inner* parent = path[depth - 1].node;
+    const auto child = path[depth - 1].child;
+    auto* left = child > 0 ? static_cast<Leaf*>(parent->children[child - 1]) : nullptr;
+    auto* right = child < parent->count ? static_cast<Leaf*>(parent->children[child + 1]) : nullptr;
+
+    if(left && left->count > LEAF_MIN)
+    {
+        detail::insertAt(leaf->values.data(), leaf->count, 0, std::move(left->values[left->count - 1]));
+        left->values[left->count - 1].~value_type();
+        --left->count;
+        ++leaf->count;
+        parent->keys[child - 1] = leaf->values[0].first;
+        ++index;
+    }
+    else if(right && right->count > LEAF_MIN)
+    {
+        ::new(static_cast<void*>(leaf->values.data() + leaf->count)) value_type(std::move(right->values[0]));
+        ++leaf->count;
+        detail::eraseAt(right->values.data(), right->count, 0);
+        --right->count;
+        parent->keys[child] = right->values[0].first;
+    }
+    else if(left)
+    {
+        // ) Siblings are half full, leaf and one of them fit in a single leaf
+        index += left->count;
+        mergeLeaves(left, leaf);
+        eraseInInner(path, depth - 1, child - 1);
+        leaf = left;
+    }
+    else
+    {
+        mergeLeaves(leaf, right);
+        eraseInInner(path, depth - 1, child);
+    }
+    return normalize(leaf, index);
+}
+
+template<class Key, class Value, class Compare>
+void BPlusTree<Key, Value, Compare>::eraseInInner(Step* path, const std::size_t level, const std::size_t keyIndex)
+{
+    Inner* node = path[level].node;
+    detail::eraseAt(node->keys.data(), node->count, keyIndex);
+    std::copy(node->children + keyIndex + 2, node->children + node->count + 1, node->children + keyIndex + 1);
+    --node->count;
+
+    if(!level)
+    {
+        // ) A root left with a single child is removed, the tree shrink by one level
+        if(!node->count)
+        {
+            _root = node->children[0];
+            delete node;
+        }
+        return;
+    }
+    if(node->count >= INNER_MIN)
+        return;
+
+    Inner* parent = path[level - 1].node;
+    const auto child = path[level - 1].child;
+    auto* left = child > 0 ? static_cast<Inner*>(parent->children[child - 1]) : nullptr;
+    auto* right = child < parent->count ? static_cast<Inner*>(parent->children[child + 1]) : nullptr;
+
+    if(left && left->count > INNER_MIN)
+    {
+        // ) Rotate through the parent: the separator come down in front, the last key of left go up
+        detail::insertAt(node->keys.data(), node->count, 0, std::move(parent->keys[child - 1]));
+        std::copy_backward(node->children, node->children + node->count + 1, node->children + node->count + 2);
+        node->children[0] = left->children[left->count];
+        ++node->count;
+        parent->keys[child - 1] = std::move(left->keys[left->count - 1]);
+        left->keys[left->count - 1].~Key();
+        --left->count;
+    }
+    else if(right && right->count > INNER_MIN)
+    {
+        ::new(static_cast<void*>(node->keys.data() + node->count)) Key(std::move(parent->keys[child]));
+        node->children[node->count + 1] = right->children[0];
+        ++node->count;
+        parent->keys[child] = std::move(right->keys[0]);
+        detail::eraseAt(right->keys.data(), right->count, 0);
+        std::copy(right->children + 1, right->children + right->count + 1, right->children);
+        --right->count;
+    }
+    else if(left)
+    {
+        mergeInner(left, node, parent, child - 1);
+        eraseInInner(path, level - 1, child - 1);
+    }
+    else
+    {
+        mergeInner(node, right, parent, child);
+        eraseInInner(path, level - 1, child);
+    }
+}
+
+template<class Key, class Value, class Compare>
+void BPlusTree<Key, Value, Compare>::mergeLeaves(Leaf* left, Leaf* right)
+{
+    detail::relocate(left->values.data() + left->count, right->values.data(), right->count);
+    left->count += right->count;
+    left->next = right->next;
+    if(right->next)
+        right->next->prev = left;
+    else
+        _last = left;
+    delete right;
+}
+
+template<class Key, class Value, class Compare>
+void BPlusTree<Key, Value, Compare>::mergeInner(Inner* left, Inner* right, Inner* parent, const std::size_t keyIndex)
+{
+    ::new(static_cast<void*>(left->keys.data() + left->count)) Key(std::move(parent->keys[keyIndex]));
+    detail::relocate(left->keys.data() + left->count + 1, right->keys.data(), right->count);
+    std::copy(right->children, right->children + right->count + 1, left->children + left->count + 1);
+    left->count += right->count + 1;
+    delete right;
+}
+
+template<class Key, class Value, class Compare>
+void BPlusTree<Key, Value, Compare>::destroy(Node* node)
+{
+    if(node->isLeaf)
+    {
+        auto* leaf = static_cast<Leaf*>(node);
+        std::destroy(leaf->values.data(), leaf->values.data() + leaf->count);
+        delete leaf;
+        return;
+    }
+    auto* inner = static_cast<Inner*>(node);
+    for(std::size_t i = 0; i <= inner->count; ++i) destroy(inner->children[i]);
+    std::destroy(inner->keys.data(), inner->keys.data() + inner->count);
+    delete inner;
+}
+
+template<class Key, class Value, class Compare>
+void BPlusTree<Key, Value, Compare>::clear() noexcept
+{
+    if(_root)
+        destroy(_root);
+    _root = nullptr;
+    _first = _last = nullptr;
+    _size = 0;
+}
+
+template<class Key, class Value, class Compare>
+void BPlusTree<Key, Value, Compare>::swap(BPlusTree& other) noexcept
+{
+    using std::swap;
+    swap(_root, other._root);
+    swap(_first, other._first);
+    swap(_last, other._last);
+    swap(_size, other._size);
+    swap(_compare, other._compare);
+}
+
+template<class Key, class Value, class Compare>
+typename BPlusTree<Key, Value, Compare>::iterator BPlusTree<Key, Value, Compare>::lower_bound(const Key& key)
+{
+    if(!_root)
+        return end();
+    Step path[MAX_DEPTH];
+    std::size_t depth = 0;
+    Leaf* leaf = descend(key, path, depth);
+    return normalize(leaf, leafIndex(leaf, key));
+}
+
+template<class Key, class Value, class Compare>
+typename BPlusTree<Key, Value, Compare>::iterator BPlusTree<Key, Value, Compare>::find(const Key& key)
+{
+    const auto it = lower_bound(key);
+    return it != end() && !_compare(key, it->first) ? it : end();
+}
+
+template<class Key, class Value, class Compare>
+template<class K, class... Args>
+typename BPlusTree<Key, Value, Compare>::iterator BPlusTree<Key, Value, Compare>::try_emplace(
+    const_iterator hint, K&& key, Args&&... args)
+{
+    // ) Inserting at the front or the back of a leaf could cross a separator of the parents,
+    // only the ends of the first and last leaves have no separator to check
+    Leaf* leaf = hint._leaf;
+    if(leaf && leaf->count < LEAF_CAPACITY)
+    {
+        const auto index = hint._index;
+        const bool afterPrevious = index ? _compare(leaf->values[index - 1].first, key) : leaf == _first;
+        const bool beforeHint = index < leaf->count ? _compare(key, leaf->values[index].first) : leaf == _last;
+        if(afterPrevious && beforeHint)
+        {
+            value_type value(std::piecewise_construct, std::forward_as_tuple(std::forward<K>(key)),
+                std::forward_as_tuple(std::forward<Args>(args)...));
+            detail::insertAt(leaf->values.data(), leaf->count, index, std::move(value));
+            ++leaf->count;
+            ++_size;
+            return {leaf, index};
+        }
+    }
+    return try_emplace(std::forward<K>(key), std::forward<Args>(args)...).first;
+}
+
+template<class Key, class Value, class Compare>
+template<class... Args>
+std::pair<typename BPlusTree<Key, Value, Compare>::iterator, bool> BPlusTree<Key, Value, Compare>::emplace(
+    Args&&... args)
+{
+    value_type value(std::forward<Args>(args)...);
+    return insert(std::move(value));
+}
+
+template<class Key, class Value, class Compare>
+template<class K, class... Args>
+std::pair<typename BPlusTree<Key, Value, Compare>::iterator, bool> BPlusTree<Key, Value, Compare>::try_emplace(
+    K&& key, Args&&... args)
+{
+    if(!_root)
+    {
+        _first = _last = new Leaf;
+        _root = _first;
+    }
+
+    Step path[MAX_DEPTH];
+    std::size_t depth = 0;
+    Leaf* leaf = descend(key, path, depth);
+    const auto index = leafIndex(leaf, key);
+    if(index < leaf->count && !_compare(key, leaf->values[index].first))
+        return {iterator(leaf, index), false};
+
+    value_type value(std::piecewise_construct, std::forward_as_tuple(std::forward<K>(key)),
+        std::forward_as_tuple(std::forward<Args>(args)...));
+    return {insertInLeaf(leaf, index, std::move(value), path, depth), true};
+}
+
+template<class Key, class Value, class Compare>
+typename BPlusTree<Key, Value, Compare>::iterator BPlusTree<Key, Value, Compare>::erase(const_iterator pos)
+{
+    // ) The path to the leaf of pos is needed to rebalance its parents
+    Step path[MAX_DEPTH];
+    std::size_t depth = 0;
+    Leaf* leaf = descend(pos->first, path, depth);
+    assert(leaf == pos._leaf);
+    return eraseInLeaf(leaf, pos._index, path, depth);
+}
+
+template<class Key, class Value, class Compare>
+std::size_t BPlusTree<Key, Value, Compare>::erase(const Key& key)
+{
+    if(!_root)
+        return 0;
+    Step path[MAX_DEPTH];
+    std::size_t depth = 0;
+    Leaf* leaf = descend(key, path, depth);
+    const auto index = leafIndex(leaf, key);
+    if(index == leaf->count || _compare(key, leaf->values[index].first))
+        return 0;
+    eraseInLeaf(leaf, index, path, depth);
+    return 1;
+}
+
+}
+
+#endif
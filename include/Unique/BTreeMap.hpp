@@ -0,0 +1,33 @@
+#ifndef __UNIQUE_B_TREE_MAP_HPP__
+#define __UNIQUE_B_TREE_MAP_HPP__
+
+// ─────────────────────────────────────────────────────────────
+//                  INCLUDE
+// ─────────────────────────────────────────────────────────────
+
+#include <Unique/BPlusTree.hpp>
+#include <Unique/TMap.hpp>
+
+// ─────────────────────────────────────────────────────────────
+//                  DECLARATION
+// ─────────────────────────────────────────────────────────────
+
+namespace unique {
+
+// ─────────────────────────────────────────────────────────────
+//                  CLASS
+// ─────────────────────────────────────────────────────────────
+
+/**
+ * Map on two BPlusTree, for ordered maps with many inserts and range scans: inserts shift at most a
+ * leaf instead of a whole array as FlatMap, and lookups and scans read wide nodes instead of chasing
+ * a pointer per pair as Map. Iterators are invalidated by every insert and erase.
+ */
+template<class Key1, class Key2>
+class BTreeMap : public TMap<BPlusTree, BPlusTree, Key1, Key2>
+{
+};
+
+}
+
+#endif
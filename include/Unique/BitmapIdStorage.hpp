@@ -0,0 +1,492 @@
+#ifndef __UNIQUE_BITMAP_ID_STORAGE_HPP__
+#define __UNIQUE_BITMAP_ID_STORAGE_HPP__
+
+// ─────────────────────────────────────────────────────────────
+//                  INCLUDE
+// ─────────────────────────────────────────────────────────────
+
+#include <Unique/Bits.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// ─────────────────────────────────────────────────────────────
+//                  DECLARATION
+// ─────────────────────────────────────────────────────────────
+
+namespace unique {
+
+// ─────────────────────────────────────────────────────────────
+//                  CLASS
+// ─────────────────────────────────────────────────────────────
+
+/**
+ * Storage of the available ids of an IdProvider backed by a hierarchical bitmap.
+ * Level 0 hold one bit per id (offset from base). Each bit of level n+1 tells if the matching
+ * 64-bit word of level n is non zero, so the lowest available id is found with one
+ * count-trailing-zeros per level. Memory is proportional to the highest id ever made available.
+ */
+template<typename T>
+class BitmapIdStorage
+{
+public:
+    using Word = std::uint64_t;
+    static constexpr unsigned WORD_BITS = 64;
+    /** Ids are handed out lowest first, the provider can shrink its counter */
+    static constexpr bool LOWEST_FIRST = true;
+    static constexpr std::size_t NO_BIT = std::size_t(-1);
+
+    explicit BitmapIdStorage(const T base = T()) : _base(base) {}
+
+private:
+    /** Id matching bit 0 of level 0 */
+    T _base;
+    /** _levels[0] is the leaf bitmap, _levels.back() is a single summary word */
+    std::vector<std::vector<Word>> _levels;
+    std::size_t _size = 0;
+
+private:
+    std::size_t offsetOf(const T id) const
+    {
+        assert(id >= _base);
+        return static_cast<std::size_t>(id - _base);
+    }
+
+    /** Grow every level so that leaf word wordIndex exists */
+    void reserveWord(std::size_t wordIndex);
+
+    /** Set bits [from, to) of level. Summary levels above are updated */
+    void setRange(std::size_t level, std::size_t from, std::size_t to);
+
+    /** Clear bit of level. Summary levels above are updated if the word became empty */
+    void resetBit(std::size_t level, std::size_t bit);
+
+    /** Clear leaf bits [from, to), that must all be set */
+    void resetRange(std::size_t from, std::size_t to);
+
+    /** Lowest set bit of level at or after bit, or NO_BIT. Summary levels skip empty words */
+    std::size_t nextSetBit(std::size_t level, std::size_t bit) const;
+
+    /** Highest set bit of level at or before bit, or NO_BIT */
+    std::size_t previousSetBit(std::size_t level, std::size_t bit) const;
+
+    /** First cleared leaf bit at or after bit, or limit if bits are set up to limit. One count-trailing-zeros per word */
+    std::size_t runEnd(std::size_t bit, std::size_t limit) const;
+
+    /** First leaf bit of the run of set bits that end at bit, that must be set. One count-leading-zeros per word */
+    std::size_t runBegin(std::size_t bit) const;
+
+public:
+    /** Get if there is no available id */
+    bool empty() const { return _size == 0; }
+
+    /** Count of available ids */
+    std::size_t size() const { return _size; }
+
+    /** Get if id is available */
+    bool contains(const T id) const;
+
+    /** Make id available. id must not already be available */
+    void insert(const T id);
+
+    /** Make every id in [first, last) available. None of them must already be available */
+    void insertRange(const T first, const T last);
+
+    /**
+     * \brief Remove id from the available ids
+     * \return false if id wasn't available
+     */
+    bool erase(const T id);
+
+    /**
+     * \brief Remove the run of available ids that end right before end. O(run / 64)
+     * \return First id of the removed run, or end if end - 1 isn't available
+     */
+    T eraseRunEndingAt(const T end);
+
+    /** Next id to hand out, the lowest one. Storage must not be empty */
+    T front() const;
+
+    /** Remove and return front(). Storage must not be empty */
+    T popFront();
+
+    /**
+     * \brief Remove the lowest available ids as long as they are consecutive, up to maxCount ids
+     * \param first Receive the first removed id
+     * \return Count of removed ids, [first, first + count) were removed
+     */
+    std::size_t popFrontRun(const std::size_t maxCount, T& first);
+
+    /**
+     * \brief Remove the lowest run of at least count consecutive available ids.
+     * Runs are measured a word at a time, and the summary levels skip the empty words between runs
+     * \param first Receive the first removed id, [first, first + count) were removed
+     * \return false if there is no such run
+     */
+    bool popContiguous(const std::size_t count, T& first);
+
+    /**
+     * \brief Find the available id closest to hint, the lowest one on a tie. O(levels)
+     * \return false if the storage is empty
+     */
+    bool findNear(const T hint, T& id) const;
+
+    /** Call function(first, last) for each run of consecutive available ids, lowest first */
+    template<class Function>
+    void forEachRun(Function function) const;
+
+    /** Remove every available id. Allocated words are kept for reuse */
+    void clear();
+};
+
+template<typename T>
+constexpr unsigned BitmapIdStorage<T>::WORD_BITS;
+template<typename T>
+constexpr bool BitmapIdStorage<T>::LOWEST_FIRST;
+template<typename T>
+constexpr std::size_t BitmapIdStorage<T>::NO_BIT;
+
+template<typename T>
+void BitmapIdStorage<T>::reserveWord(const std::size_t wordIndex)
+{
+    if(_levels.empty())
+        _levels.emplace_back();
+    if(wordIndex < _levels[0].size())
+        return;
+
+    _levels[0].resize(wordIndex + 1, 0);
+
+    // ) Each summary level hold one bit per word of the level below, stop at a single word
+    for(std::size_t level = 1;; ++level)
+    {
+        const auto wordCount = (_levels[level - 1].size() + WORD_BITS - 1) / WORD_BITS;
+        if(level == _levels.size())
+        {
+            if(_levels[level - 1].size() == 1)
+                break;
+            // ) New top level: its first bit summarize the whole previous top word
+            _levels.emplace_back(wordCount, 0);
+            if(_levels[level - 1][0])
+                _levels[level][0] = 1;
+        }
+        else
+        {
+            _levels[level].resize(wordCount, 0);
+        }
+    }
+}
+
+template<typename T>
+void BitmapIdStorage<T>::setRange(const std::size_t level, const std::size_t from, const std::size_t to)
+{
+    assert(from < to);
+    auto& words = _levels[level];
+    const auto firstWord = from / WORD_BITS;
+    const auto lastWord = (to - 1) / WORD_BITS;
+
+    // ) Words that were empty need their summary bit set. Since [firstWord, lastWord] all
+    // become non empty, it's a contiguous range in the level above
+    for(auto w = firstWord; w <= lastWord; ++w)
+    {
+        const auto begin = w == firstWord ? unsigned(from % WORD_BITS) : 0u;
+        const auto end = w == lastWord ? unsigned((to - 1) % WORD_BITS) + 1 : WORD_BITS;
+        const auto mask = detail::bitRangeMask(begin, end);
+        if(level == 0)
+            _size += detail::popCount(mask & ~words[w]);
+        words[w] |= mask;
+    }
+
+    if(level + 1 < _levels.size())
+        setRange(level + 1, firstWord, lastWord + 1);
+}
+
+template<typename T>
+void BitmapIdStorage<T>::resetBit(std::size_t level, std::size_t bit)
+{
+    for(; level < _levels.size(); ++level)
+    {
+        auto& word = _levels[level][bit / WORD_BITS];
+        word &= ~(Word(1) << (bit % WORD_BITS));
+        // ) Summary only change when the word become empty
+        if(word)
+            break;
+        bit /= WORD_BITS;
+    }
+}
+
+template<typename T>
+void BitmapIdStorage<T>::resetRange(const std::size_t from, const std::size_t to)
+{
+    assert(from < to);
+    const auto firstWord = from / WORD_BITS;
+    const auto lastWord = (to - 1) / WORD_BITS;
+    for(auto w = firstWord; w <= lastWord; ++w)
+    {
+        const auto begin = w == firstWord ? unsigned(from % WORD_BITS) : 0u;
+        const auto end = w == lastWord ? unsigned((to - 1) % WORD_BITS) + 1 : WORD_BITS;
+        const auto mask = detail::bitRangeMask(begin, end);
+        assert((_levels[0][w] & mask) == mask);
+        _levels[0][w] &= ~mask;
+        // ) Summary levels only change for words that became empty
+        if(!_levels[0][w] && _levels.size() > 1)
+            resetBit(1, w);
+    }
+    _size -= to - from;
+}
+
+template<typename T>
+std::size_t BitmapIdStorage<T>::nextSetBit(const std::size_t level, const std::size_t bit) const
+{
+    const auto& words = _levels[level];
+    const auto w = bit / WORD_BITS;
+    if(w >= words.size())
+        return NO_BIT;
+    const auto rest = words[w] & (~Word(0) << (bit % WORD_BITS));
+    if(rest)
+        return w * WORD_BITS + detail::countTrailingZeros(rest);
+    if(level + 1 == _levels.size())
+        return NO_BIT;
+
+    // ) The level above tell which following word isn't empty
+    const auto next = nextSetBit(level + 1, w + 1);
+    return next == NO_BIT ? NO_BIT : next * WORD_BITS + detail::countTrailingZeros(words[next]);
+}
+
+template<typename T>
+std::size_t BitmapIdStorage<T>::previousSetBit(const std::size_t level, std::size_t bit) const
+{
+    const auto& words = _levels[level];
+    if(bit / WORD_BITS >= words.size())
+        bit = words.size() * WORD_BITS - 1;
+    const auto w = bit / WORD_BITS;
+    const auto rest = words[w] & detail::bitRangeMask(0, unsigned(bit % WORD_BITS) + 1);
+    if(rest)
+        return w * WORD_BITS + detail::highestBit(rest);
+    if(w == 0 || level + 1 == _levels.size())
+        return NO_BIT;
+
+    const auto previous = previousSetBit(level + 1, w - 1);
+    return previous == NO_BIT ? NO_BIT : previous * WORD_BITS + detail::highestBit(words[previous]);
+}
+
+template<typename T>
+std::size_t BitmapIdStorage<T>::runEnd(std::size_t bit, const std::size_t limit) const
+{
+    const auto& leaves = _levels[0];
+    auto w = bit / WORD_BITS;
+    if(w >= leaves.size())
+        return std::min(bit, limit);
+
+    // ) First word from bit, then whole words until one isn't full
+    auto zeros = ~leaves[w] & (~Word(0) << (bit % WORD_BITS));
+    while(!zeros)
+    {
+        if(++w == leaves.size() || w * WORD_BITS >= limit)
+            return std::min(w * WORD_BITS, limit);
+        zeros = ~leaves[w];
+    }
+    return std::min(w * WORD_BITS + detail::countTrailingZeros(zeros), limit);
+}
+
+template<typename T>
+std::size_t BitmapIdStorage<T>::runBegin(const std::size_t bit) const
+{
+    const auto& leaves = _levels[0];
+    auto w = bit / WORD_BITS;
+    assert((leaves[w] >> (bit % WORD_BITS)) & 1);
+
+    // ) Same as runEnd, walking down to the highest cleared bit below the run
+    auto zeros = ~leaves[w] & detail::bitRangeMask(0, unsigned(bit % WORD_BITS) + 1);
+    while(!zeros)
+    {
+        if(w == 0)
+            return 0;
+        zeros = ~leaves[--w];
+    }
+    return w * WORD_BITS + detail::highestBit(zeros) + 1;
+}
+
+template<typename T>
+bool BitmapIdStorage<T>::contains(const T id) const
+{
+    if(id < _base || _levels.empty())
+        return false;
+    const auto offset = offsetOf(id);
+    const auto wordIndex = offset / WORD_BITS;
+    if(wordIndex >= _levels[0].size())
+        return false;
+    return (_levels[0][wordIndex] >> (offset % WORD_BITS)) & 1;
+}
+
+template<typename T>
+void BitmapIdStorage<T>::insert(const T id)
+{
+    assert(!contains(id));
+    const auto offset = offsetOf(id);
+    reserveWord(offset / WORD_BITS);
+    setRange(0, offset, offset + 1);
+}
+
+template<typename T>
+void BitmapIdStorage<T>::insertRange(const T first, const T last)
+{
+    if(first >= last)
+        return;
+    const auto from = offsetOf(first);
+    const auto to = offsetOf(last);
+    reserveWord((to - 1) / WORD_BITS);
+    setRange(0, from, to);
+}
+
+template<typename T>
+bool BitmapIdStorage<T>::erase(const T id)
+{
+    if(!contains(id))
+        return false;
+    resetBit(0, offsetOf(id));
+    --_size;
+    return true;
+}
+
+template<typename T>
+T BitmapIdStorage<T>::eraseRunEndingAt(const T end)
+{
+    if(end <= _base || !contains(end - 1))
+        return end;
+    const auto to = offsetOf(end);
+    const auto from = runBegin(to - 1);
+    resetRange(from, to);
+    return _base + static_cast<T>(from);
+}
+
+template<typename T>
+T BitmapIdStorage<T>::front() const
+{
+    assert(!empty());
+
+    // ) Walk down from the top summary word, following the lowest set bit at each level
+    std::size_t index = 0;
+    for(auto level = _levels.size(); level-- > 0;)
+    {
+        const auto word = _levels[level][index];
+        assert(word);
+        index = index * WORD_BITS + detail::countTrailingZeros(word);
+    }
+    return _base + static_cast<T>(index);
+}
+
+template<typename T>
+T BitmapIdStorage<T>::popFront()
+{
+    const auto id = front();
+    resetBit(0, offsetOf(id));
+    --_size;
+    return id;
+}
+
+template<typename T>
+std::size_t BitmapIdStorage<T>::popFrontRun(const std::size_t maxCount, T& first)
+{
+    assert(maxCount);
+    first = front();
+    const auto from = offsetOf(first);
+    const auto to = runEnd(from, maxCount < NO_BIT - from ? from + maxCount : NO_BIT);
+    resetRange(from, to);
+    return to - from;
+}
+
+template<typename T>
+bool BitmapIdStorage<T>::popContiguous(const std::size_t count, T& first)
+{
+    assert(count);
+    if(_levels.empty())
+        return false;
+
+    // ) Jump from run to run: the end of a run is a count-trailing-zeros per word, the start of
+    // the next one is found through the summary levels
+    for(auto bit = nextSetBit(0, 0); bit != NO_BIT;)
+    {
+        const auto end = runEnd(bit, count < NO_BIT - bit ? bit + count : NO_BIT);
+        if(end - bit >= count)
+        {
+            resetRange(bit, end);
+            first = _base + static_cast<T>(bit);
+            return true;
+        }
+        bit = nextSetBit(0, end);
+    }
+    return false;
+}
+
+template<typename T>
+bool BitmapIdStorage<T>::findNear(const T hint, T& id) const
+{
+    if(empty())
+        return false;
+
+    const auto offset = offsetOf(hint);
+    const auto above = nextSetBit(0, offset);
+    if(above == offset)
+    {
+        id = hint;
+        return true;
+    }
+    const auto below = offset ? previousSetBit(0, offset - 1) : NO_BIT;
+    assert(above != NO_BIT || below != NO_BIT);
+
+    const auto belowIsNearest = below != NO_BIT && (above == NO_BIT || offset - below <= above - offset);
+    const auto nearest = belowIsNearest ? below : above;
+    id = _base + static_cast<T>(nearest);
+    return true;
+}
+
+template<typename T>
+template<class Function>
+void BitmapIdStorage<T>::forEachRun(Function function) const
+{
+    if(_levels.empty())
+        return;
+    const auto& leaves = _levels[0];
+
+    // ) Run bounds are found with one count-trailing-zeros each. Words with no bound are skipped at once
+    std::size_t runStart = 0;
+    bool inRun = false;
+    for(std::size_t w = 0; w < leaves.size(); ++w)
+    {
+        const auto word = leaves[w];
+        if(word == (inRun ? ~Word(0) : Word(0)))
+            continue;
+
+        unsigned bit = 0;
+        while(bit < WORD_BITS)
+        {
+            // ) Look for the next set bit outside of a run, the next cleared bit inside of a run
+            const auto rest = (inRun ? ~word : word) >> bit;
+            if(!rest)
+                break;
+            bit += detail::countTrailingZeros(rest);
+            if(inRun)
+                function(_base + static_cast<T>(runStart), _base + static_cast<T>(w * WORD_BITS + bit));
+            else
+                runStart = w * WORD_BITS + bit;
+            inRun = !inRun;
+        }
+    }
+    if(inRun)
+        function(_base + static_cast<T>(runStart), _base + static_cast<T>(leaves.size() * WORD_BITS));
+}
+
+template<typename T>
+void BitmapIdStorage<T>::clear()
+{
+    for(auto& words: _levels)
+        std::fill(words.begin(), words.end(), 0);
+    _size = 0;
+}
+
+}
+
+#endif
@@ -0,0 +1,105 @@
+#ifndef __UNIQUE_BITS_HPP__
+#define __UNIQUE_BITS_HPP__
+
+// ─────────────────────────────────────────────────────────────
+//                  INCLUDE
+// ─────────────────────────────────────────────────────────────
+
+#include <cassert>
+#include <cstdint>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+    #include <intrin.h>
+#endif
+
+// ─────────────────────────────────────────────────────────────
+//                  DECLARATION
+// ─────────────────────────────────────────────────────────────
+
+namespace unique {
+namespace detail {
+
+// ─────────────────────────────────────────────────────────────
+//                  FUNCTIONS
+// ─────────────────────────────────────────────────────────────
+
+/** Index of the lowest set bit of word. word must not be 0 */
+inline unsigned countTrailingZeros(std::uint64_t word)
+{
+    assert(word != 0);
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_ctzll(word));
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+    unsigned long index = 0;
+    _BitScanForward64(&index, word);
+    return static_cast<unsigned>(index);
+#else
+    unsigned index = 0;
+    while(!(word & 1))
+    {
+        word >>= 1;
+        ++index;
+    }
+    return index;
+#endif
+}
+
+/**
+ * Index of the lowest set bit of word, usable in constant expressions.
+ * Binary search in six fixed steps, for code that must also run at compile time. word must not be 0
+ */
+constexpr unsigned constexprCountTrailingZeros(std::uint64_t word)
+{
+    unsigned index = 0;
+    if(!(word & 0xFFFFFFFFull)) { index += 32; word >>= 32; }
+    if(!(word & 0xFFFFull)) { index += 16; word >>= 16; }
+    if(!(word & 0xFFull)) { index += 8; word >>= 8; }
+    if(!(word & 0xFull)) { index += 4; word >>= 4; }
+    if(!(word & 0x3ull)) { index += 2; word >>= 2; }
+    if(!(word & 0x1ull)) { index += 1; }
+    return index;
+}
+
+/** Index of the highest set bit of word. word must not be 0 */
+inline unsigned highestBit(std::uint64_t word)
+{
+    assert(word != 0);
+#if defined(__GNUC__) || defined(__clang__)
+    return 63u - static_cast<unsigned>(__builtin_clzll(word));
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+    unsigned long index = 0;
+    _BitScanReverse64(&index, word);
+    return static_cast<unsigned>(index);
+#else
+    unsigned index = 63;
+    while(!(word & (std::uint64_t(1) << index))) --index;
+    return index;
+#endif
+}
+
+/** Count of set bits in word */
+inline unsigned popCount(std::uint64_t word)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_popcountll(word));
+#else
+    // ) Portable SWAR popcount, popcnt instruction isn't guaranteed on every msvc target
+    word = word - ((word >> 1) & 0x5555555555555555ull);
+    word = (word & 0x3333333333333333ull) + ((word >> 2) & 0x3333333333333333ull);
+    word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+    return static_cast<unsigned>((word * 0x0101010101010101ull) >> 56);
+#endif
+}
+
+/** Mask with bits [from, to) set. from < to <= 64 */
+inline std::uint64_t bitRangeMask(unsigned from, unsigned to)
+{
+    assert(from < to && to <= 64);
+    const auto high = to == 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << to) - 1;
+    return high & ~((std::uint64_t(1) << from) - 1);
+}
+
+}
+}
+
+#endif
@@ -0,0 +1,252 @@
+#ifndef __UNIQUE_BLOCKING_ID_PROVIDER_HPP__
+#define __UNIQUE_BLOCKING_ID_PROVIDER_HPP__
+
+// ─────────────────────────────────────────────────────────────
+//                  INCLUDE
+// ─────────────────────────────────────────────────────────────
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <optional>
+
+// ─────────────────────────────────────────────────────────────
+//                  DECLARATION
+// ─────────────────────────────────────────────────────────────
+
+namespace unique {
+
+// ─────────────────────────────────────────────────────────────
+//                  CLASS
+// ─────────────────────────────────────────────────────────────
+
+/**
+ * Wrap a bounded IdProvider behind a mutex, so that threads wait for an id instead of reaching MAX.
+ * The pool act as a counting semaphore: takeNextIdWait park the thread on a condition variable
+ * until an id is released, tryTakeNextIdFor give up after a timeout and tryTakeNextId never wait.
+ * Releases wake as many waiters as there are released ids, with a single notify_all when every
+ * waiter can be served, and notify outside of the lock so that woken threads don't block on it.
+ */
+template<class Provider>
+class BlockingIdProvider
+{
+public:
+    using ProviderType = Provider;
+    using Type = typename Provider::Type;
+
+private:
+    Provider _provider;
+    mutable std::mutex _mutex;
+    std::condition_variable _released;
+    /** Count of threads parked in takeNextIdWait or tryTakeNextIdFor */
+    std::size_t _waiterCount = 0;
+
+private:
+    /** Wake up to count waiters. waiters is the count seen under the lock */
+    void wake(const std::size_t count, const std::size_t waiters);
+
+    /** Take an id if one is available. Lock must be held */
+    std::optional<Type> tryTake();
+
+    // ──────── C++ API ──────────
+public:
+    /** \brief Take the next id, or return nothing right away if every id is taken */
+    std::optional<Type> tryTakeNextId();
+
+    /** \brief Take the next id, waiting as long as needed for a release */
+    Type takeNextIdWait();
+
+    /** \brief Take the next id, waiting at most timeout. \return nothing if no id was released in time */
+    template<class Rep, class Period>
+    std::optional<Type> tryTakeNextIdFor(const std::chrono::duration<Rep, Period>& timeout);
+
+    /** \brief Take the next id, waiting up to deadline. \return nothing if no id was released in time */
+    template<class Clock, class Duration>
+    std::optional<Type> tryTakeNextIdUntil(const std::chrono::time_point<Clock, Duration>& deadline);
+
+    /** \brief Take a specific id. \return false if id is already taken */
+    bool takeId(const Type id);
+
+    /** \brief Release a taken id and wake one waiter */
+    void releaseId(const Type id);
+
+    /** \brief Release every id in the iterator range [first, last) and wake a waiter per id */
+    template<class InputIt>
+    void releaseIds(InputIt first, InputIt last);
+
+    /** \brief Release every id in [first, last) and wake a waiter per id */
+    void releaseIdRange(const Type first, const Type last);
+
+    /** \brief Get if an id can be taken */
+    bool isIdAvailable(const Type id) const;
+
+    /** \brief Get if an id is taken */
+    bool isIdTaken(const Type id) const;
+
+    /** \brief Get if tryTakeNextId would succeed */
+    bool areIdsAvailables() const;
+
+    /** \brief Count of taken ids */
+    std::size_t countOfTakenIds() const;
+
+    /** \brief Count of threads waiting for an id */
+    std::size_t countOfWaiters() const;
+
+    /** \brief Release every id and wake every waiter */
+    void clear();
+};
+
+template<class Provider>
+void BlockingIdProvider<Provider>::wake(const std::size_t count, const std::size_t waiters)
+{
+    if(!count || !waiters)
+        return;
+    if(count >= waiters)
+    {
+        _released.notify_all();
+        return;
+    }
+    for(std::size_t i = 0; i < count; ++i) _released.notify_one();
+}
+
+template<class Provider>
+std::optional<typename BlockingIdProvider<Provider>::Type> BlockingIdProvider<Provider>::tryTake()
+{
+    if(!_provider.areIdsAvailables())
+        return std::nullopt;
+    return _provider.takeNextId();
+}
+
+template<class Provider>
+std::optional<typename BlockingIdProvider<Provider>::Type> BlockingIdProvider<Provider>::tryTakeNextId()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return tryTake();
+}
+
+template<class Provider>
+typename BlockingIdProvider<Provider>::Type BlockingIdProvider<Provider>::takeNextIdWait()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    ++_waiterCount;
+    _released.wait(lock, [this] { return _provider.areIdsAvailables(); });
+    --_waiterCount;
+    return _provider.takeNextId();
+}
+
+template<class Provider>
+template<class Rep, class Period>
+std::optional<typename BlockingIdProvider<Provider>::Type> BlockingIdProvider<Provider>::tryTakeNextIdFor(
+    const std::chrono::duration<Rep, Period>& timeout)
+{
+    return tryTakeNextIdUntil(std::chrono::steady_clock::now() + timeout);
+}
+
+template<class Provider>
+template<class Clock, class Duration>
+std::optional<typename BlockingIdProvider<Provider>::Type> BlockingIdProvider<Provider>::tryTakeNextIdUntil(
+    const std::chrono::time_point<Clock, Duration>& deadline)
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    ++_waiterCount;
+    _released.wait_until(lock, deadline, [this] { return _provider.areIdsAvailables(); });
+    --_waiterCount;
+    return tryTake();
+}
+
+template<class Provider>
+bool BlockingIdProvider<Provider>::takeId(const Type id)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _provider.takeId(id);
+}
+
+template<class Provider>
+void BlockingIdProvider<Provider>::releaseId(const Type id)
+{
+    std::size_t waiters = 0;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _provider.releaseId(id);
+        waiters = _waiterCount;
+    }
+    wake(1, waiters);
+}
+
+template<class Provider>
+template<class InputIt>
+void BlockingIdProvider<Provider>::releaseIds(InputIt first, InputIt last)
+{
+    std::size_t count = 0;
+    std::size_t waiters = 0;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        const auto before = _provider.countOfTakenIds();
+        _provider.releaseIds(first, last);
+        count = before - _provider.countOfTakenIds();
+        waiters = _waiterCount;
+    }
+    wake(count, waiters);
+}
+
+template<class Provider>
+void BlockingIdProvider<Provider>::releaseIdRange(const Type first, const Type last)
+{
+    std::size_t waiters = 0;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _provider.releaseIdRange(first, last);
+        waiters = _waiterCount;
+    }
+    wake(first < last ? static_cast<std::size_t>(last - first) : 0, waiters);
+}
+
+template<class Provider>
+bool BlockingIdProvider<Provider>::isIdAvailable(const Type id) const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _provider.isIdAvailable(id);
+}
+
+template<class Provider>
+bool BlockingIdProvider<Provider>::isIdTaken(const Type id) const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _provider.isIdTaken(id);
+}
+
+template<class Provider>
+bool BlockingIdProvider<Provider>::areIdsAvailables() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _provider.areIdsAvailables();
+}
+
+template<class Provider>
+std::size_t BlockingIdProvider<Provider>::countOfTakenIds() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _provider.countOfTakenIds();
+}
+
+template<class Provider>
+std::size_t BlockingIdProvider<Provider>::countOfWaiters() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _waiterCount;
+}
+
+template<class Provider>
+void BlockingIdProvider<Provider>::clear()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _provider.clear();
+    }
+    _released.notify_all();
+}
+
+}
+
+#endif
@@ -0,0 +1,521 @@
+#ifndef __UNIQUE_CONCURRENT_ID_PROVIDER_HPP__
+#define __UNIQUE_CONCURRENT_ID_PROVIDER_HPP__
+
+// ─────────────────────────────────────────────────────────────
+//                  INCLUDE
+// ─────────────────────────────────────────────────────────────
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+// ─────────────────────────────────────────────────────────────
+//                  DECLARATION
+// ─────────────────────────────────────────────────────────────
+
+namespace unique {
+
+// ─────────────────────────────────────────────────────────────
+//                  CLASS
+// ─────────────────────────────────────────────────────────────
+
+/**
+ * Lock-free IdProvider that can be shared between threads without any mutex.
+ *
+ * Fresh ids come from an atomic bump counter. Released ids are pushed on a lock-free stack
+ * (Treiber stack) whose links live in a per id slot, so no allocation happen on release.
+ * The head of the stack pack the top slot with a 32-bit tag incremented on every push and pop,
+ * which make the compare-and-swap ABA safe.
+ * Each slot also hold a state (taken / linked in the stack) updated with compare-and-swap,
+ * so an id is handed out only by the thread that win the transition to taken.
+ *
+ * Differences with IdProvider:
+ * - Released ids are recycled last in first out, not lowest first.
+ * - The counter never go down when the last id is released.
+ * - Counts are exact only when no other thread is modifying the provider.
+ * - clear() must not be called concurrently with any other function.
+ * - max - min must fit in 32 bits.
+ */
+template<typename T, T min, T max>
+class ConcurrentIdProvider
+{
+    // ──────── DEFAULTS ──────────
+public:
+    const T MIN = min;
+    const T MAX = max;
+
+    using Type = T;
+
+    static_assert(min < max, "min should be less than max");
+    static_assert(std::uint64_t(typename std::make_unsigned<T>::type(max) -
+                                typename std::make_unsigned<T>::type(min)) <= 0xFFFFFFFFull,
+        "max - min should fit in 32 bits");
+
+    static constexpr void assert_id(const T id);
+
+    ConcurrentIdProvider() = default;
+    ConcurrentIdProvider(const ConcurrentIdProvider&) = delete;
+    ConcurrentIdProvider& operator=(const ConcurrentIdProvider&) = delete;
+    ~ConcurrentIdProvider() { releasePages(); }
+
+private:
+    static constexpr std::uint8_t TAKEN = 1;
+    static constexpr std::uint8_t LINKED = 2;
+
+    /** Per id state. next is the offset + 1 of the next slot in the stack, 0 mean end of stack */
+    struct Slot
+    {
+        std::atomic<std::uint32_t> next;
+        std::atomic<std::uint8_t> state;
+    };
+
+    // ) Slots are reached through a 3 level radix directory allocated on demand: 10, 10 and 12 bits
+    static constexpr std::uint32_t LEAF_BITS = 12;
+    static constexpr std::uint32_t MID_BITS = 10;
+    static constexpr std::uint32_t TOP_SIZE = 1u << 10;
+
+    struct Leaf
+    {
+        Slot slots[1u << LEAF_BITS];
+    };
+    struct Mid
+    {
+        std::atomic<Leaf*> leaves[1u << MID_BITS];
+    };
+
+    static constexpr std::uint64_t RANGE = std::uint64_t(
+        typename std::make_unsigned<T>::type(max) - typename std::make_unsigned<T>::type(min));
+
+    static constexpr std::size_t CACHE_LINE = 64;
+
+private:
+    /** Offset + 1 of the top slot in the low 32 bits, ABA tag in the high 32 bits */
+    std::atomic<std::uint64_t> _head {0};
+    char _headPadding[CACHE_LINE];
+    /** Next offset to return from the bump counter. Can go past RANGE when exhausted */
+    std::atomic<std::uint64_t> _idCounter {0};
+    char _counterPadding[CACHE_LINE];
+    /** Highest offset + 1 ever taken with takeId */
+    std::atomic<std::uint64_t> _highestTakenId {0};
+    std::atomic<std::size_t> _takenIdCounter {0};
+    char _takenPadding[CACHE_LINE];
+    std::atomic<Mid*> _directory[TOP_SIZE] = {};
+
+private:
+    static std::uint32_t offsetOf(const T id)
+    {
+        return static_cast<std::uint32_t>(
+            typename std::make_unsigned<T>::type(id) - typename std::make_unsigned<T>::type(min));
+    }
+
+    /** Get the slot of offset, allocating the pages on first access */
+    Slot& slot(const std::uint32_t offset);
+
+    /** Get the slot of offset, or nullptr if its page was never allocated */
+    const Slot* findSlot(const std::uint32_t offset) const;
+
+    void push(const std::uint32_t offset);
+    bool pop(std::uint32_t& offset);
+
+    /** Raise _highestTakenId to at least end */
+    void raiseHighestTakenId(const std::uint64_t end);
+
+    /** Count of offsets below the next end id */
+    std::uint64_t endOffset() const;
+
+    void releasePages();
+
+    // ──────── C++ API ──────────
+public:
+    /**
+     * \brief Take a specific id.
+     * \param id Value between _minId included and _maxId excluded. The function will assert otherwise
+     * \return false if the id is already taken
+     */
+    bool takeId(const T id);
+
+    /**
+     * \brief Take the next available id. Last released id first, then the bump counter.
+     * The function assert if no id is available, and return MAX
+     */
+    T takeNextId();
+
+    /**
+     * \brief Take up to count ids with takeNextId
+     * \param out Output iterator receiving the ids
+     * \return Output iterator past the last written id. Less than count ids are written if the provider run out
+     */
+    template<class OutputIt>
+    OutputIt takeNextIds(std::size_t count, OutputIt out)
+    {
+        for(; count && areIdsAvailables(); --count) *out++ = takeNextId();
+        return out;
+    }
+
+    /**
+     * \brief Get the last released id that takeNextId would return, or 0 if there is none.
+     * This is only a snapshot when other threads are using the provider.
+     */
+    T getFirstIdAvailable() const;
+
+    /**
+     * \brief Get the next id takeNextId would return, either getFirstIdAvailable or the counter.
+     * This is only a snapshot when other threads are using the provider.
+     */
+    T getNextId() const;
+
+    /** \brief Get the id after the highest id ever handed out */
+    T getNextEndId() const;
+
+    /**
+     * \brief Release a taken id to make it available to takeNextId again.
+     * The function assert if id isn't bound correctly or if it isn't taken
+     * \param id Value between _minId included and _maxId excluded. The function will assert otherwise
+     */
+    void releaseId(const T id);
+
+    /** \brief Release every id in the iterator range [first, last) */
+    template<class InputIt>
+    void releaseIds(InputIt first, InputIt last)
+    {
+        for(; first != last; ++first) releaseId(*first);
+    }
+
+    /** \brief Get if an id can be taken */
+    bool isIdAvailable(const T id) const;
+
+    /** \brief Get if an id is taken */
+    bool isIdTaken(const T id) const;
+
+    /** \brief Count of available ids before getNextEndId() */
+    std::size_t countOfAvailableIds() const;
+
+    /** \brief Get if there is no released id waiting to be reused */
+    bool availableIdsEmpty() const;
+
+    /** \brief Get if takeNextId can be called without reaching MAX id */
+    bool areIdsAvailables() const;
+
+    /** Get the count of taken ids */
+    std::size_t countOfTakenIds() const;
+
+    /**
+     * \brief Reset everything to initialization.
+     * Not thread safe: no other thread must use the provider during the call.
+     */
+    void clear();
+};
+
+template<typename T, T min, T max>
+constexpr void ConcurrentIdProvider<T, min, max>::assert_id(const T id)
+{
+    assert(id >= min);
+    assert(id < max);
+    (void)id;
+}
+
+template<typename T, T min, T max>
+constexpr std::uint8_t ConcurrentIdProvider<T, min, max>::TAKEN;
+template<typename T, T min, T max>
+constexpr std::uint8_t ConcurrentIdProvider<T, min, max>::LINKED;
+template<typename T, T min, T max>
+constexpr std::uint32_t ConcurrentIdProvider<T, min, max>::LEAF_BITS;
+template<typename T, T min, T max>
+constexpr std::uint32_t ConcurrentIdProvider<T, min, max>::MID_BITS;
+template<typename T, T min, T max>
+constexpr std::uint32_t ConcurrentIdProvider<T, min, max>::TOP_SIZE;
+template<typename T, T min, T max>
+constexpr std::uint64_t ConcurrentIdProvider<T, min, max>::RANGE;
+
+template<typename T, T min, T max>
+typename ConcurrentIdProvider<T, min, max>::Slot& ConcurrentIdProvider<T, min, max>::slot(
+    const std::uint32_t offset)
+{
+    auto& midPtr = _directory[offset >> (LEAF_BITS + MID_BITS)];
+    auto* mid = midPtr.load(std::memory_order_acquire);
+    if(!mid)
+    {
+        // ) Value initialization zero every atomic. The loser of the race delete its page
+        auto* page = new Mid();
+        if(midPtr.compare_exchange_strong(mid, page, std::memory_order_acq_rel))
+            mid = page;
+        else
+            delete page;
+    }
+
+    auto& leafPtr = mid->leaves[(offset >> LEAF_BITS) & ((1u << MID_BITS) - 1)];
+    auto* leaf = leafPtr.load(std::memory_order_acquire);
+    if(!leaf)
+    {
+        auto* page = new Leaf();
+        if(leafPtr.compare_exchange_strong(leaf, page, std::memory_order_acq_rel))
+            leaf = page;
+        else
+            delete page;
+    }
+
+    return leaf->slots[offset & ((1u << LEAF_BITS) - 1)];
+}
+
+template<typename T, T min, T max>
+const typename ConcurrentIdProvider<T, min, max>::Slot* ConcurrentIdProvider<T, min, max>::findSlot(
+    const std::uint32_t offset) const
+{
+    const auto* mid = _directory[offset >> (LEAF_BITS + MID_BITS)].load(std::memory_order_acquire);
+    if(!mid)
+        return nullptr;
+    const auto* leaf = mid->leaves[(offset >> LEAF_BITS) & ((1u << MID_BITS) - 1)].load(
+        std::memory_order_acquire);
+    if(!leaf)
+        return nullptr;
+    return &leaf->slots[offset & ((1u << LEAF_BITS) - 1)];
+}
+
+template<typename T, T min, T max>
+void ConcurrentIdProvider<T, min, max>::push(const std::uint32_t offset)
+{
+    auto& s = slot(offset);
+    auto head = _head.load(std::memory_order_relaxed);
+    std::uint64_t newHead;
+    do
+    {
+        s.next.store(static_cast<std::uint32_t>(head), std::memory_order_relaxed);
+        newHead = (((head >> 32) + 1) << 32) | (std::uint64_t(offset) + 1);
+    } while(!_head.compare_exchange_weak(
+        head, newHead, std::memory_order_release, std::memory_order_relaxed));
+}
+
+template<typename T, T min, T max>
+bool ConcurrentIdProvider<T, min, max>::pop(std::uint32_t& offset)
+{
+    auto head = _head.load(std::memory_order_acquire);
+    for(;;)
+    {
+        const auto top = static_cast<std::uint32_t>(head);
+        if(!top)
+            return false;
+
+        // ) A pushed slot is never deallocated, so reading next is always safe.
+        // If the slot was popped and pushed again meanwhile, the tag changed and the CAS fail
+        const auto next = findSlot(top - 1)->next.load(std::memory_order_relaxed);
+        const auto newHead = (((head >> 32) + 1) << 32) | next;
+        if(_head.compare_exchange_weak(
+               head, newHead, std::memory_order_acquire, std::memory_order_acquire))
+        {
+            offset = top - 1;
+            return true;
+        }
+    }
+}
+
+template<typename T, T min, T max>
+void ConcurrentIdProvider<T, min, max>::raiseHighestTakenId(const std::uint64_t end)
+{
+    auto current = _highestTakenId.load(std::memory_order_relaxed);
+    while(current < end &&
+          !_highestTakenId.compare_exchange_weak(current, end, std::memory_order_relaxed))
+    {
+    }
+}
+
+template<typename T, T min, T max>
+std::uint64_t ConcurrentIdProvider<T, min, max>::endOffset() const
+{
+    auto end = _idCounter.load(std::memory_order_relaxed);
+    const auto highest = _highestTakenId.load(std::memory_order_relaxed);
+    if(highest > end)
+        end = highest;
+    return end < RANGE ? end : RANGE;
+}
+
+template<typename T, T min, T max>
+void ConcurrentIdProvider<T, min, max>::releasePages()
+{
+    for(auto& midPtr: _directory)
+    {
+        auto* mid = midPtr.exchange(nullptr, std::memory_order_relaxed);
+        if(!mid)
+            continue;
+        for(auto& leafPtr: mid->leaves) delete leafPtr.load(std::memory_order_relaxed);
+        delete mid;
+    }
+}
+
+template<typename T, T min, T max>
+bool ConcurrentIdProvider<T, min, max>::takeId(const T id)
+{
+    // ) Always assert the id to find bugs asap in debug
+    assert_id(id);
+
+    const auto offset = offsetOf(id);
+    auto& s = slot(offset);
+
+    // ) Only the taken bit is set: if the id is in the stack, it become a tombstone skipped by pop
+    auto state = s.state.load(std::memory_order_relaxed);
+    do
+    {
+        if(state & TAKEN)
+            return false;
+    } while(!s.state.compare_exchange_weak(
+        state, std::uint8_t(state | TAKEN), std::memory_order_acq_rel, std::memory_order_relaxed));
+
+    raiseHighestTakenId(std::uint64_t(offset) + 1);
+
+    // ) Keep track of every id taken
+    _takenIdCounter.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+template<typename T, T min, T max>
+T ConcurrentIdProvider<T, min, max>::takeNextId()
+{
+    // ) Recycle released ids first
+    std::uint32_t offset;
+    while(pop(offset))
+    {
+        auto& s = slot(offset);
+        auto state = s.state.load(std::memory_order_relaxed);
+        std::uint8_t desired;
+        do
+        {
+            // ) The slot isn't linked anymore. If takeId got it meanwhile, we just drop it
+            desired = (state & TAKEN) ? std::uint8_t(state & ~LINKED) : TAKEN;
+        } while(!s.state.compare_exchange_weak(
+            state, desired, std::memory_order_acq_rel, std::memory_order_relaxed));
+
+        if(!(state & TAKEN))
+        {
+            _takenIdCounter.fetch_add(1, std::memory_order_relaxed);
+            return static_cast<T>(MIN + offset);
+        }
+    }
+
+    // ) Then use the bump counter. Ids already taken with takeId are skipped
+    for(;;)
+    {
+        const auto counter = _idCounter.fetch_add(1, std::memory_order_relaxed);
+
+        // ) We can't have idCounter >= the maxId. Because it mean we reached maximum memory available, we need to assert
+        if(counter >= RANGE)
+        {
+            assert(counter < RANGE);
+            _idCounter.store(RANGE, std::memory_order_relaxed);
+            return MAX;
+        }
+
+        auto& s = slot(static_cast<std::uint32_t>(counter));
+        std::uint8_t untouched = 0;
+        if(s.state.compare_exchange_strong(untouched, TAKEN, std::memory_order_acq_rel))
+        {
+            _takenIdCounter.fetch_add(1, std::memory_order_relaxed);
+            return static_cast<T>(MIN + counter);
+        }
+    }
+}
+
+template<typename T, T min, T max>
+T ConcurrentIdProvider<T, min, max>::getFirstIdAvailable() const
+{
+    const auto top = static_cast<std::uint32_t>(_head.load(std::memory_order_acquire));
+    return top ? static_cast<T>(MIN + (top - 1)) : 0;
+}
+
+template<typename T, T min, T max>
+T ConcurrentIdProvider<T, min, max>::getNextId() const
+{
+    const auto top = static_cast<std::uint32_t>(_head.load(std::memory_order_acquire));
+    if(top)
+        return static_cast<T>(MIN + (top - 1));
+    return getNextEndId();
+}
+
+template<typename T, T min, T max>
+T ConcurrentIdProvider<T, min, max>::getNextEndId() const
+{
+    return static_cast<T>(MIN + endOffset());
+}
+
+template<typename T, T min, T max>
+void ConcurrentIdProvider<T, min, max>::releaseId(const T id)
+{
+    // ) Always assert the id to find bugs asap in debug
+    assert_id(id);
+
+    const auto offset = offsetOf(id);
+    auto& s = slot(offset);
+
+    // ) Clear taken, and link the slot unless it is still in the stack as a tombstone
+    auto state = s.state.load(std::memory_order_relaxed);
+    do
+    {
+        // ) We can't release an id that isn't taken
+        assert(state & TAKEN);
+        if(!(state & TAKEN))
+            return;
+    } while(!s.state.compare_exchange_weak(state, LINKED, std::memory_order_acq_rel,
+        std::memory_order_relaxed));
+
+    if(!(state & LINKED))
+        push(offset);
+
+    assert(_takenIdCounter.load(std::memory_order_relaxed) > 0);
+    _takenIdCounter.fetch_sub(1, std::memory_order_relaxed);
+}
+
+template<typename T, T min, T max>
+bool ConcurrentIdProvider<T, min, max>::isIdAvailable(const T id) const
+{
+    // ) Always assert the id to find bugs asap in debug
+    assert_id(id);
+
+    const auto* s = findSlot(offsetOf(id));
+    return !s || !(s->state.load(std::memory_order_acquire) & TAKEN);
+}
+
+template<typename T, T min, T max>
+bool ConcurrentIdProvider<T, min, max>::isIdTaken(const T id) const
+{
+    return !isIdAvailable(id);
+}
+
+template<typename T, T min, T max>
+std::size_t ConcurrentIdProvider<T, min, max>::countOfAvailableIds() const
+{
+    const auto end = endOffset();
+    const auto taken = _takenIdCounter.load(std::memory_order_relaxed);
+    return end > taken ? static_cast<std::size_t>(end - taken) : 0;
+}
+
+template<typename T, T min, T max>
+bool ConcurrentIdProvider<T, min, max>::availableIdsEmpty() const
+{
+    return static_cast<std::uint32_t>(_head.load(std::memory_order_acquire)) == 0;
+}
+
+template<typename T, T min, T max>
+bool ConcurrentIdProvider<T, min, max>::areIdsAvailables() const
+{
+    return !availableIdsEmpty() || _idCounter.load(std::memory_order_relaxed) < RANGE;
+}
+
+template<typename T, T min, T max>
+std::size_t ConcurrentIdProvider<T, min, max>::countOfTakenIds() const
+{
+    return _takenIdCounter.load(std::memory_order_relaxed);
+}
+
+template<typename T, T min, T max>
+void ConcurrentIdProvider<T, min, max>::clear()
+{
+    releasePages();
+    _head.store(0, std::memory_order_relaxed);
+    _idCounter.store(0, std::memory_order_relaxed);
+    _highestTakenId.store(0, std::memory_order_relaxed);
+    _takenIdCounter.store(0, std::memory_order_relaxed);
+}
+
+}
+
+#endif
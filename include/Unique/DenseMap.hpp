@@ -0,0 +1,527 @@
+#ifndef __UNIQUE_DENSE_MAP_HPP__
+#define __UNIQUE_DENSE_MAP_HPP__
+
+// ─────────────────────────────────────────────────────────────
+//                  INCLUDE
+// ─────────────────────────────────────────────────────────────
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+// ─────────────────────────────────────────────────────────────
+//                  DECLARATION
+// ─────────────────────────────────────────────────────────────
+
+namespace unique {
+
+// ─────────────────────────────────────────────────────────────
+//                  CLASS
+// ─────────────────────────────────────────────────────────────
+
+/**
+ * Bimap storing each pair once, with the api of TMap.
+ * TMap keep a Map1<Key1, Key2> and a Map2<Key2, Key1>, so each key is stored twice and an insert
+ * allocate two nodes. Here pairs live in a single dense vector, and each key type has an open
+ * addressing index of entry indexes: an insert construct the pair once and allocate nothing until
+ * the vector or the indexes grow.
+ *
+ * Indexes use linear probing and backward shift deletion like FixedMap, with a load factor of at most
+ * 1/2. Each slot cache 32 bits of the hash next to the entry index, so probes only read the entries
+ * whose hash match and growing never hash a key again.
+ * Erase move the last pair in the hole: pairs are iterated in insertion order until an erase.
+ * Iterators are const, keys are changed with move and swap. They are invalidated by every insert and erase.
+ */
+template<class Key1, class Key2, class Hash1 = std::hash<Key1>, class Hash2 = std::hash<Key2>>
+class DenseMap
+{
+    // ──────── TYPES ──────────
+public:
+    using Key1Type = Key1;
+    using Key2Type = Key2;
+
+    using Key1ValueType = std::pair<Key1, Key2>;
+    using Key2ValueType = std::pair<Key2, Key1>;
+
+    using Key1ConstIterator = typename std::vector<Key1ValueType>::const_iterator;
+
+    /** Iterate the pairs with Key2 first, as TMap iterate its Key2Map */
+    class Key2ConstIterator
+    {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = std::pair<const Key2&, const Key1&>;
+        using difference_type = std::ptrdiff_t;
+        using reference = value_type;
+
+        struct pointer
+        {
+            value_type value;
+            const value_type* operator->() const { return &value; }
+        };
+
+        Key2ConstIterator() = default;
+        explicit Key2ConstIterator(Key1ConstIterator it) : _it(it) {}
+
+        reference operator*() const { return {_it->second, _it->first}; }
+        pointer operator->() const { return {**this}; }
+
+        Key2ConstIterator& operator++()
+        {
+            ++_it;
+            return *this;
+        }
+        Key2ConstIterator operator++(int) { return Key2ConstIterator(_it++); }
+        Key2ConstIterator& operator--()
+        {
+            --_it;
+            return *this;
+        }
+        Key2ConstIterator operator--(int) { return Key2ConstIterator(_it--); }
+
+        bool operator==(const Key2ConstIterator& other) const { return _it == other._it; }
+        bool operator!=(const Key2ConstIterator& other) const { return _it != other._it; }
+
+        /** Same pair, with Key1 first */
+        Key1ConstIterator base() const { return _it; }
+
+    private:
+        Key1ConstIterator _it {};
+    };
+
+private:
+    using Index = std::uint32_t;
+
+    /** Entry of a slot that doesn't refer to any pair */
+    static constexpr Index EMPTY = Index(-1);
+    static constexpr std::size_t MIN_TABLE_SIZE = 8;
+
+    struct Slot
+    {
+        Index entry;
+        std::uint32_t hash;
+    };
+
+    std::vector<Key1ValueType> _entries;
+    /** Index of Key1 then of Key2, both of the same power of two size */
+    std::vector<Slot> _slots[2];
+    std::size_t _mask = 0;
+
+private:
+    template<std::size_t Side>
+    using KeyOf = typename std::tuple_element<Side, Key1ValueType>::type;
+
+    /** High bits of a fibonacci hash, so that hashes that only differ by high bits are spread */
+    template<std::size_t Side>
+    static std::uint32_t hashOf(const KeyOf<Side>& key);
+
+    /** Slot holding key, or the empty slot where key would be inserted. Indexes must be allocated */
+    template<std::size_t Side>
+    std::size_t slotOf(const KeyOf<Side>& key, const std::uint32_t hash) const;
+
+    /** Entry of key, or EMPTY */
+    template<std::size_t Side>
+    Index entryOf(const KeyOf<Side>& key) const;
+
+    /** Slot that refer to entry in the index of Side. entry must be indexed */
+    template<std::size_t Side>
+    std::size_t slotOfEntry(const Index entry) const;
+
+    /** Empty slot, then shift back the following slots that are not at their home */
+    template<std::size_t Side>
+    void removeSlot(std::size_t slot);
+
+    /** Index entry in Side, its key must not be indexed yet */
+    template<std::size_t Side>
+    void insertSlot(const Index entry, const std::uint32_t hash);
+
+    /** Erase entry indexed at slot1 and slot2. The last pair move in its place */
+    void eraseEntry(const Index entry, const std::size_t slot1, const std::size_t slot2);
+
+    /** Move every slot to indexes of tableSize slots, from their cached hash */
+    void rehash(const std::size_t tableSize);
+
+    template<std::size_t Side>
+    bool T_move(const KeyOf<Side>& currentKey, const KeyOf<Side>& newKey);
+
+    template<std::size_t Side>
+    bool T_moveOther(const KeyOf<Side>& key, const KeyOf<1 - Side>& newKey);
+
+    template<std::size_t Side>
+    bool T_swap(const KeyOf<Side>& key, const KeyOf<Side>& otherKey);
+
+    // ──────── ITERATORS ──────────
+public:
+    Key1ConstIterator begin() const noexcept { return _entries.cbegin(); }
+    Key1ConstIterator end() const noexcept { return _entries.cend(); }
+    Key1ConstIterator cbegin() const noexcept { return _entries.cbegin(); }
+    Key1ConstIterator cend() const noexcept { return _entries.cend(); }
+
+    Key1ConstIterator begin1() const noexcept { return begin(); }
+    Key1ConstIterator end1() const noexcept { return end(); }
+    Key1ConstIterator cbegin1() const noexcept { return begin(); }
+    Key1ConstIterator cend1() const noexcept { return end(); }
+
+    Key2ConstIterator begin2() const noexcept { return Key2ConstIterator(begin()); }
+    Key2ConstIterator end2() const noexcept { return Key2ConstIterator(end()); }
+    Key2ConstIterator cbegin2() const noexcept { return begin2(); }
+    Key2ConstIterator cend2() const noexcept { return end2(); }
+
+    // ──────── CAPACITY ──────────
+public:
+    /** \brief Check if container is empty */
+    bool empty() const noexcept { return _entries.empty(); }
+
+    /** \brief Get the number of element in the container */
+    std::size_t size() const noexcept { return _entries.size(); }
+
+    /** \brief returns the maximum possible number of elements */
+    std::size_t max_size() const noexcept { return EMPTY - 1; }
+
+    /** \brief Allocate room for count pairs, so that inserting them allocate nothing */
+    void reserve(const std::size_t count);
+
+    // ──────── MODIFIERS ──────────
+public:
+    /** \brief clears the contents, memory is kept */
+    void clear();
+
+    /**
+     * \brief Inserts value.
+     * \return Returns a pair consisting of an iterator to the inserted element (or to the element that prevented the insertion) and a bool denoting whether the insertion took place.
+     */
+    std::pair<Key1ConstIterator, bool> insert(Key1ValueType value);
+
+    /**
+     * \brief Inserts value.
+     * \return Returns a pair consisting of an iterator to the inserted element (or to the element that prevented the insertion) and a bool denoting whether the insertion took place.
+     */
+    std::pair<Key2ConstIterator, bool> insert(Key2ValueType value);
+
+    /**
+     * \brief Removes the element at pos.
+     * \return Iterator at the same position, now on the pair that was last
+     */
+    Key1ConstIterator erase(Key1ConstIterator pos);
+    Key2ConstIterator erase(Key2ConstIterator pos) { return Key2ConstIterator(erase(pos.base())); }
+
+    /** \brief Removes the element with the key equivalent to key. \return Number of elements removed */
+    std::size_t erase(const Key1& key);
+    std::size_t erase(const Key2& key);
+
+    /** \brief move key2 at newKey. \return false if key2 isn't present or newKey is already taken */
+    bool move(const Key2& key2, const Key1& newKey) { return T_moveOther<1>(key2, newKey); }
+
+    /** \brief move key1 at newKey. \return false if key1 isn't present or newKey is already taken */
+    bool move(const Key1& key1, const Key2& newKey) { return T_moveOther<0>(key1, newKey); }
+
+    /** \brief Change the key from currentKey to newKey. \return false if currentKey doesn't exist or newKey is already taken */
+    bool move(const Key1& currentKey, const Key1& newKey) { return T_move<0>(currentKey, newKey); }
+    bool move(const Key2& currentKey, const Key2& newKey) { return T_move<1>(currentKey, newKey); }
+
+    /** \brief Exchange the keys associated with key and otherKey. \return false if one of them is missing */
+    bool swap(const Key1& key, const Key1& otherKey) { return T_swap<0>(key, otherKey); }
+    bool swap(const Key2& key, const Key2& otherKey) { return T_swap<1>(key, otherKey); }
+
+    // ──────── LOOKUP ──────────
+public:
+    /** \brief Finds an element with key equivalent to key, or end() */
+    Key1ConstIterator find(const Key1& key) const;
+
+    /** \brief Finds an element with key equivalent to key, or end2() */
+    Key2ConstIterator find(const Key2& key) const;
+
+    bool contains(const Key1& key) const { return entryOf<0>(key) != EMPTY; }
+    bool contains(const Key2& key) const { return entryOf<1>(key) != EMPTY; }
+};
+
+template<class Key1, class Key2, class Hash1, class Hash2>
+constexpr typename DenseMap<Key1, Key2, Hash1, Hash2>::Index DenseMap<Key1, Key2, Hash1, Hash2>::EMPTY;
+template<class Key1, class Key2, class Hash1, class Hash2>
+constexpr std::size_t DenseMap<Key1, Key2, Hash1, Hash2>::MIN_TABLE_SIZE;
+
+template<class Key1, class Key2, class Hash1, class Hash2>
+template<std::size_t Side>
+std::uint32_t DenseMap<Key1, Key2, Hash1, Hash2>::hashOf(const KeyOf<Side>& key)
+{
+    std::uint64_t hash = 0;
+    if constexpr(Side == 0)
+        hash = static_cast<std::uint64_t>(Hash1()(key));
+    else
+        hash = static_cast<std::uint64_t>(Hash2()(key));
+    return static_cast<std::uint32_t>((hash * 0x9E3779B97F4A7C15ull) >> 32);
+}
+
+template<class Key1, class Key2, class Hash1, class Hash2>
+template<std::size_t Side>
+std::size_t DenseMap<Key1, Key2, Hash1, Hash2>::slotOf(const KeyOf<Side>& key, const std::uint32_t hash) const
+{
+    // ) Load factor is at most 1/2, there is always an empty slot to stop the probe
+    const auto& slots = _slots[Side];
+    auto slot = hash & _mask;
+    while(slots[slot].entry != EMPTY
+          && !(slots[slot].hash == hash && std::get<Side>(_entries[slots[slot].entry]) == key))
+        slot = (slot + 1) & _mask;
+    return slot;
+}
+
+template<class Key1, class Key2, class Hash1, class Hash2>
+template<std::size_t Side>
+typename DenseMap<Key1, Key2, Hash1, Hash2>::Index DenseMap<Key1, Key2, Hash1, Hash2>::entryOf(
+    const KeyOf<Side>& key) const
+{
+    if(_entries.empty())
+        return EMPTY;
+    return _slots[Side][slotOf<Side>(key, hashOf<Side>(key))].entry;
+}
+
+template<class Key1, class Key2, class Hash1, class Hash2>
+template<std::size_t Side>
+std::size_t DenseMap<Key1, Key2, Hash1, Hash2>::slotOfEntry(const Index entry) const
+{
+    const auto& slots = _slots[Side];
+    auto slot = hashOf<Side>(std::get<Side>(_entries[entry])) & _mask;
+    while(slots[slot].entry != entry)
+    {
+        assert(slots[slot].entry != EMPTY);
+        slot = (slot + 1) & _mask;
+    }
+    return slot;
+}
+
+template<class Key1, class Key2, class Hash1, class Hash2>
+template<std::size_t Side>
+void DenseMap<Key1, Key2, Hash1, Hash2>::removeSlot(std::size_t slot)
+{
+    auto& slots = _slots[Side];
+    for(auto next = (slot + 1) & _mask; slots[next].entry != EMPTY; next = (next + 1) & _mask)
+    {
+        // ) A slot can fill the hole if the hole is between its home and itself
+        const auto home = slots[next].hash & _mask;
+        if(((next - home) & _mask) >= ((next - slot) & _mask))
+        {
+            slots[slot] = slots[next];
+            slot = next;
+        }
+    }
+    slots[slot].entry = EMPTY;
+}
+
+template<class Key1, class Key2, class Hash1, class Hash2>
+template<std::size_t Side>
+void DenseMap<Key1, Key2, Hash1, Hash2>::insertSlot(const Index entry, const std::uint32_t hash)
+{
+    auto& slots = _slots[Side];
+    auto slot = hash & _mask;
+    while(slots[slot].entry != EMPTY) slot = (slot + 1) & _mask;
+    slots[slot] = {entry, hash};
+}
+
+template<class Key1, class Key2, class Hash1, class Hash2>
+void DenseMap<Key1, Key2, Hash1, Hash2>::eraseEntry(const Index entry, const std::size_t slot1, const std::size_t slot2)
+{
+    removeSlot<0>(slot1);
+    removeSlot<1>(slot2);
+
+    // ) Keep entries dense: the last one move in the hole and its slots are updated
+    const auto last = static_cast<Index>(_entries.size() - 1);
+    if(entry != last)
+    {
+        _slots[0][slotOfEntry<0>(last)].entry = entry;
+        _slots[1][slotOfEntry<1>(last)].entry = entry;
+        _entries[entry] = std::move(_entries[last]);
+    }
+    _entries.pop_back();
+}
+
+template<class Key1, class Key2, class Hash1, class Hash2>
+void DenseMap<Key1, Key2, Hash1, Hash2>::rehash(const std::size_t tableSize)
+{
+    const auto oldMask = _mask;
+    _mask = tableSize - 1;
+    for(std::size_t side = 0; side < 2; ++side)
+    {
+        auto old = std::move(_slots[side]);
+        _slots[side].assign(tableSize, Slot {EMPTY, 0});
+        if(old.empty())
+            continue;
+        for(std::size_t slot = 0; slot <= oldMask; ++slot)
+        {
+            if(old[slot].entry == EMPTY)
+                continue;
+            if(side == 0)
+                insertSlot<0>(old[slot].entry, old[slot].hash);
+            else
+                insertSlot<1>(old[slot].entry, old[slot].hash);
+        }
+    }
+}
+
+template<class Key1, class Key2, class Hash1, class Hash2>
+void DenseMap<Key1, Key2, Hash1, Hash2>::reserve(const std::size_t count)
+{
+    assert(count < EMPTY);
+    _entries.reserve(count);
+    auto tableSize = _slots[0].empty() ? MIN_TABLE_SIZE : _mask + 1;
+    while(tableSize < 2 * count) tableSize *= 2;
+    if(_slots[0].empty() || tableSize != _mask + 1)
+        rehash(tableSize);
+}
+
+template<class Key1, class Key2, class Hash1, class Hash2>
+void DenseMap<Key1, Key2, Hash1, Hash2>::clear()
+{
+    _entries.clear();
+    for(auto& slots: _slots)
+    {
+        for(auto& slot: slots) slot.entry = EMPTY;
+    }
+}
+
+template<class Key1, class Key2, class Hash1, class Hash2>
+std::pair<typename DenseMap<Key1, Key2, Hash1, Hash2>::Key1ConstIterator, bool>
+DenseMap<Key1, Key2, Hash1, Hash2>::insert(Key1ValueType value)
+{
+    if(_slots[0].empty() || 2 * (_entries.size() + 1) > _mask + 1)
+        reserve(std::max<std::size_t>(_entries.size() + 1, 2 * _entries.size()));
+
+    // ) Both keys must be free, the pair is only built in the vector once they are
+    const auto hash1 = hashOf<0>(value.first);
+    const auto slot1 = slotOf<0>(value.first, hash1);
+    if(_slots[0][slot1].entry != EMPTY)
+        return {begin() + _slots[0][slot1].entry, false};
+    const auto hash2 = hashOf<1>(value.second);
+    const auto slot2 = slotOf<1>(value.second, hash2);
+    if(_slots[1][slot2].entry != EMPTY)
+        return {begin() + _slots[1][slot2].entry, false};
+
+    const auto entry = static_cast<Index>(_entries.size());
+    _entries.push_back(std::move(value));
+    _slots[0][slot1] = {entry, hash1};
+    _slots[1][slot2] = {entry, hash2};
+    return {begin() + entry, true};
+}
+
+template<class Key1, class Key2, class Hash1, class Hash2>
+std::pair<typename DenseMap<Key1, Key2, Hash1, Hash2>::Key2ConstIterator, bool>
+DenseMap<Key1, Key2, Hash1, Hash2>::insert(Key2ValueType value)
+{
+    const auto result = insert(Key1ValueType(std::move(value.second), std::move(value.first)));
+    return {Key2ConstIterator(result.first), result.second};
+}
+
+template<class Key1, class Key2, class Hash1, class Hash2>
+typename DenseMap<Key1, Key2, Hash1, Hash2>::Key1ConstIterator DenseMap<Key1, Key2, Hash1, Hash2>::erase(
+    Key1ConstIterator pos)
+{
+    if(pos == end())
+        return end();
+    const auto entry = static_cast<Index>(pos - begin());
+    eraseEntry(entry, slotOfEntry<0>(entry), slotOfEntry<1>(entry));
+    return begin() + entry;
+}
+
+template<class Key1, class Key2, class Hash1, class Hash2>
+std::size_t DenseMap<Key1, Key2, Hash1, Hash2>::erase(const Key1& key)
+{
+    if(_entries.empty())
+        return 0;
+    const auto slot1 = slotOf<0>(key, hashOf<0>(key));
+    const auto entry = _slots[0][slot1].entry;
+    if(entry == EMPTY)
+        return 0;
+    eraseEntry(entry, slot1, slotOfEntry<1>(entry));
+    return 1;
+}
+
+template<class Key1, class Key2, class Hash1, class Hash2>
+std::size_t DenseMap<Key1, Key2, Hash1, Hash2>::erase(const Key2& key)
+{
+    if(_entries.empty())
+        return 0;
+    const auto slot2 = slotOf<1>(key, hashOf<1>(key));
+    const auto entry = _slots[1][slot2].entry;
+    if(entry == EMPTY)
+        return 0;
+    eraseEntry(entry, slotOfEntry<0>(entry), slot2);
+    return 1;
+}
+
+template<class Key1, class Key2, class Hash1, class Hash2>
+template<std::size_t Side>
+bool DenseMap<Key1, Key2, Hash1, Hash2>::T_move(const KeyOf<Side>& currentKey, const KeyOf<Side>& newKey)
+{
+    if(_entries.empty())
+        return false;
+    const auto slot = slotOf<Side>(currentKey, hashOf<Side>(currentKey));
+    const auto entry = _slots[Side][slot].entry;
+    const auto newHash = hashOf<Side>(newKey);
+    if(entry == EMPTY || _slots[Side][slotOf<Side>(newKey, newHash)].entry != EMPTY)
+        return false;
+
+    removeSlot<Side>(slot);
+    std::get<Side>(_entries[entry]) = newKey;
+    insertSlot<Side>(entry, newHash);
+    return true;
+}
+
+template<class Key1, class Key2, class Hash1, class Hash2>
+template<std::size_t Side>
+bool DenseMap<Key1, Key2, Hash1, Hash2>::T_moveOther(const KeyOf<Side>& key, const KeyOf<1 - Side>& newKey)
+{
+    const auto entry = entryOf<Side>(key);
+    if(entry == EMPTY)
+        return false;
+
+    // ) Moving to the current key is a success, like TMap
+    const auto& currentKey = std::get<1 - Side>(_entries[entry]);
+    if(currentKey == newKey)
+        return true;
+    return T_move<1 - Side>(KeyOf<1 - Side>(currentKey), newKey);
+}
+
+template<class Key1, class Key2, class Hash1, class Hash2>
+template<std::size_t Side>
+bool DenseMap<Key1, Key2, Hash1, Hash2>::T_swap(const KeyOf<Side>& key, const KeyOf<Side>& otherKey)
+{
+    if(_entries.empty())
+        return false;
+    const auto slot = slotOf<Side>(key, hashOf<Side>(key));
+    const auto otherSlot = slotOf<Side>(otherKey, hashOf<Side>(otherKey));
+    auto& entry = _slots[Side][slot].entry;
+    auto& otherEntry = _slots[Side][otherSlot].entry;
+    if(entry == EMPTY || otherEntry == EMPTY)
+        return false;
+
+    // ) The keys of Side trade their pairs, slots stay where their key hash
+    using std::swap;
+    swap(std::get<Side>(_entries[entry]), std::get<Side>(_entries[otherEntry]));
+    swap(entry, otherEntry);
+    return true;
+}
+
+template<class Key1, class Key2, class Hash1, class Hash2>
+typename DenseMap<Key1, Key2, Hash1, Hash2>::Key1ConstIterator DenseMap<Key1, Key2, Hash1, Hash2>::find(
+    const Key1& key) const
+{
+    const auto entry = entryOf<0>(key);
+    return entry == EMPTY ? end() : begin() + entry;
+}
+
+template<class Key1, class Key2, class Hash1, class Hash2>
+typename DenseMap<Key1, Key2, Hash1, Hash2>::Key2ConstIterator DenseMap<Key1, Key2, Hash1, Hash2>::find(
+    const Key2& key) const
+{
+    const auto entry = entryOf<1>(key);
+    return entry == EMPTY ? end2() : Key2ConstIterator(begin() + entry);
+}
+
+}
+
+#endif
@@ -0,0 +1,634 @@
+#ifndef __UNIQUE_DYNAMIC_ID_PROVIDER_HPP__
+#define __UNIQUE_DYNAMIC_ID_PROVIDER_HPP__
+
+// ─────────────────────────────────────────────────────────────
+//                  INCLUDE
+// ─────────────────────────────────────────────────────────────
+
+#include <Unique/IdSnapshot.hpp>
+#include <Unique/IntervalIdStorage.hpp>
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+// ─────────────────────────────────────────────────────────────
+//                  DECLARATION
+// ─────────────────────────────────────────────────────────────
+
+namespace unique {
+
+// ─────────────────────────────────────────────────────────────
+//                  CLASS
+// ─────────────────────────────────────────────────────────────
+
+/**
+ * Provide unique ids in [MIN, MAX), with bounds given at runtime.
+ * Released ids are kept in a Storage<T> that decide how available ids are tracked:
+ * - IntervalIdStorage: disjoint runs of ids, O(log runs) everywhere (default)
+ * - SetIdStorage: std::set of ids
+ * - BitmapIdStorage: hierarchical bitmap, no allocation per id
+ * - PagedIdStorage: sparse radix tree, memory follow the clusters of ids in a 64-bit space
+ * - LifoIdStorage, FifoIdStorage, QuarantineFifoIdStorage: reuse order other than lowest first
+ * A storage must provide LOWEST_FIRST, empty, size, contains, insert, insertRange, erase,
+ * eraseRunEndingAt, front, popFront, popFrontRun, popContiguous, findNear, forEachRun and clear.
+ * When LOWEST_FIRST is false, releasing the highest id doesn't shrink the counter: every released
+ * id go through the storage, so that its order is followed.
+ * IdProvider is the same provider with bounds known at compile time.
+ */
+template<typename T, template<typename> class Storage = IntervalIdStorage>
+class DynamicIdProvider
+{
+    // ──────── DEFAULTS ──────────
+public:
+    const T MIN;
+    const T MAX;
+
+    using Type = T;
+    using StorageType = Storage<T>;
+
+    /** \param min First id given. \param max Exclusive upper bound, should be greater than min */
+    DynamicIdProvider(const T min, const T max) :
+        MIN(min), MAX(max), _idCounter(min), _availableIds(min)
+    {
+        assert(min < max);
+    }
+
+    void assert_id(const T id) const;
+
+private:
+    /** Next id to return. It is always returned then incremented */
+    T _idCounter;
+    /** Available ids before idCounter */
+    StorageType _availableIds;
+    std::size_t _takenIdCounter = 0;
+
+private:
+    /** Decrement _idCounter while the id just below it is available, and erase those ids from _availableIds */
+    void shrinkIdCounter();
+
+    // ──────── C++ API ──────────
+public:
+    /** Force to increment idCounter if the id is >, or remove it from _availableIds.
+     * If the id isn't found in _available and id is < _idCounter then the function will fail
+     * \param id Value between _minId included and _maxId excluded. The function will assert otherwise
+     * \return false if id is inferior from _idCounter and value isn't present in _availableIds
+     */
+    bool takeId(const T id);
+
+    /** Take the next available id.
+     * \return _idCounter if _availableIds is empty, or the cheapest value to remove from _availableIds.
+     * Value will be between _minId and _maxId */
+    T takeNextId();
+
+    /**
+     * \brief Take count ids, lowest first, as takeNextId would.
+     * Available ids are consumed a run at a time, then ids are taken from the counter at once.
+     * \param out Output iterator receiving the ids
+     * \return Output iterator past the last written id. Less than count ids are written if MAX is reached
+     */
+    template<class OutputIt>
+    OutputIt takeNextIds(std::size_t count, OutputIt out);
+
+    /**
+     * \brief Take count consecutive ids, so that arrays indexed by id stay dense.
+     * The lowest run of count available ids is used, otherwise ids are taken from the counter.
+     * The function assert if the range doesn't fit before MAX
+     * \return First id of the range [first, first + count)
+     */
+    T takeContiguousRange(const std::size_t count);
+
+    /**
+     * \brief Take the available id closest to hint, the lowest one on a tie.
+     * Give related objects close ids, so that arrays indexed by id are swept with less cache misses.
+     * O(log runs) with IntervalIdStorage. The function assert if no id is available
+     * \param hint Typically the id of a parent object. Value between MIN included and MAX excluded
+     */
+    T takeIdNear(const T hint);
+
+    /**
+     * \brief Take count ids, each one the closest to hint among the ids left
+     * \return Output iterator past the last written id. Less than count ids are written if MAX is reached
+     */
+    template<class OutputIt>
+    OutputIt takeIdsNear(const T hint, std::size_t count, OutputIt out);
+
+    /**
+     * \brief Get the first id available in the list, or 0 if there are no id available in the id stack.
+     * This function doesn't remove the id from the stack. You should use `takeId` for that
+     * \return First id available in _availableIds or 0 if no ids available.
+     */
+    T getFirstIdAvailable() const;
+
+    /**
+     * \brief Get the next id available. So either calling getFirstIdAvailable if there is some _availableIds
+     * Otherwise return the valid of idCounter.
+     * This function doesn't increment the idCounter or take any id.
+     */
+    T getNextId() const;
+
+    /**
+     * \brief get the _idCounter even if some ids are available with getFirstIdAvailable()
+     */
+    T getNextEndId() const;
+
+    /**
+     * \brief Release an id to make it available to takeNextId again.
+     * The function assert if id isn't bound correctly or if value already have been released
+     * This behavior help to track bugs or misbehavior during dev
+     * \param id Value between _minId included and _maxId excluded. The function will assert otherwise
+     */
+    void releaseId(const T id);
+
+    /**
+     * \brief Release every id in the iterator range [first, last).
+     * Consecutive increasing ids are released as a single run with releaseIdRange
+     */
+    template<class InputIt>
+    void releaseIds(InputIt first, InputIt last);
+
+    /**
+     * \brief Release every id in [first, last). They must all be taken.
+     * Cost a single storage operation whatever the count of ids
+     */
+    void releaseIdRange(const T first, const T last);
+
+    /**
+     * \brief Get if an id is used in the _availableIds stack.
+     * \param id Value between _minId included and _maxId excluded. The function will assert otherwise
+     * \return true if the value if present in _availableIds
+     */
+    bool isIdAvailable(const T id) const;
+
+    /**
+     * \brief Get if an id is taken
+     * \param id Value between _minId included and _maxId excluded. The function will assert otherwise
+     * \return true if the value isn't present in _availableId and the value is inferior to idCounter
+     */
+    bool isIdTaken(const T id) const;
+
+    /**
+     * \brief Count of available id before _idCounter
+     * \return Size of _availableIds. This function is mainly tests
+     */
+    std::size_t countOfAvailableIds() const;
+
+    /**
+     * \brief Get if _availableIds is empty
+     * \return True if there are no available ids
+     */
+    bool availableIdsEmpty() const;
+
+    /**
+     * \brief Get if takeNextId can be safely called without reaching MAX id
+     * \return True takeNextId can be called
+     */
+    bool areIdsAvailables() const;
+
+    /** Get the count of taken ids */
+    std::size_t countOfTakenIds() const;
+
+    /**
+     * \brief Clear the counter and reset everything to initialization
+     * It can be seen as a reset function
+     */
+    void clear();
+
+    /** \brief Call function(first, last) for each run of available ids before the counter, lowest first */
+    template<class Function>
+    void forEachAvailableRun(Function function) const { _availableIds.forEachRun(function); }
+
+    /** \brief Size in bytes of the buffer needed by serialize */
+    std::size_t serializedSize() const;
+
+    /**
+     * \brief Write the counter, the count of taken ids and the available ids as runs in buffer.
+     * See IdSnapshotHeader for the format. The cost is O(runs), not O(ids)
+     * \return Count of bytes written, or 0 if size is too small
+     */
+    std::size_t serialize(void* buffer, const std::size_t size) const;
+
+    /**
+     * \brief Replace the state by a snapshot written by serialize, with any storage.
+     * buffer can be a memory mapped file, each run cost a single storage insertion.
+     * \return false if the snapshot is invalid or was written with other bounds or id type.
+     * The provider isn't modified in that case
+     */
+    bool deserialize(const void* buffer, const std::size_t size);
+};
+
+template<typename T, template<typename> class Storage>
+void DynamicIdProvider<T, Storage>::assert_id(const T id) const
+{
+    assert(id >= MIN);
+    assert(id < MAX);
+    (void)id;
+}
+
+template<typename T, template<typename> class Storage>
+void DynamicIdProvider<T, Storage>::shrinkIdCounter()
+{
+    // ) The whole run of available ids ending at _idCounter is removed at once
+    _idCounter = _availableIds.eraseRunEndingAt(_idCounter);
+    assert(_idCounter >= MIN);
+}
+
+template<typename T, template<typename> class Storage>
+bool DynamicIdProvider<T, Storage>::takeId(const T id)
+{
+    // ) Always assert the id to find bugs asap in debug
+    assert_id(id);
+    assert(_idCounter <= MAX);
+
+    // ) If we want to take _idCounter we can return it
+    if(id == _idCounter)
+    {
+        // ) We simply increment it for next takeNextId to work
+        ++_idCounter;
+
+        // ) Keep track of every id taken
+        ++_takenIdCounter;
+
+        return true;
+    }
+
+    // ) We want a value that is upper to id Counter, we insert a range from _idCounter to (id-1)
+    if(id > _idCounter)
+    {
+        // ) Value that are > _idCounter should never be inside _availableIds
+        _availableIds.insertRange(_idCounter, id);
+        _idCounter = id + 1;
+
+        // ) Keep track of every id taken
+        ++_takenIdCounter;
+
+        return true;
+    }
+
+    // ) We need to look if id is available in _availableIds
+    if(!_availableIds.erase(id))
+        return false;
+
+    // ) Keep track of every id taken
+    ++_takenIdCounter;
+    return true;
+}
+
+template<typename T, template<typename> class Storage>
+T DynamicIdProvider<T, Storage>::takeNextId()
+{
+    // ) If no ids are available to consume then we increment the counter
+    if(_availableIds.empty())
+    {
+        // ) We can't have idCounter >= the maxId. Because it mean we reached maximum memory available, we need to assert
+        assert(_idCounter < MAX);
+
+        // ) Keep track of every id taken
+        ++_takenIdCounter;
+
+        return _idCounter++;
+    }
+
+    // ) Get the first value the storage want to hand out
+    const auto id = _availableIds.popFront();
+
+    // ) Keep track of every id taken
+    ++_takenIdCounter;
+    return id;
+}
+
+template<typename T, template<typename> class Storage>
+template<class OutputIt>
+OutputIt DynamicIdProvider<T, Storage>::takeNextIds(std::size_t count, OutputIt out)
+{
+    // ) Consume available ids run by run, lowest first
+    while(count && !_availableIds.empty())
+    {
+        T first;
+        const auto taken = _availableIds.popFrontRun(count, first);
+        for(std::size_t i = 0; i < taken; ++i) *out++ = static_cast<T>(first + T(i));
+        _takenIdCounter += taken;
+        count -= taken;
+    }
+
+    // ) Then the counter is moved once for the remaining ids
+    const auto remaining = static_cast<std::size_t>(MAX - _idCounter);
+    if(count > remaining)
+        count = remaining;
+    for(std::size_t i = 0; i < count; ++i) *out++ = static_cast<T>(_idCounter + T(i));
+    _idCounter += static_cast<T>(count);
+    _takenIdCounter += count;
+
+    return out;
+}
+
+template<typename T, template<typename> class Storage>
+T DynamicIdProvider<T, Storage>::takeContiguousRange(const std::size_t count)
+{
+    assert(count > 0);
+
+    // ) Reuse a hole if one is big enough
+    T first;
+    if(_availableIds.popContiguous(count, first))
+    {
+        _takenIdCounter += count;
+        return first;
+    }
+
+    // ) Otherwise grow the counter. We can't have idCounter > the maxId
+    assert(count <= static_cast<std::size_t>(MAX - _idCounter));
+    first = _idCounter;
+    _idCounter += static_cast<T>(count);
+    _takenIdCounter += count;
+    return first;
+}
+
+template<typename T, template<typename> class Storage>
+T DynamicIdProvider<T, Storage>::takeIdNear(const T hint)
+{
+    assert_id(hint);
+
+    // ) Every id from the counter is free, so is hint
+    if(hint >= _idCounter)
+    {
+        takeId(hint);
+        return hint;
+    }
+
+    // ) Otherwise the closest is either the closest available id or the counter
+    T id;
+    if(_availableIds.findNear(hint, id) && (id > hint || _idCounter >= MAX || hint - id <= _idCounter - hint))
+    {
+        _availableIds.erase(id);
+        ++_takenIdCounter;
+        return id;
+    }
+
+    assert(_idCounter < MAX);
+    ++_takenIdCounter;
+    return _idCounter++;
+}
+
+template<typename T, template<typename> class Storage>
+template<class OutputIt>
+OutputIt DynamicIdProvider<T, Storage>::takeIdsNear(const T hint, std::size_t count, OutputIt out)
+{
+    for(; count && areIdsAvailables(); --count) *out++ = takeIdNear(hint);
+    return out;
+}
+
+template<typename T, template<typename> class Storage>
+T DynamicIdProvider<T, Storage>::getFirstIdAvailable() const
+{
+    return _availableIds.empty() ? 0 : _availableIds.front();
+}
+
+template<typename T, template<typename> class Storage>
+T DynamicIdProvider<T, Storage>::getNextId() const
+{
+    const auto firstAvailableId = getFirstIdAvailable();
+    return firstAvailableId ? firstAvailableId : _idCounter;
+}
+
+template<typename T, template<typename> class Storage>
+T DynamicIdProvider<T, Storage>::getNextEndId() const
+{
+    return _idCounter;
+}
+
+template<typename T, template<typename> class Storage>
+void DynamicIdProvider<T, Storage>::releaseId(const T id)
+{
+    // ) Always assert the id to find bugs asap in debug
+    assert_id(id);
+
+    // We can't release a non present id.
+    // If assert here instead of ignoring the case because
+    // it means that something got wrong. idCounter should always be greater that any present id
+    assert(_idCounter > id);
+
+    // ) If the id to release is the same as the id Counter,
+    // ie the id to release is the one got with getAvailableIdAndIncrement last call
+    // Then we simply decrement our counter
+    // ) Otherwise we keep track in our available id set
+    if(StorageType::LOWEST_FIRST && (_idCounter > MIN) && _idCounter - 1 == id)
+    {
+        // ) We need to look if id is available in _availableIds
+        --_idCounter;
+        shrinkIdCounter();
+    }
+    else
+    {
+        // ) Assert that the value is unique
+        assert(!isIdAvailable(id));
+        // ) Simply push back the available id in the set
+        _availableIds.insert(id);
+    }
+
+    assert(_takenIdCounter > 0);
+    --_takenIdCounter;
+}
+
+template<typename T, template<typename> class Storage>
+template<class InputIt>
+void DynamicIdProvider<T, Storage>::releaseIds(InputIt first, InputIt last)
+{
+    if(first == last)
+        return;
+
+    // ) Group consecutive ids so that each run cost a single storage operation
+    T runFirst = *first;
+    T runLast = runFirst + 1;
+    for(++first; first != last; ++first)
+    {
+        const T id = *first;
+        if(id == runLast)
+        {
+            ++runLast;
+            continue;
+        }
+        releaseIdRange(runFirst, runLast);
+        runFirst = id;
+        runLast = id + 1;
+    }
+    releaseIdRange(runFirst, runLast);
+}
+
+template<typename T, template<typename> class Storage>
+void DynamicIdProvider<T, Storage>::releaseIdRange(const T first, const T last)
+{
+    if(first >= last)
+        return;
+
+    // ) Always assert the ids to find bugs asap in debug
+    assert_id(first);
+    assert_id(last - 1);
+    assert(last <= _idCounter);
+    assert(isIdTaken(first) && isIdTaken(last - 1));
+
+    const auto count = static_cast<std::size_t>(last - first);
+    assert(_takenIdCounter >= count);
+    _takenIdCounter -= count;
+
+    // ) Same as releaseId: a range ending at the counter shrink it
+    if(StorageType::LOWEST_FIRST && last == _idCounter)
+    {
+        _idCounter = first;
+        shrinkIdCounter();
+    }
+    else
+        _availableIds.insertRange(first, last);
+}
+
+template<typename T, template<typename> class Storage>
+bool DynamicIdProvider<T, Storage>::isIdAvailable(const T id) const
+{
+    // ) Always assert the id to find bugs asap in debug
+    assert_id(id);
+
+    return id >= _idCounter || _availableIds.contains(id);
+}
+
+template<typename T, template<typename> class Storage>
+bool DynamicIdProvider<T, Storage>::isIdTaken(const T id) const
+{
+    return !isIdAvailable(id);
+}
+
+template<typename T, template<typename> class Storage>
+std::size_t DynamicIdProvider<T, Storage>::countOfAvailableIds() const
+{
+    return _availableIds.size();
+}
+
+template<typename T, template<typename> class Storage>
+bool DynamicIdProvider<T, Storage>::availableIdsEmpty() const
+{
+    return _availableIds.empty();
+}
+
+template<typename T, template<typename> class Storage>
+bool DynamicIdProvider<T, Storage>::areIdsAvailables() const
+{
+    return !availableIdsEmpty() || (_idCounter < MAX);
+}
+
+template<typename T, template<typename> class Storage>
+std::size_t DynamicIdProvider<T, Storage>::countOfTakenIds() const
+{
+    return _takenIdCounter;
+}
+
+template<typename T, template<typename> class Storage>
+void DynamicIdProvider<T, Storage>::clear()
+{
+    // ) Clear the idCounter and the available id array
+    _idCounter = MIN;
+    _availableIds.clear();
+    _takenIdCounter = 0;
+}
+
+template<typename T, template<typename> class Storage>
+std::size_t DynamicIdProvider<T, Storage>::serializedSize() const
+{
+    std::size_t runCount = 0;
+    _availableIds.forEachRun([&runCount](const T, const T) { ++runCount; });
+    return sizeof(IdSnapshotHeader) + runCount * sizeof(IdSnapshotRun);
+}
+
+template<typename T, template<typename> class Storage>
+std::size_t DynamicIdProvider<T, Storage>::serialize(void* buffer, const std::size_t size) const
+{
+    if(size < sizeof(IdSnapshotHeader))
+        return 0;
+
+    // ) Runs are written first, so that the storage is walked only once
+    auto* data = static_cast<unsigned char*>(buffer);
+    std::size_t offset = sizeof(IdSnapshotHeader);
+    std::uint64_t runCount = 0;
+    bool overflow = false;
+    _availableIds.forEachRun([&](const T first, const T last)
+    {
+        if(overflow || size - offset < sizeof(IdSnapshotRun))
+        {
+            overflow = true;
+            return;
+        }
+        const IdSnapshotRun run = {static_cast<std::uint64_t>(first), static_cast<std::uint64_t>(last)};
+        detail::writeSnapshot(data + offset, run);
+        offset += sizeof(IdSnapshotRun);
+        ++runCount;
+    });
+    if(overflow)
+        return 0;
+
+    IdSnapshotHeader header;
+    header.magic = IdSnapshotHeader::MAGIC;
+    header.version = IdSnapshotHeader::VERSION;
+    header.idSize = sizeof(T);
+    header.min = static_cast<std::uint64_t>(MIN);
+    header.max = static_cast<std::uint64_t>(MAX);
+    header.counter = static_cast<std::uint64_t>(_idCounter);
+    header.takenCount = _takenIdCounter;
+    header.runCount = runCount;
+    detail::writeSnapshot(data, header);
+    return offset;
+}
+
+template<typename T, template<typename> class Storage>
+bool DynamicIdProvider<T, Storage>::deserialize(const void* buffer, const std::size_t size)
+{
+    const auto* data = static_cast<const unsigned char*>(buffer);
+    if(size < sizeof(IdSnapshotHeader))
+        return false;
+
+    const auto header = detail::readSnapshot<IdSnapshotHeader>(data);
+    if(header.magic != IdSnapshotHeader::MAGIC || header.version != IdSnapshotHeader::VERSION
+        || header.idSize != sizeof(T) || header.min != static_cast<std::uint64_t>(MIN)
+        || header.max != static_cast<std::uint64_t>(MAX)
+        || header.runCount > (size - sizeof(IdSnapshotHeader)) / sizeof(IdSnapshotRun))
+        return false;
+
+    // ) Values are checked as stored, before any cast to T could wrap a corrupted value in range.
+    // ) A signed T is stored sign extended, so values are compared as unsigned offsets from min
+    const auto range = header.max - header.min;
+    const auto counterOffset = header.counter - header.min;
+    if(counterOffset > range)
+        return false;
+
+    // ) Validate every run before touching the provider: sorted, disjoint and below the counter
+    const auto* runs = data + sizeof(IdSnapshotHeader);
+    std::uint64_t availableCount = 0;
+    std::uint64_t previousLastOffset = 0;
+    for(std::uint64_t i = 0; i < header.runCount; ++i)
+    {
+        const auto run = detail::readSnapshot<IdSnapshotRun>(runs + i * sizeof(IdSnapshotRun));
+        const auto firstOffset = run.first - header.min;
+        const auto lastOffset = run.last - header.min;
+        if(firstOffset < previousLastOffset || firstOffset >= lastOffset || lastOffset > counterOffset)
+            return false;
+        availableCount += lastOffset - firstOffset;
+        previousLastOffset = lastOffset;
+    }
+
+    // ) Runs are disjoint and below the counter, so availableCount can't exceed counterOffset
+    if(header.takenCount != counterOffset - availableCount
+        || header.takenCount > static_cast<std::uint64_t>(std::numeric_limits<std::size_t>::max()))
+        return false;
+
+    // ) Runs are sorted, so each one is appended after the previous one
+    clear();
+    for(std::uint64_t i = 0; i < header.runCount; ++i)
+    {
+        const auto run = detail::readSnapshot<IdSnapshotRun>(runs + i * sizeof(IdSnapshotRun));
+        _availableIds.insertRange(static_cast<T>(run.first), static_cast<T>(run.last));
+    }
+    _idCounter = static_cast<T>(header.counter);
+    _takenIdCounter = static_cast<std::size_t>(header.takenCount);
+    return true;
+}
+
+}
+
+#endif
@@ -0,0 +1,234 @@
+#ifndef __UNIQUE_FIXED_ID_PROVIDER_HPP__
+#define __UNIQUE_FIXED_ID_PROVIDER_HPP__
+
+// ─────────────────────────────────────────────────────────────
+//                  INCLUDE
+// ─────────────────────────────────────────────────────────────
+
+#include <Unique/Bits.hpp>
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+// ─────────────────────────────────────────────────────────────
+//                  DECLARATION
+// ─────────────────────────────────────────────────────────────
+
+namespace unique {
+
+// ─────────────────────────────────────────────────────────────
+//                  CLASS
+// ─────────────────────────────────────────────────────────────
+
+/**
+ * Provide unique ids in [min, min + Capacity) without any heap allocation, for threads that may not
+ * allocate. Available ids are bits of an inline two levels bitmap: a summary bit per word tell if
+ * the word has an available id. The lowest available id is handed out first.
+ * takeNextId cost at most Capacity / 4096 summary words and two bit scans, every other call is O(1).
+ * Every function is constexpr, so a provider can be filled at compile time.
+ */
+template<typename T, T min, std::size_t Capacity>
+class FixedIdProvider
+{
+    // ──────── DEFAULTS ──────────
+public:
+    static_assert(Capacity > 0, "Capacity should be greater than 0");
+    // ) Checked in 64 bits: T(Capacity) would truncate first. A negative min wrap so that the difference is still exact
+    static_assert(std::uint64_t(Capacity) <= std::uint64_t(std::numeric_limits<T>::max()) - std::uint64_t(min),
+        "min + Capacity should fit in T");
+
+    static constexpr T MIN = min;
+    static constexpr T MAX = T(std::uint64_t(min) + Capacity);
+    static constexpr std::size_t CAPACITY = Capacity;
+
+    using Type = T;
+
+    constexpr FixedIdProvider() { clear(); }
+
+    static constexpr void assert_id(const T id);
+
+private:
+    using Word = std::uint64_t;
+
+    static constexpr std::size_t WORD_BITS = 64;
+    static constexpr std::size_t WORD_COUNT = (Capacity + WORD_BITS - 1) / WORD_BITS;
+    static constexpr std::size_t SUMMARY_COUNT = (WORD_COUNT + WORD_BITS - 1) / WORD_BITS;
+
+    /** Bit set for each available id */
+    Word _availableIds[WORD_COUNT] = {};
+    /** Bit set for each word of _availableIds that isn't 0 */
+    Word _summary[SUMMARY_COUNT] = {};
+    std::size_t _takenIdCounter = 0;
+
+private:
+    static constexpr std::size_t offsetOf(const T id) { return static_cast<std::size_t>(id - min); }
+
+    static constexpr Word bitOf(const std::size_t offset) { return Word(1) << (offset % WORD_BITS); }
+
+    /** Mark offset as taken. It must be available */
+    constexpr void take(const std::size_t offset);
+
+    /** Offset of the lowest available id, or Capacity if there is none */
+    constexpr std::size_t lowestAvailable() const;
+
+    // ──────── C++ API ──────────
+public:
+    /**
+     * \brief Take id if it is available
+     * \param id Value between MIN included and MAX excluded. The function will assert otherwise
+     * \return false if id is already taken
+     */
+    constexpr bool takeId(const T id);
+
+    /**
+     * \brief Take the lowest available id.
+     * The function assert and return MAX if every id is taken
+     */
+    constexpr T takeNextId();
+
+    /** \brief Lowest available id without taking it, MAX if every id is taken */
+    constexpr T getNextId() const;
+
+    /**
+     * \brief Release an id to make it available to takeNextId again.
+     * The function assert if id isn't bound correctly or if it isn't taken
+     */
+    constexpr void releaseId(const T id);
+
+    /** \brief Get if id can be taken */
+    constexpr bool isIdAvailable(const T id) const;
+
+    /** \brief Get if id is taken */
+    constexpr bool isIdTaken(const T id) const { return !isIdAvailable(id); }
+
+    /** \brief Get if takeNextId can be called without reaching MAX */
+    constexpr bool areIdsAvailables() const { return _takenIdCounter < Capacity; }
+
+    /** Get the count of taken ids */
+    constexpr std::size_t countOfTakenIds() const { return _takenIdCounter; }
+
+    /** Get the count of ids that can still be taken */
+    constexpr std::size_t countOfAvailableIds() const { return Capacity - _takenIdCounter; }
+
+    /** Release every id */
+    constexpr void clear();
+};
+
+template<typename T, T min, std::size_t Capacity>
+constexpr T FixedIdProvider<T, min, Capacity>::MIN;
+template<typename T, T min, std::size_t Capacity>
+constexpr T FixedIdProvider<T, min, Capacity>::MAX;
+template<typename T, T min, std::size_t Capacity>
+constexpr std::size_t FixedIdProvider<T, min, Capacity>::CAPACITY;
+template<typename T, T min, std::size_t Capacity>
+constexpr std::size_t FixedIdProvider<T, min, Capacity>::WORD_BITS;
+template<typename T, T min, std::size_t Capacity>
+constexpr std::size_t FixedIdProvider<T, min, Capacity>::WORD_COUNT;
+template<typename T, T min, std::size_t Capacity>
+constexpr std::size_t FixedIdProvider<T, min, Capacity>::SUMMARY_COUNT;
+
+template<typename T, T min, std::size_t Capacity>
+constexpr void FixedIdProvider<T, min, Capacity>::assert_id(const T id)
+{
+    assert(id >= MIN);
+    assert(id < MAX);
+    (void)id;
+}
+
+template<typename T, T min, std::size_t Capacity>
+constexpr void FixedIdProvider<T, min, Capacity>::take(const std::size_t offset)
+{
+    const auto w = offset / WORD_BITS;
+    _availableIds[w] &= ~bitOf(offset);
+    if(!_availableIds[w])
+        _summary[w / WORD_BITS] &= ~bitOf(w);
+    ++_takenIdCounter;
+}
+
+template<typename T, T min, std::size_t Capacity>
+constexpr std::size_t FixedIdProvider<T, min, Capacity>::lowestAvailable() const
+{
+    for(std::size_t s = 0; s < SUMMARY_COUNT; ++s)
+    {
+        if(!_summary[s])
+            continue;
+        const auto w = s * WORD_BITS + detail::constexprCountTrailingZeros(_summary[s]);
+        return w * WORD_BITS + detail::constexprCountTrailingZeros(_availableIds[w]);
+    }
+    return Capacity;
+}
+
+template<typename T, T min, std::size_t Capacity>
+constexpr bool FixedIdProvider<T, min, Capacity>::takeId(const T id)
+{
+    assert_id(id);
+    if(!isIdAvailable(id))
+        return false;
+    take(offsetOf(id));
+    return true;
+}
+
+template<typename T, T min, std::size_t Capacity>
+constexpr T FixedIdProvider<T, min, Capacity>::takeNextId()
+{
+    const auto offset = lowestAvailable();
+
+    // ) Every id is taken, like DynamicIdProvider reaching MAX
+    assert(offset < Capacity);
+    if(offset >= Capacity)
+        return MAX;
+
+    take(offset);
+    return T(min + T(offset));
+}
+
+template<typename T, T min, std::size_t Capacity>
+constexpr T FixedIdProvider<T, min, Capacity>::getNextId() const
+{
+    return T(min + T(lowestAvailable()));
+}
+
+template<typename T, T min, std::size_t Capacity>
+constexpr void FixedIdProvider<T, min, Capacity>::releaseId(const T id)
+{
+    // ) Always assert the id to find bugs asap in debug
+    assert_id(id);
+    assert(isIdTaken(id));
+
+    const auto offset = offsetOf(id);
+    const auto w = offset / WORD_BITS;
+    _availableIds[w] |= bitOf(offset);
+    _summary[w / WORD_BITS] |= bitOf(w);
+
+    assert(_takenIdCounter > 0);
+    --_takenIdCounter;
+}
+
+template<typename T, T min, std::size_t Capacity>
+constexpr bool FixedIdProvider<T, min, Capacity>::isIdAvailable(const T id) const
+{
+    assert_id(id);
+    const auto offset = offsetOf(id);
+    return (_availableIds[offset / WORD_BITS] & bitOf(offset)) != 0;
+}
+
+template<typename T, T min, std::size_t Capacity>
+constexpr void FixedIdProvider<T, min, Capacity>::clear()
+{
+    // ) Every word is full but the last one, where only ids below Capacity are set
+    for(std::size_t w = 0; w < WORD_COUNT; ++w) _availableIds[w] = ~Word(0);
+    if(Capacity % WORD_BITS)
+        _availableIds[WORD_COUNT - 1] = (Word(1) << (Capacity % WORD_BITS)) - 1;
+
+    for(std::size_t s = 0; s < SUMMARY_COUNT; ++s) _summary[s] = ~Word(0);
+    if(WORD_COUNT % WORD_BITS)
+        _summary[SUMMARY_COUNT - 1] = (Word(1) << (WORD_COUNT % WORD_BITS)) - 1;
+
+    _takenIdCounter = 0;
+}
+
+}
+
+#endif
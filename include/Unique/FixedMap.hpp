@@ -0,0 +1,334 @@
+#ifndef __UNIQUE_FIXED_MAP_HPP__
+#define __UNIQUE_FIXED_MAP_HPP__
+
+// ─────────────────────────────────────────────────────────────
+//                  INCLUDE
+// ─────────────────────────────────────────────────────────────
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+// ─────────────────────────────────────────────────────────────
+//                  DECLARATION
+// ─────────────────────────────────────────────────────────────
+
+namespace unique {
+
+// ─────────────────────────────────────────────────────────────
+//                  CLASS
+// ─────────────────────────────────────────────────────────────
+
+/**
+ * Constexpr hash of integers and enums for FixedMap, the finalizer of splitmix64.
+ * Other keys need their own constexpr hash to stay usable in constant expressions.
+ */
+template<class Key>
+struct FixedHash
+{
+    static_assert(std::is_integral<Key>::value || std::is_enum<Key>::value,
+        "FixedHash only hash integers and enums, give a hash to FixedMap");
+
+    constexpr std::size_t operator()(const Key& key) const
+    {
+        auto x = static_cast<std::uint64_t>(key);
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+        return static_cast<std::size_t>(x ^ (x >> 31));
+    }
+};
+
+/**
+ * Bimap of at most Capacity pairs without any heap allocation, for threads that may not allocate.
+ * Pairs are stored densely in an inline array, in insertion order until an erase move the last
+ * pair in the hole. Each key type has an open addressing index of 2 * Capacity rounded to a power
+ * of two, with linear probing and backward shift deletion: no tombstone, so the probe length only
+ * depend on the current content, never on the history.
+ * Keys must be default constructible. Every function is constexpr, so a map made of literal keys
+ * can be filled at compile time.
+ */
+template<class Key1, class Key2, std::size_t Capacity,
+    class Hash1 = FixedHash<Key1>, class Hash2 = FixedHash<Key2>>
+class FixedMap
+{
+    // ──────── TYPES ──────────
+public:
+    static_assert(Capacity > 0, "Capacity should be greater than 0");
+
+    static constexpr std::size_t CAPACITY = Capacity;
+
+    struct Entry
+    {
+        Key1 first;
+        Key2 second;
+    };
+
+    using ConstIterator = const Entry*;
+
+private:
+    static constexpr std::size_t tableSize(const std::size_t size)
+    {
+        std::size_t result = 1;
+        while(result < size) result *= 2;
+        return result;
+    }
+
+    static constexpr std::size_t TABLE_SIZE = tableSize(2 * Capacity);
+    static constexpr std::size_t MASK = TABLE_SIZE - 1;
+    /** Slot of an index that doesn't refer to any entry */
+    static constexpr std::size_t EMPTY = std::size_t(-1);
+
+    Entry _entries[Capacity] = {};
+    std::size_t _size = 0;
+    /** Entry index of each slot, for Key1 then for Key2 */
+    std::size_t _indexes[2][TABLE_SIZE] = {};
+
+private:
+    constexpr std::size_t homeOf(const std::size_t side, const std::size_t entry) const
+    {
+        return (side ? Hash2()(_entries[entry].second) : Hash1()(_entries[entry].first)) & MASK;
+    }
+
+    /** Slot holding key, or the empty slot where key would be inserted */
+    constexpr std::size_t slotOf(const Key1& key) const;
+    constexpr std::size_t slotOf(const Key2& key) const;
+
+    /** Slot of the index of side that refer to entry. entry must be indexed */
+    constexpr std::size_t slotOfEntry(const std::size_t side, const std::size_t entry) const;
+
+    /** Empty slot, then shift back the following slots that are not at their home */
+    constexpr void removeSlot(const std::size_t side, std::size_t slot);
+
+    /** Erase the entry indexed at slot1 and slot2 */
+    constexpr bool eraseSlots(const std::size_t slot1, const std::size_t slot2);
+
+    /** Index entry in side, its key must not be indexed yet */
+    constexpr void insertSlot(const std::size_t side, const std::size_t entry);
+
+    // ──────── C++ API ──────────
+public:
+    constexpr FixedMap() { clear(); }
+
+    constexpr ConstIterator begin() const { return _entries; }
+    constexpr ConstIterator end() const { return _entries + _size; }
+
+    constexpr std::size_t size() const { return _size; }
+    constexpr bool empty() const { return _size == 0; }
+    constexpr bool full() const { return _size == Capacity; }
+    static constexpr std::size_t capacity() { return Capacity; }
+
+    /**
+     * \brief Insert the pair (key1, key2)
+     * \return false if the map is full, or if key1 or key2 is already in the map
+     */
+    constexpr bool insert(const Key1& key1, const Key2& key2);
+
+    /** \brief Pair of key, or end() */
+    constexpr ConstIterator find(const Key1& key) const;
+    constexpr ConstIterator find(const Key2& key) const;
+
+    constexpr bool contains(const Key1& key) const { return find(key) != end(); }
+    constexpr bool contains(const Key2& key) const { return find(key) != end(); }
+
+    /**
+     * \brief Erase the pair of key. The last pair move in its place
+     * \return false if key isn't in the map
+     */
+    constexpr bool erase(const Key1& key);
+    constexpr bool erase(const Key2& key);
+
+    /**
+     * \brief Replace currentKey by newKey, the associated key is kept
+     * \return false if currentKey isn't in the map or newKey already is
+     */
+    constexpr bool move(const Key1& currentKey, const Key1& newKey);
+    constexpr bool move(const Key2& currentKey, const Key2& newKey);
+
+    /** Erase every pair */
+    constexpr void clear();
+};
+
+template<class Key1, class Key2, std::size_t Capacity, class Hash1, class Hash2>
+constexpr std::size_t FixedMap<Key1, Key2, Capacity, Hash1, Hash2>::CAPACITY;
+template<class Key1, class Key2, std::size_t Capacity, class Hash1, class Hash2>
+constexpr std::size_t FixedMap<Key1, Key2, Capacity, Hash1, Hash2>::TABLE_SIZE;
+template<class Key1, class Key2, std::size_t Capacity, class Hash1, class Hash2>
+constexpr std::size_t FixedMap<Key1, Key2, Capacity, Hash1, Hash2>::MASK;
+template<class Key1, class Key2, std::size_t Capacity, class Hash1, class Hash2>
+constexpr std::size_t FixedMap<Key1, Key2, Capacity, Hash1, Hash2>::EMPTY;
+
+template<class Key1, class Key2, std::size_t Capacity, class Hash1, class Hash2>
+constexpr std::size_t FixedMap<Key1, Key2, Capacity, Hash1, Hash2>::slotOf(const Key1& key) const
+{
+    // ) Load factor is at most 1/2, there is always an empty slot to stop the probe
+    auto slot = Hash1()(key) & MASK;
+    while(_indexes[0][slot] != EMPTY && !(_entries[_indexes[0][slot]].first == key))
+        slot = (slot + 1) & MASK;
+    return slot;
+}
+
+template<class Key1, class Key2, std::size_t Capacity, class Hash1, class Hash2>
+constexpr std::size_t FixedMap<Key1, Key2, Capacity, Hash1, Hash2>::slotOf(const Key2& key) const
+{
+    auto slot = Hash2()(key) & MASK;
+    while(_indexes[1][slot] != EMPTY && !(_entries[_indexes[1][slot]].second == key))
+        slot = (slot + 1) & MASK;
+    return slot;
+}
+
+template<class Key1, class Key2, std::size_t Capacity, class Hash1, class Hash2>
+constexpr std::size_t FixedMap<Key1, Key2, Capacity, Hash1, Hash2>::slotOfEntry(
+    const std::size_t side, const std::size_t entry) const
+{
+    auto slot = homeOf(side, entry);
+    while(_indexes[side][slot] != entry)
+    {
+        assert(_indexes[side][slot] != EMPTY);
+        slot = (slot + 1) & MASK;
+    }
+    return slot;
+}
+
+template<class Key1, class Key2, std::size_t Capacity, class Hash1, class Hash2>
+constexpr void FixedMap<Key1, Key2, Capacity, Hash1, Hash2>::removeSlot(const std::size_t side, std::size_t slot)
+{
+    auto& index = _indexes[side];
+    for(auto next = (slot + 1) & MASK; index[next] != EMPTY; next = (next + 1) & MASK)
+    {
+        // ) An entry can fill the hole if the hole is between its home and its slot
+        const auto home = homeOf(side, index[next]);
+        if(((next - home) & MASK) >= ((next - slot) & MASK))
+        {
+            index[slot] = index[next];
+            slot = next;
+        }
+    }
+    index[slot] = EMPTY;
+}
+
+template<class Key1, class Key2, std::size_t Capacity, class Hash1, class Hash2>
+constexpr void FixedMap<Key1, Key2, Capacity, Hash1, Hash2>::insertSlot(const std::size_t side, const std::size_t entry)
+{
+    auto slot = homeOf(side, entry);
+    while(_indexes[side][slot] != EMPTY) slot = (slot + 1) & MASK;
+    _indexes[side][slot] = entry;
+}
+
+template<class Key1, class Key2, std::size_t Capacity, class Hash1, class Hash2>
+constexpr bool FixedMap<Key1, Key2, Capacity, Hash1, Hash2>::insert(const Key1& key1, const Key2& key2)
+{
+    if(full())
+        return false;
+    const auto slot1 = slotOf(key1);
+    const auto slot2 = slotOf(key2);
+    if(_indexes[0][slot1] != EMPTY || _indexes[1][slot2] != EMPTY)
+        return false;
+
+    _entries[_size].first = key1;
+    _entries[_size].second = key2;
+    _indexes[0][slot1] = _size;
+    _indexes[1][slot2] = _size;
+    ++_size;
+    return true;
+}
+
+template<class Key1, class Key2, std::size_t Capacity, class Hash1, class Hash2>
+constexpr typename FixedMap<Key1, Key2, Capacity, Hash1, Hash2>::ConstIterator
+FixedMap<Key1, Key2, Capacity, Hash1, Hash2>::find(const Key1& key) const
+{
+    const auto entry = _indexes[0][slotOf(key)];
+    return entry == EMPTY ? end() : _entries + entry;
+}
+
+template<class Key1, class Key2, std::size_t Capacity, class Hash1, class Hash2>
+constexpr typename FixedMap<Key1, Key2, Capacity, Hash1, Hash2>::ConstIterator
+FixedMap<Key1, Key2, Capacity, Hash1, Hash2>::find(const Key2& key) const
+{
+    const auto entry = _indexes[1][slotOf(key)];
+    return entry == EMPTY ? end() : _entries + entry;
+}
+
+template<class Key1, class Key2, std::size_t Capacity, class Hash1, class Hash2>
+constexpr bool FixedMap<Key1, Key2, Capacity, Hash1, Hash2>::eraseSlots(const std::size_t slot1, const std::size_t slot2)
+{
+    const auto entry = _indexes[0][slot1];
+    removeSlot(0, slot1);
+    removeSlot(1, slot2);
+
+    // ) Keep entries dense: the last one move in the hole and its slots are updated
+    const auto last = _size - 1;
+    if(entry != last)
+    {
+        _indexes[0][slotOfEntry(0, last)] = entry;
+        _indexes[1][slotOfEntry(1, last)] = entry;
+        _entries[entry] = _entries[last];
+    }
+    _entries[last] = Entry();
+    --_size;
+    return true;
+}
+
+template<class Key1, class Key2, std::size_t Capacity, class Hash1, class Hash2>
+constexpr bool FixedMap<Key1, Key2, Capacity, Hash1, Hash2>::erase(const Key1& key)
+{
+    const auto slot1 = slotOf(key);
+    const auto entry = _indexes[0][slot1];
+    if(entry == EMPTY)
+        return false;
+    return eraseSlots(slot1, slotOfEntry(1, entry));
+}
+
+template<class Key1, class Key2, std::size_t Capacity, class Hash1, class Hash2>
+constexpr bool FixedMap<Key1, Key2, Capacity, Hash1, Hash2>::erase(const Key2& key)
+{
+    const auto slot2 = slotOf(key);
+    const auto entry = _indexes[1][slot2];
+    if(entry == EMPTY)
+        return false;
+    return eraseSlots(slotOfEntry(0, entry), slot2);
+}
+
+template<class Key1, class Key2, std::size_t Capacity, class Hash1, class Hash2>
+constexpr bool FixedMap<Key1, Key2, Capacity, Hash1, Hash2>::move(const Key1& currentKey, const Key1& newKey)
+{
+    const auto slot = slotOf(currentKey);
+    const auto entry = _indexes[0][slot];
+    if(entry == EMPTY || _indexes[0][slotOf(newKey)] != EMPTY)
+        return false;
+
+    removeSlot(0, slot);
+    _entries[entry].first = newKey;
+    insertSlot(0, entry);
+    return true;
+}
+
+template<class Key1, class Key2, std::size_t Capacity, class Hash1, class Hash2>
+constexpr bool FixedMap<Key1, Key2, Capacity, Hash1, Hash2>::move(const Key2& currentKey, const Key2& newKey)
+{
+    const auto slot = slotOf(currentKey);
+    const auto entry = _indexes[1][slot];
+    if(entry == EMPTY || _indexes[1][slotOf(newKey)] != EMPTY)
+        return false;
+
+    removeSlot(1, slot);
+    _entries[entry].second = newKey;
+    insertSlot(1, entry);
+    return true;
+}
+
+template<class Key1, class Key2, std::size_t Capacity, class Hash1, class Hash2>
+constexpr void FixedMap<Key1, Key2, Capacity, Hash1, Hash2>::clear()
+{
+    for(std::size_t i = 0; i < _size; ++i) _entries[i] = Entry();
+    for(std::size_t slot = 0; slot < TABLE_SIZE; ++slot)
+    {
+        _indexes[0][slot] = EMPTY;
+        _indexes[1][slot] = EMPTY;
+    }
+    _size = 0;
+}
+
+}
+
+#endif
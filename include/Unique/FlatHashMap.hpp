@@ -0,0 +1,712 @@
+#ifndef __UNIQUE_FLAT_HASH_MAP_HPP__
+#define __UNIQUE_FLAT_HASH_MAP_HPP__
+
+// ─────────────────────────────────────────────────────────────
+//                  INCLUDE
+// ─────────────────────────────────────────────────────────────
+
+#include <Unique/Bits.hpp>
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define UNIQUE_FLAT_HASH_MAP_SSE2 1
+    #include <emmintrin.h>
+#endif
+
+// ─────────────────────────────────────────────────────────────
+//                  DECLARATION
+// ─────────────────────────────────────────────────────────────
+
+namespace unique {
+namespace detail {
+
+// ─────────────────────────────────────────────────────────────
+//                  CONTROL BYTES
+// ─────────────────────────────────────────────────────────────
+
+/**
+ * Control byte of a FlatHashMap slot. A full slot store the 7 low bits of its hash, so that a
+ * group compare 16 hashes at once before any key is read.
+ */
+using Ctrl = std::int8_t;
+
+enum : Ctrl
+{
+    CTRL_EMPTY = -128,
+    CTRL_DELETED = -2,
+    /** After the last slot, stop iterators */
+    CTRL_SENTINEL = -1,
+};
+
+inline bool isCtrlFull(const Ctrl ctrl) { return ctrl >= 0; }
+
+/** Set of slots of a group, iterated lowest first */
+template<unsigned Shift>
+class GroupMask
+{
+public:
+    explicit GroupMask(const std::uint64_t mask) : _mask(mask) {}
+
+    explicit operator bool() const { return _mask != 0; }
+
+    /** Offset in the group of the lowest slot. The mask must not be empty */
+    unsigned lowest() const { return countTrailingZeros(_mask) >> Shift; }
+
+    /** Count of slots before the lowest slot of the mask. The mask must not be empty */
+    unsigned trailingZeros() const { return countTrailingZeros(_mask) >> Shift; }
+
+    /** Count of slots after the highest slot of the mask, in a group of width slots */
+    unsigned leadingZeros(const unsigned width) const
+    {
+        return width - 1 - (highestBit(_mask) >> Shift);
+    }
+
+    GroupMask& operator++()
+    {
+        _mask &= _mask - 1;
+        return *this;
+    }
+
+private:
+    std::uint64_t _mask;
+};
+
+#ifdef UNIQUE_FLAT_HASH_MAP_SSE2
+
+/** 16 control bytes compared with SSE2, a bit per slot */
+class CtrlGroup
+{
+public:
+    enum : unsigned
+    {
+        WIDTH = 16
+    };
+
+    using Mask = GroupMask<0>;
+
+    explicit CtrlGroup(const Ctrl* ctrl) : _ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl))) {}
+
+    Mask match(const Ctrl hash) const { return Mask(movemask(_mm_cmpeq_epi8(_mm_set1_epi8(hash), _ctrl))); }
+
+    Mask matchEmpty() const { return match(CTRL_EMPTY); }
+
+    /** Empty and deleted are the only control bytes below the sentinel */
+    Mask matchEmptyOrDeleted() const
+    {
+        return Mask(movemask(_mm_cmpgt_epi8(_mm_set1_epi8(CTRL_SENTINEL), _ctrl)));
+    }
+
+private:
+    static std::uint64_t movemask(const __m128i value)
+    {
+        return static_cast<std::uint64_t>(static_cast<std::uint16_t>(_mm_movemask_epi8(value)));
+    }
+
+    __m128i _ctrl;
+};
+
+#else
+
+/** 8 control bytes compared in a 64 bits word, the high bit of each byte per slot */
+class CtrlGroup
+{
+public:
+    enum : unsigned
+    {
+        WIDTH = 8
+    };
+
+    using Mask = GroupMask<3>;
+
+    explicit CtrlGroup(const Ctrl* ctrl) { std::memcpy(&_ctrl, ctrl, sizeof(_ctrl)); }
+
+    /** Can report a false positive right after a true one, keys are compared anyway */
+    Mask match(const Ctrl hash) const
+    {
+        const auto x = _ctrl ^ (LSBS * static_cast<std::uint8_t>(hash));
+        return Mask((x - LSBS) & ~x & MSBS);
+    }
+
+    /** Empty is the only control byte with bit 7 set and bit 1 clear */
+    Mask matchEmpty() const { return Mask((_ctrl & ~(_ctrl << 6)) & MSBS); }
+
+    /** Empty and deleted are the only control bytes with bit 7 set and bit 0 clear */
+    Mask matchEmptyOrDeleted() const { return Mask((_ctrl & ~(_ctrl << 7)) & MSBS); }
+
+private:
+    static constexpr std::uint64_t LSBS = 0x0101010101010101ull;
+    static constexpr std::uint64_t MSBS = 0x8080808080808080ull;
+
+    std::uint64_t _ctrl = 0;
+};
+
+#endif
+
+/** True when Functor declare is_transparent, as the functors of heterogeneous lookup */
+template<class Functor, class = void>
+struct IsTransparentFunctor : std::false_type
+{
+};
+
+template<class Functor>
+struct IsTransparentFunctor<Functor, std::void_t<typename Functor::is_transparent>> : std::true_type
+{
+};
+
+}
+
+// ─────────────────────────────────────────────────────────────
+//                  CLASS
+// ─────────────────────────────────────────────────────────────
+
+/**
+ * Open addressing hash map in the SwissTable layout, usable as Map1 or Map2 of TMap.
+ * Pairs are stored inline in a slot array, next to an array of control bytes holding 7 bits of the
+ * hash of each slot. A lookup load a group of 16 control bytes (SSE2, or 8 bytes in a 64 bits word
+ * without it), compare them to the hash at once, and only read the keys whose control byte match.
+ * The probe stop at the first group with an empty slot, groups are probed in triangular order.
+ *
+ * Load factor is at most 7/8. Erase leave a tombstone only if a probe may have passed the slot,
+ * and tombstones are dropped when the table grow. Iterators are invalidated by every insert that
+ * grow the table: call reserve before inserting many pairs.
+ * Like std::unordered_map, value_type is std::pair<const Key, Value>, so growing copy the keys.
+ * When Hash and KeyEqual are transparent, find, contains, count and erase accept any key they
+ * hash and compare, without building a Key: the heterogeneous lookup of C++20 std::unordered_map.
+ */
+template<class Key, class Value, class Hash = std::hash<Key>, class KeyEqual = std::equal_to<Key>>
+class FlatHashMap
+{
+    // ──────── TYPES ──────────
+public:
+    using key_type = Key;
+    using mapped_type = Value;
+    using value_type = std::pair<const Key, Value>;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using hasher = Hash;
+    using key_equal = KeyEqual;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+
+    template<bool Const>
+    class Iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = typename FlatHashMap::value_type;
+        using difference_type = std::ptrdiff_t;
+        using reference = typename std::conditional<Const, const value_type&, value_type&>::type;
+        using pointer = typename std::conditional<Const, const value_type*, value_type*>::type;
+
+        Iterator() = default;
+        Iterator(const detail::Ctrl* ctrl, value_type* slot) : _ctrl(ctrl), _slot(slot) { skipFree(); }
+
+        /** iterator convert to const_iterator */
+        template<bool OtherConst, class = typename std::enable_if<Const && !OtherConst>::type>
+        Iterator(const Iterator<OtherConst>& other) : _ctrl(other._ctrl), _slot(other._slot)
+        {
+        }
+
+        reference operator*() const { return *_slot; }
+        pointer operator->() const { return _slot; }
+
+        Iterator& operator++()
+        {
+            ++_ctrl;
+            ++_slot;
+            skipFree();
+            return *this;
+        }
+
+        Iterator operator++(int)
+        {
+            auto result = *this;
+            ++*this;
+            return result;
+        }
+
+        friend bool operator==(const Iterator& a, const Iterator& b) { return a._ctrl == b._ctrl; }
+        friend bool operator!=(const Iterator& a, const Iterator& b) { return a._ctrl != b._ctrl; }
+
+    private:
+        friend class FlatHashMap;
+        template<bool>
+        friend class Iterator;
+
+        /** Stop on the next full slot or on the sentinel */
+        void skipFree()
+        {
+            while(*_ctrl < detail::CTRL_SENTINEL)
+            {
+                ++_ctrl;
+                ++_slot;
+            }
+        }
+
+        const detail::Ctrl* _ctrl = nullptr;
+        value_type* _slot = nullptr;
+    };
+
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+private:
+    using Group = detail::CtrlGroup;
+    using Ctrl = detail::Ctrl;
+
+    static constexpr std::size_t WIDTH = Group::WIDTH;
+
+    /** Control bytes of a table without slots: a sentinel, then a group of empty */
+    static const Ctrl* emptyCtrl();
+
+    /** capacity is 2^n - 1, it is used as a mask. ctrl hold capacity + WIDTH bytes: the control
+     * bytes, the sentinel, then a copy of the first WIDTH - 1 control bytes so that groups can be
+     * loaded from any slot */
+    Ctrl* _ctrl = const_cast<Ctrl*>(emptyCtrl());
+    value_type* _slots = nullptr;
+    std::size_t _capacity = 0;
+    std::size_t _size = 0;
+    /** Count of empty slots that can be filled before the table grow */
+    std::size_t _growthLeft = 0;
+    Hash _hash {};
+    KeyEqual _equal {};
+
+private:
+    static std::size_t growthOf(const std::size_t capacity) { return capacity - (capacity + 1) / 8; }
+
+    /** Mix the hash, std::hash of integers being the identity */
+    template<class K>
+    std::size_t hashOf(const K& key) const;
+
+    static Ctrl h2(const std::size_t hash) { return static_cast<Ctrl>(hash & 0x7F); }
+
+    /** Slot of key, or capacity if key isn't in the table */
+    template<class K>
+    std::size_t slotOf(const K& key, const std::size_t hash) const;
+
+    /** Keys other than Key accepted by lookups, when Hash and KeyEqual are transparent. Iterators aren't keys */
+    template<class K>
+    using EnableIfTransparent = typename std::enable_if<detail::IsTransparentFunctor<Hash>::value
+            && detail::IsTransparentFunctor<KeyEqual>::value && !std::is_convertible<const K&, const_iterator>::value,
+        int>::type;
+
+    /** First empty or deleted slot on the probe sequence of hash */
+    std::size_t findFirstNonFull(const std::size_t hash) const;
+
+    /** Slot where a key of hash not in the table can be constructed, growing the table if needed */
+    std::size_t prepareInsert(const std::size_t hash);
+
+    /** Mark slot as holding a pair of hash. The pair must be constructed */
+    void commitInsert(const std::size_t slot, const std::size_t hash);
+
+    /** Set the control byte of slot and its copy after the sentinel */
+    void setCtrl(const std::size_t slot, const Ctrl ctrl);
+
+    /** Empty slot. Destroy its pair and leave a tombstone if a probe may have passed it */
+    void eraseSlot(const std::size_t slot);
+
+    /** Move every pair to a table of capacity slots, dropping the tombstones */
+    void resize(const std::size_t capacity);
+
+    /** Destroy every pair and free the table */
+    void destroy();
+
+    // ──────── C++ API ──────────
+public:
+    FlatHashMap() = default;
+    FlatHashMap(const FlatHashMap& other);
+    FlatHashMap(FlatHashMap&& other) noexcept { swap(other); }
+    FlatHashMap& operator=(FlatHashMap other) noexcept
+    {
+        swap(other);
+        return *this;
+    }
+    ~FlatHashMap() { destroy(); }
+
+    iterator begin() noexcept { return iterator(_ctrl, _slots); }
+    iterator end() noexcept { return iterator(_ctrl + _capacity, _slots + _capacity); }
+    const_iterator begin() const noexcept { return const_iterator(_ctrl, _slots); }
+    const_iterator end() const noexcept { return const_iterator(_ctrl + _capacity, _slots + _capacity); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+
+    bool empty() const noexcept { return _size == 0; }
+    std::size_t size() const noexcept { return _size; }
+    std::size_t max_size() const noexcept { return std::size_t(-1) / 2 / sizeof(value_type); }
+
+    /** \brief Count of slots. The table grow when 7/8 of them are used */
+    std::size_t capacity() const noexcept { return _capacity; }
+
+    /** \brief Allocate room for count pairs, so that inserting them never grow the table */
+    void reserve(const std::size_t count);
+
+    /** \brief Destroy every pair, the table is kept */
+    void clear() noexcept;
+
+    void swap(FlatHashMap& other) noexcept;
+
+    /** \brief Insert value if its key isn't in the map */
+    std::pair<iterator, bool> insert(const value_type& value) { return try_emplace(value.first, value.second); }
+
+    /** \brief Insert value if its key isn't in the map. A std::pair<Key, Value> is moved, key included */
+    template<class Pair, class = typename std::enable_if<std::is_constructible<value_type, Pair&&>::value>::type>
+    std::pair<iterator, bool> insert(Pair&& value);
+
+    /** \brief Same as insert(value), a table has no use of hint */
+    iterator insert(const_iterator, const value_type& value) { return insert(value).first; }
+
+    /** \brief Construct the pair from args, kept only if its key isn't in the map */
+    template<class... Args>
+    std::pair<iterator, bool> emplace(Args&&... args);
+
+    /** \brief Construct Value from args only if key isn't in the map */
+    template<class K, class... Args>
+    std::pair<iterator, bool> try_emplace(K&& key, Args&&... args);
+
+    /** \brief Same as try_emplace(key, args), a table has no use of hint */
+    template<class K, class... Args>
+    iterator try_emplace(const_iterator, K&& key, Args&&... args)
+    {
+        return try_emplace(std::forward<K>(key), std::forward<Args>(args)...).first;
+    }
+
+    /** \brief Erase the pair at pos. \return Iterator following pos */
+    iterator erase(const_iterator pos);
+    iterator erase(iterator pos) { return erase(const_iterator(pos)); }
+
+    /** \brief Erase the pair of key. \return Count of erased pairs, 0 or 1 */
+    std::size_t erase(const Key& key);
+
+    iterator find(const Key& key);
+    const_iterator find(const Key& key) const;
+
+    bool contains(const Key& key) const { return slotOf(key, hashOf(key)) != _capacity; }
+    std::size_t count(const Key& key) const { return contains(key) ? 1 : 0; }
+
+    /** \brief Erase the pair whose key compare equal to key, without building a Key. \return Count of erased pairs, 0 or 1 */
+    template<class K, EnableIfTransparent<K> = 0>
+    std::size_t erase(const K& key)
+    {
+        const auto slot = slotOf(key, hashOf(key));
+        if(slot == _capacity)
+            return 0;
+        eraseSlot(slot);
+        return 1;
+    }
+
+    /** \brief Find the pair whose key compare equal to key, without building a Key */
+    template<class K, EnableIfTransparent<K> = 0>
+    iterator find(const K& key)
+    {
+        const auto slot = slotOf(key, hashOf(key));
+        return iterator(_ctrl + slot, _slots + slot);
+    }
+    template<class K, EnableIfTransparent<K> = 0>
+    const_iterator find(const K& key) const
+    {
+        const auto slot = slotOf(key, hashOf(key));
+        return const_iterator(_ctrl + slot, _slots + slot);
+    }
+
+    template<class K, EnableIfTransparent<K> = 0>
+    bool contains(const K& key) const
+    {
+        return slotOf(key, hashOf(key)) != _capacity;
+    }
+    template<class K, EnableIfTransparent<K> = 0>
+    std::size_t count(const K& key) const
+    {
+        return contains(key) ? 1 : 0;
+    }
+};
+
+template<class Key, class Value, class Hash, class KeyEqual>
+constexpr std::size_t FlatHashMap<Key, Value, Hash, KeyEqual>::WIDTH;
+
+template<class Key, class Value, class Hash, class KeyEqual>
+const detail::Ctrl* FlatHashMap<Key, Value, Hash, KeyEqual>::emptyCtrl()
+{
+    alignas(16) static const Ctrl ctrl[16] = {detail::CTRL_SENTINEL, detail::CTRL_EMPTY, detail::CTRL_EMPTY,
+        detail::CTRL_EMPTY, detail::CTRL_EMPTY, detail::CTRL_EMPTY, detail::CTRL_EMPTY, detail::CTRL_EMPTY,
+        detail::CTRL_EMPTY, detail::CTRL_EMPTY, detail::CTRL_EMPTY, detail::CTRL_EMPTY, detail::CTRL_EMPTY,
+        detail::CTRL_EMPTY, detail::CTRL_EMPTY, detail::CTRL_EMPTY};
+    return ctrl;
+}
+
+template<class Key, class Value, class Hash, class KeyEqual>
+FlatHashMap<Key, Value, Hash, KeyEqual>::FlatHashMap(const FlatHashMap& other) :
+    _hash(other._hash), _equal(other._equal)
+{
+    reserve(other.size());
+    for(const auto& value: other) insert(value);
+}
+
+template<class Key, class Value, class Hash, class KeyEqual>
+template<class K>
+std::size_t FlatHashMap<Key, Value, Hash, KeyEqual>::hashOf(const K& key) const
+{
+    const auto hash = static_cast<std::uint64_t>(_hash(key)) * 0x9E3779B97F4A7C15ull;
+    return static_cast<std::size_t>(hash ^ (hash >> 32));
+}
+
+template<class Key, class Value, class Hash, class KeyEqual>
+template<class K>
+std::size_t FlatHashMap<Key, Value, Hash, KeyEqual>::slotOf(const K& key, const std::size_t hash) const
+{
+    // ) An empty table probe its single group of empty control bytes
+    auto offset = (hash >> 7) & _capacity;
+    for(std::size_t index = WIDTH;; index += WIDTH)
+    {
+        const Group group(_ctrl + offset);
+        for(auto match = group.match(h2(hash)); match; ++match)
+        {
+            const auto slot = (offset + match.lowest()) & _capacity;
+            if(_equal(_slots[slot].first, key))
+                return slot;
+        }
+        if(group.matchEmpty())
+            return _capacity;
+        offset = (offset + index) & _capacity;
+    }
+}
+
+template<class Key, class Value, class Hash, class KeyEqual>
+std::size_t FlatHashMap<Key, Value, Hash, KeyEqual>::findFirstNonFull(const std::size_t hash) const
+{
+    auto offset = (hash >> 7) & _capacity;
+    for(std::size_t index = WIDTH;; index += WIDTH)
+    {
+        const auto free = Group(_ctrl + offset).matchEmptyOrDeleted();
+        if(free)
+            return (offset + free.lowest()) & _capacity;
+        offset = (offset + index) & _capacity;
+    }
+}
+
+template<class Key, class Value, class Hash, class KeyEqual>
+std::size_t FlatHashMap<Key, Value, Hash, KeyEqual>::prepareInsert(const std::size_t hash)
+{
+    auto slot = _capacity ? findFirstNonFull(hash) : 0;
+
+    // ) A tombstone can always be reused, an empty slot only while the load factor allow it
+    if(!_capacity || (_growthLeft == 0 && _ctrl[slot] != detail::CTRL_DELETED))
+    {
+        // ) Many tombstones: the same capacity is enough once they are dropped
+        if(_capacity > WIDTH && _size * 32 <= _capacity * 25)
+            resize(_capacity);
+        else
+            resize(_capacity ? 2 * _capacity + 1 : WIDTH - 1);
+        slot = findFirstNonFull(hash);
+    }
+    return slot;
+}
+
+template<class Key, class Value, class Hash, class KeyEqual>
+void FlatHashMap<Key, Value, Hash, KeyEqual>::commitInsert(const std::size_t slot, const std::size_t hash)
+{
+    if(_ctrl[slot] == detail::CTRL_EMPTY)
+        --_growthLeft;
+    setCtrl(slot, h2(hash));
+    ++_size;
+}
+
+template<class Key, class Value, class Hash, class KeyEqual>
+void FlatHashMap<Key, Value, Hash, KeyEqual>::setCtrl(const std::size_t slot, const Ctrl ctrl)
+{
+    _ctrl[slot] = ctrl;
+    _ctrl[((slot - (WIDTH - 1)) & _capacity) + ((WIDTH - 1) & _capacity)] = ctrl;
+}
+
+template<class Key, class Value, class Hash, class KeyEqual>
+void FlatHashMap<Key, Value, Hash, KeyEqual>::eraseSlot(const std::size_t slot)
+{
+    _slots[slot].~value_type();
+    --_size;
+
+    // ) If every group holding slot has an empty slot closer than WIDTH, no probe ever went past slot
+    const auto emptyAfter = Group(_ctrl + slot).matchEmpty();
+    const auto emptyBefore = Group(_ctrl + ((slot - WIDTH) & _capacity)).matchEmpty();
+    const bool wasNeverFull =
+        emptyBefore && emptyAfter && emptyAfter.trailingZeros() + emptyBefore.leadingZeros(WIDTH) < WIDTH;
+    setCtrl(slot, wasNeverFull ? detail::CTRL_EMPTY : detail::CTRL_DELETED);
+    if(wasNeverFull)
+        ++_growthLeft;
+}
+
+template<class Key, class Value, class Hash, class KeyEqual>
+void FlatHashMap<Key, Value, Hash, KeyEqual>::resize(const std::size_t capacity)
+{
+    auto* const oldCtrl = _ctrl;
+    auto* const oldSlots = _slots;
+    const auto oldCapacity = _capacity;
+
+    _ctrl = new Ctrl[capacity + WIDTH];
+    std::memset(_ctrl, static_cast<unsigned char>(detail::CTRL_EMPTY), capacity + WIDTH);
+    _ctrl[capacity] = detail::CTRL_SENTINEL;
+    _slots = std::allocator<value_type>().allocate(capacity);
+    _capacity = capacity;
+    _growthLeft = growthOf(capacity) - _size;
+
+    for(std::size_t slot = 0; slot < oldCapacity; ++slot)
+    {
+        if(!detail::isCtrlFull(oldCtrl[slot]))
+            continue;
+        const auto hash = hashOf(oldSlots[slot].first);
+        const auto target = findFirstNonFull(hash);
+        new(_slots + target) value_type(std::move(oldSlots[slot]));
+        oldSlots[slot].~value_type();
+        setCtrl(target, h2(hash));
+    }
+
+    if(oldCapacity)
+    {
+        delete[] oldCtrl;
+        std::allocator<value_type>().deallocate(oldSlots, oldCapacity);
+    }
+}
+
+template<class Key, class Value, class Hash, class KeyEqual>
+void FlatHashMap<Key, Value, Hash, KeyEqual>::destroy()
+{
+    if(!_capacity)
+        return;
+    clear();
+    delete[] _ctrl;
+    std::allocator<value_type>().deallocate(_slots, _capacity);
+    _ctrl = const_cast<Ctrl*>(emptyCtrl());
+    _slots = nullptr;
+    _capacity = 0;
+    _growthLeft = 0;
+}
+
+template<class Key, class Value, class Hash, class KeyEqual>
+void FlatHashMap<Key, Value, Hash, KeyEqual>::reserve(const std::size_t count)
+{
+    auto capacity = WIDTH - 1;
+    while(growthOf(capacity) < count) capacity = 2 * capacity + 1;
+    if(capacity > _capacity)
+        resize(capacity);
+}
+
+template<class Key, class Value, class Hash, class KeyEqual>
+void FlatHashMap<Key, Value, Hash, KeyEqual>::clear() noexcept
+{
+    if(!_capacity)
+        return;
+    for(std::size_t slot = 0; slot < _capacity; ++slot)
+    {
+        if(detail::isCtrlFull(_ctrl[slot]))
+            _slots[slot].~value_type();
+    }
+    std::memset(_ctrl, static_cast<unsigned char>(detail::CTRL_EMPTY), _capacity + WIDTH);
+    _ctrl[_capacity] = detail::CTRL_SENTINEL;
+    _size = 0;
+    _growthLeft = growthOf(_capacity);
+}
+
+template<class Key, class Value, class Hash, class KeyEqual>
+void FlatHashMap<Key, Value, Hash, KeyEqual>::swap(FlatHashMap& other) noexcept
+{
+    using std::swap;
+    swap(_ctrl, other._ctrl);
+    swap(_slots, other._slots);
+    swap(_capacity, other._capacity);
+    swap(_size, other._size);
+    swap(_growthLeft, other._growthLeft);
+    swap(_hash, other._hash);
+    swap(_equal, other._equal);
+}
+
+template<class Key, class Value, class Hash, class KeyEqual>
+template<class Pair, class>
+std::pair<typename FlatHashMap<Key, Value, Hash, KeyEqual>::iterator, bool> FlatHashMap<Key, Value, Hash, KeyEqual>::insert(
+    Pair&& value)
+{
+    const auto hash = hashOf(value.first);
+    auto slot = slotOf(value.first, hash);
+    if(slot != _capacity)
+        return {iterator(_ctrl + slot, _slots + slot), false};
+
+    slot = prepareInsert(hash);
+    new(_slots + slot) value_type(std::forward<Pair>(value));
+    commitInsert(slot, hash);
+    return {iterator(_ctrl + slot, _slots + slot), true};
+}
+
+template<class Key, class Value, class Hash, class KeyEqual>
+template<class... Args>
+std::pair<typename FlatHashMap<Key, Value, Hash, KeyEqual>::iterator, bool> FlatHashMap<Key, Value, Hash, KeyEqual>::emplace(
+    Args&&... args)
+{
+    // ) The key is only known once the pair is built
+    std::pair<Key, Value> value(std::forward<Args>(args)...);
+    return insert(std::move(value));
+}
+
+template<class Key, class Value, class Hash, class KeyEqual>
+template<class K, class... Args>
+std::pair<typename FlatHashMap<Key, Value, Hash, KeyEqual>::iterator, bool>
+FlatHashMap<Key, Value, Hash, KeyEqual>::try_emplace(K&& key, Args&&... args)
+{
+    const auto hash = hashOf(key);
+    auto slot = slotOf(key, hash);
+    if(slot != _capacity)
+        return {iterator(_ctrl + slot, _slots + slot), false};
+
+    slot = prepareInsert(hash);
+    new(_slots + slot) value_type(std::piecewise_construct, std::forward_as_tuple(std::forward<K>(key)),
+        std::forward_as_tuple(std::forward<Args>(args)...));
+    commitInsert(slot, hash);
+    return {iterator(_ctrl + slot, _slots + slot), true};
+}
+
+template<class Key, class Value, class Hash, class KeyEqual>
+typename FlatHashMap<Key, Value, Hash, KeyEqual>::iterator FlatHashMap<Key, Value, Hash, KeyEqual>::erase(
+    const_iterator pos)
+{
+    const auto slot = static_cast<std::size_t>(pos._slot - _slots);
+    if(slot >= _capacity)
+        return end();
+    eraseSlot(slot);
+    return iterator(_ctrl + slot, _slots + slot);
+}
+
+template<class Key, class Value, class Hash, class KeyEqual>
+std::size_t FlatHashMap<Key, Value, Hash, KeyEqual>::erase(const Key& key)
+{
+    const auto slot = slotOf(key, hashOf(key));
+    if(slot == _capacity)
+        return 0;
+    eraseSlot(slot);
+    return 1;
+}
+
+template<class Key, class Value, class Hash, class KeyEqual>
+typename FlatHashMap<Key, Value, Hash, KeyEqual>::iterator FlatHashMap<Key, Value, Hash, KeyEqual>::find(
+    const Key& key)
+{
+    const auto slot = slotOf(key, hashOf(key));
+    return iterator(_ctrl + slot, _slots + slot);
+}
+
+template<class Key, class Value, class Hash, class KeyEqual>
+typename FlatHashMap<Key, Value, Hash, KeyEqual>::const_iterator FlatHashMap<Key, Value, Hash, KeyEqual>::find(
+    const Key& key) const
+{
+    const auto slot = slotOf(key, hashOf(key));
+    return const_iterator(_ctrl + slot, _slots + slot);
+}
+
+}
+
+#endif
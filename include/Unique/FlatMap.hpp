@@ -0,0 +1,131 @@
+#ifndef __UNIQUE_FLAT_MAP_HPP__
+#define __UNIQUE_FLAT_MAP_HPP__
+
+// ─────────────────────────────────────────────────────────────
+//                  INCLUDE
+// ─────────────────────────────────────────────────────────────
+
+#include <Unique/SortedVectorMap.hpp>
+#include <Unique/TMap.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+// ─────────────────────────────────────────────────────────────
+//                  DECLARATION
+// ─────────────────────────────────────────────────────────────
+
+namespace unique {
+
+// ─────────────────────────────────────────────────────────────
+//                  CLASS
+// ─────────────────────────────────────────────────────────────
+
+/**
+ * Map on two SortedVectorMap, for read mostly maps built once: both sides are sorted contiguous
+ * arrays, searched with a branchless binary search and iterated without pointer chasing.
+ * Single inserts and erases shift the arrays. Build the map from a range, or insert batches with
+ * insert(first, last), that sort the batch once per side and merge it in each array.
+ */
+template<class Key1, class Key2>
+class FlatMap : public TMap<SortedVectorMap, SortedVectorMap, Key1, Key2>
+{
+    using Base = TMap<SortedVectorMap, SortedVectorMap, Key1, Key2>;
+
+public:
+    FlatMap() = default;
+
+    /** \brief Build the map from a range of (Key1, Key2) pairs, in O(n log n). See insert(first, last) */
+    template<class InputIt>
+    FlatMap(InputIt first, InputIt last)
+    {
+        insert(first, last);
+    }
+
+    using Base::insert;
+
+    /**
+     * \brief Insert a batch of (Key1, Key2) pairs in O(count log count + n).
+     * Pairs are taken in batch order like single inserts: a pair whose Key1 or Key2 is already in the map,
+     * or used by an earlier inserted pair of the batch, is skipped.
+     * \return Count of inserted pairs
+     */
+    template<class InputIt>
+    std::size_t insert(InputIt first, InputIt last);
+
+    /** \brief Allocate room for count pairs in both arrays */
+    void reserve(const std::size_t count)
+    {
+        this->mutableKey1Map().reserve(count);
+        this->mutableKey2Map().reserve(count);
+    }
+};
+
+template<class Key1, class Key2>
+template<class InputIt>
+std::size_t FlatMap<Key1, Key2>::insert(InputIt first, InputIt last)
+{
+    std::vector<std::pair<Key1, Key2>> batch;
+    for(; first != last; ++first) batch.emplace_back(first->first, first->second);
+
+    auto& key1Map = this->mutableKey1Map();
+    auto& key2Map = this->mutableKey2Map();
+    const auto less1 = key1Map.key_comp();
+    const auto less2 = key2Map.key_comp();
+
+    // ) Stable sorts keep batch order between equal keys
+    std::vector<std::size_t> byKey1(batch.size());
+    for(std::size_t i = 0; i < byKey1.size(); ++i) byKey1[i] = i;
+    std::vector<std::size_t> byKey2 = byKey1;
+    std::stable_sort(byKey1.begin(), byKey1.end(),
+        [&](const std::size_t a, const std::size_t b) { return less1(batch[a].first, batch[b].first); });
+    std::stable_sort(byKey2.begin(), byKey2.end(),
+        [&](const std::size_t a, const std::size_t b) { return less2(batch[a].second, batch[b].second); });
+
+    // ) Number the groups of equal keys on each side
+    std::vector<std::size_t> group1(batch.size());
+    std::vector<std::size_t> group2(batch.size());
+    for(std::size_t i = 1; i < byKey1.size(); ++i)
+    {
+        group1[byKey1[i]] = group1[byKey1[i - 1]] + (less1(batch[byKey1[i - 1]].first, batch[byKey1[i]].first) ? 1 : 0);
+        group2[byKey2[i]] = group2[byKey2[i - 1]] + (less2(batch[byKey2[i - 1]].second, batch[byKey2[i]].second) ? 1 : 0);
+    }
+
+    // ) Resolve clashes in batch order, like single inserts: a pair is only skipped for a pair kept before it
+    std::vector<bool> keep(batch.size(), false);
+    std::vector<bool> used1(batch.size(), false);
+    std::vector<bool> used2(batch.size(), false);
+    for(std::size_t i = 0; i < batch.size(); ++i)
+    {
+        if(used1[group1[i]] || used2[group2[i]])
+            continue;
+        if(!this->empty() && (key1Map.contains(batch[i].first) || key2Map.contains(batch[i].second)))
+            continue;
+        keep[i] = true;
+        used1[group1[i]] = true;
+        used2[group2[i]] = true;
+    }
+
+    // ) Each side receive the kept pairs in its own order, then merge them in place
+    std::vector<std::pair<Key1, Key2>> sorted1;
+    std::vector<std::pair<Key2, Key1>> sorted2;
+    for(const auto i: byKey1)
+    {
+        if(keep[i])
+            sorted1.emplace_back(batch[i].first, batch[i].second);
+    }
+    for(const auto i: byKey2)
+    {
+        if(keep[i])
+            sorted2.emplace_back(std::move(batch[i].second), std::move(batch[i].first));
+    }
+    key1Map.mergeSortedUnique(std::make_move_iterator(sorted1.begin()), std::make_move_iterator(sorted1.end()));
+    key2Map.mergeSortedUnique(std::make_move_iterator(sorted2.begin()), std::make_move_iterator(sorted2.end()));
+    return sorted1.size();
+}
+
+}
+
+#endif
@@ -0,0 +1,74 @@
+#ifndef __UNIQUE_FLAT_UNORDERED_MAP_HPP__
+#define __UNIQUE_FLAT_UNORDERED_MAP_HPP__
+
+// ─────────────────────────────────────────────────────────────
+//                  INCLUDE
+// ─────────────────────────────────────────────────────────────
+
+#include <Unique/FlatHashMap.hpp>
+#include <Unique/TMap.hpp>
+#include <Unique/TransparentKey.hpp>
+
+#include <cstddef>
+
+// ─────────────────────────────────────────────────────────────
+//                  DECLARATION
+// ─────────────────────────────────────────────────────────────
+
+namespace unique {
+
+// ─────────────────────────────────────────────────────────────
+//                  CLASS
+// ─────────────────────────────────────────────────────────────
+
+namespace detail {
+
+/** FlatHashMap with transparent hash and equal */
+template<class Key, class Value, class...>
+using TransparentFlatHashMap = FlatHashMap<Key, Value, TransparentHash, TransparentEqual>;
+
+/** TMap on two flat hash maps, with the reserve of the tables */
+template<template<class, class, class...> class HashMap, class Key1, class Key2>
+class TFlatUnorderedMap : public TMap<HashMap, HashMap, Key1, Key2>
+{
+public:
+    /** \brief Allocate room for count pairs in both tables, so that inserting them never grow the tables */
+    void reserve(const std::size_t count)
+    {
+        this->mutableKey1Map().reserve(count);
+        this->mutableKey2Map().reserve(count);
+    }
+
+    /** \brief Count of pairs that fit before the tables grow */
+    std::size_t capacity() const
+    {
+        const auto capacity = this->key1Map().capacity();
+        return capacity - (capacity + 1) / 8;
+    }
+};
+
+}
+
+/**
+ * UnorderedMap on two FlatHashMap: pairs are stored inline in the tables instead of a heap node
+ * per pair and per side, and lookups compare a group of hashes with SIMD before reading any key.
+ * Iterators are invalidated when a table grow, call reserve before bulk inserts.
+ */
+template<class Key1, class Key2>
+class FlatUnorderedMap : public detail::TFlatUnorderedMap<FlatHashMap, Key1, Key2>
+{
+};
+
+/**
+ * FlatUnorderedMap with TransparentHash and TransparentEqual: find, contains and erase accept lookup keys
+ * without building a key, std::string_view for std::string keys and raw pointers for smart pointer keys.
+ * It is the unordered TransparentMap: std::unordered_map only has heterogeneous lookup since C++20,
+ * FlatHashMap has it in C++17. See KeyLookup
+ */
+template<class Key1, class Key2>
+class TransparentUnorderedMap : public detail::TFlatUnorderedMap<detail::TransparentFlatHashMap, Key1, Key2>
+{
+};
+}
+
+#endif
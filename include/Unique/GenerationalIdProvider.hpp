@@ -0,0 +1,168 @@
+#ifndef __UNIQUE_GENERATIONAL_ID_PROVIDER_HPP__
+#define __UNIQUE_GENERATIONAL_ID_PROVIDER_HPP__
+
+// ─────────────────────────────────────────────────────────────
+//                  INCLUDE
+// ─────────────────────────────────────────────────────────────
+
+#include <Unique/IdProvider.hpp>
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+// ─────────────────────────────────────────────────────────────
+//                  DECLARATION
+// ─────────────────────────────────────────────────────────────
+
+namespace unique {
+
+// ─────────────────────────────────────────────────────────────
+//                  CLASS
+// ─────────────────────────────────────────────────────────────
+
+/**
+ * Pack a slot index and a generation counter in a single integer handle.
+ * The index use the low IndexBits bits, the generation the remaining high bits.
+ * Generations of live slots are odd and freed slots even, so the handle 0 is never valid.
+ */
+template<typename Handle, unsigned IndexBits>
+struct GenerationalHandle
+{
+    static_assert(std::is_unsigned<Handle>::value, "Handle should be an unsigned integer");
+    static_assert(IndexBits > 0 && IndexBits < std::numeric_limits<Handle>::digits,
+        "IndexBits should leave room for the generation");
+
+    using Type = Handle;
+
+    static constexpr Handle INDEX_MASK = static_cast<Handle>((Handle(1) << IndexBits) - 1);
+    static constexpr Handle GENERATION_MASK = static_cast<Handle>(Handle(~Handle(0)) >> IndexBits);
+    /** Exclusive upper bound of slot indexes */
+    static constexpr Handle MAX_INDEX = INDEX_MASK;
+    static constexpr Handle INVALID = 0;
+
+    static constexpr Handle make(const Handle index, const Handle generation)
+    {
+        return static_cast<Handle>((generation << IndexBits) | (index & INDEX_MASK));
+    }
+    static constexpr Handle indexOf(const Handle handle) { return handle & INDEX_MASK; }
+    static constexpr Handle generationOf(const Handle handle)
+    {
+        return static_cast<Handle>(handle >> IndexBits);
+    }
+    /** Generation that follow generation, wrapping in the bits left by the index */
+    static constexpr Handle nextGeneration(const Handle generation)
+    {
+        return static_cast<Handle>((generation + 1) & GENERATION_MASK);
+    }
+};
+
+template<typename Handle, unsigned IndexBits>
+constexpr Handle GenerationalHandle<Handle, IndexBits>::INDEX_MASK;
+template<typename Handle, unsigned IndexBits>
+constexpr Handle GenerationalHandle<Handle, IndexBits>::GENERATION_MASK;
+template<typename Handle, unsigned IndexBits>
+constexpr Handle GenerationalHandle<Handle, IndexBits>::MAX_INDEX;
+template<typename Handle, unsigned IndexBits>
+constexpr Handle GenerationalHandle<Handle, IndexBits>::INVALID;
+
+/**
+ * Hand out generational handles: a slot index given by an IdProvider, packed with the generation
+ * of the slot. Releasing a handle bump the slot generation, so stale handles of a reused slot are
+ * detected with a single array load and compare instead of a lookup in a map.
+ * Generations wrap after 2^(bits - IndexBits - 1) reuses of the same slot.
+ */
+template<typename Handle = std::uint64_t, unsigned IndexBits = 32,
+    template<typename> class Storage = IntervalIdStorage>
+class GenerationalIdProvider
+{
+public:
+    using Handles = GenerationalHandle<Handle, IndexBits>;
+    using Type = Handle;
+    using IndexProvider = IdProvider<Handle, 0, Handles::MAX_INDEX, Storage>;
+
+private:
+    IndexProvider _indexes;
+    /** Generation of each slot ever used. Odd when the slot is taken */
+    std::vector<Handle> _generations;
+
+    // ──────── C++ API ──────────
+public:
+    /** \brief Take the lowest free slot and return its handle */
+    Handle takeNextId();
+
+    /**
+     * \brief Release a handle. Every copy of the handle become invalid
+     * \return false if the handle was already invalid
+     */
+    bool releaseId(const Handle handle);
+
+    /** \brief Get if handle is the current handle of a taken slot. One load and one compare */
+    bool isValid(const Handle handle) const
+    {
+        const auto index = Handles::indexOf(handle);
+        const auto generation = Handles::generationOf(handle);
+        return (generation & 1) && index < _generations.size() && _generations[index] == generation;
+    }
+
+    /** \brief Slot index of handle, to index dense arrays */
+    static Handle indexOf(const Handle handle) { return Handles::indexOf(handle); }
+
+    /** \brief Generation of handle */
+    static Handle generationOf(const Handle handle) { return Handles::generationOf(handle); }
+
+    /** \brief Get the count of taken handles */
+    std::size_t countOfTakenIds() const { return _indexes.countOfTakenIds(); }
+
+    /** \brief Count of slots ever used, the size a dense array indexed by slot need */
+    std::size_t slotCount() const { return _generations.size(); }
+
+    /** \brief Release every handle. Handles given before stay invalid after the slots are reused */
+    void clear();
+};
+
+template<typename Handle, unsigned IndexBits, template<typename> class Storage>
+Handle GenerationalIdProvider<Handle, IndexBits, Storage>::takeNextId()
+{
+    const auto index = _indexes.takeNextId();
+    if(index >= _generations.size())
+        _generations.resize(static_cast<std::size_t>(index) + 1, 0);
+
+    // ) Even to odd: the slot is now taken
+    auto& generation = _generations[index];
+    generation = Handles::nextGeneration(generation);
+    assert(generation & 1);
+    return Handles::make(index, generation);
+}
+
+template<typename Handle, unsigned IndexBits, template<typename> class Storage>
+bool GenerationalIdProvider<Handle, IndexBits, Storage>::releaseId(const Handle handle)
+{
+    if(!isValid(handle))
+        return false;
+
+    // ) Odd to even: every handle on this slot is now stale
+    const auto index = Handles::indexOf(handle);
+    _generations[index] = Handles::nextGeneration(_generations[index]);
+    _indexes.releaseId(index);
+    return true;
+}
+
+template<typename Handle, unsigned IndexBits, template<typename> class Storage>
+void GenerationalIdProvider<Handle, IndexBits, Storage>::clear()
+{
+    // ) Generations are kept so that old handles never become valid again
+    for(auto& generation: _generations)
+    {
+        if(generation & 1)
+            generation = Handles::nextGeneration(generation);
+    }
+    _indexes.clear();
+}
+
+}
+
+#endif
@@ -0,0 +1,312 @@
+#ifndef __UNIQUE_HI_LO_ID_PROVIDER_HPP__
+#define __UNIQUE_HI_LO_ID_PROVIDER_HPP__
+
+// ─────────────────────────────────────────────────────────────
+//                  INCLUDE
+// ─────────────────────────────────────────────────────────────
+
+#include <Unique/IntervalIdStorage.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <future>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+// ─────────────────────────────────────────────────────────────
+//                  DECLARATION
+// ─────────────────────────────────────────────────────────────
+
+namespace unique {
+
+// ─────────────────────────────────────────────────────────────
+//                  CLASS
+// ─────────────────────────────────────────────────────────────
+
+/** Range of ids [first, last) leased by a coordinator to a node */
+template<typename T>
+struct IdBlock
+{
+    T first = T();
+    T last = T();
+
+    bool empty() const { return !(first < last); }
+    std::size_t size() const { return empty() ? 0 : static_cast<std::size_t>(last - first); }
+};
+
+/**
+ * In process coordinator of HiLoIdProvider, a stand-in for a remote allocator in tests and single
+ * process deployments. Blocks are taken from a Provider behind a mutex, a single lock per block.
+ *
+ * A coordinator must be callable from any thread and provide:
+ * - Type
+ * - IdBlock<Type> leaseBlock(std::size_t count): up to count consecutive ids, an empty block once
+ *   every id is leased
+ * - void returnRange(Type first, Type last): give back ids of leased blocks that were never used
+ */
+template<class Provider>
+class LocalBlockCoordinator
+{
+public:
+    using ProviderType = Provider;
+    using Type = typename Provider::Type;
+
+    /** \param args Forwarded to the Provider constructor, for example the bounds of a DynamicIdProvider */
+    template<class... Args>
+    explicit LocalBlockCoordinator(Args&&... args) : _provider(std::forward<Args>(args)...)
+    {
+    }
+
+private:
+    Provider _provider;
+    mutable std::mutex _mutex;
+    std::size_t _leaseCount = 0;
+
+    // ──────── C++ API ──────────
+public:
+    /**
+     * \brief Lease count consecutive ids, reusing returned ranges first.
+     * Near MAX, or when only holes are left, the block can be smaller than count
+     * \return Empty block if every id is leased
+     */
+    IdBlock<Type> leaseBlock(const std::size_t count);
+
+    /** \brief Give back the unused ids [first, last) of leased blocks */
+    void returnRange(const Type first, const Type last);
+
+    /** \brief Count of calls to leaseBlock that returned ids, the round-trips a remote coordinator would pay */
+    std::size_t countOfLeases() const;
+
+    /** \brief Count of ids held by nodes */
+    std::size_t countOfLeasedIds() const;
+};
+
+/**
+ * Two tier id allocator: a coordinator lease blocks of blockSize consecutive ids to each node, and the
+ * node hand out the ids of its blocks locally. The coordinator is reached once per block instead of
+ * once per id.
+ *
+ * When the ids left in the node drop to the prefetch threshold, the next block is leased on another
+ * thread with std::async, so that takeNextId only wait for the coordinator if the whole block is used
+ * before the prefetch come back. Ids left in the node, released ones included, are kept in a Storage
+ * and handed out lowest first. drain() return them to the coordinator, the destructor call it.
+ *
+ * A HiLoIdProvider isn't thread safe: each node or thread own its own, only the coordinator is shared.
+ * Ids aren't ordered between nodes, and ids released by a node are only reused by that node until it
+ * is drained.
+ */
+template<class Coordinator, template<typename> class Storage = IntervalIdStorage>
+class HiLoIdProvider
+{
+public:
+    using CoordinatorType = Coordinator;
+    using Type = typename Coordinator::Type;
+    using Block = IdBlock<Type>;
+
+    static constexpr std::size_t DEFAULT_BLOCK_SIZE = 1024;
+
+    /**
+     * \param coordinator Coordinator leasing the blocks, must outlive the provider
+     * \param blockSize Count of ids leased at once
+     * \param prefetchThreshold Count of ids left that trigger the prefetch of the next block.
+     * Default to blockSize / 4
+     */
+    explicit HiLoIdProvider(Coordinator& coordinator, const std::size_t blockSize = DEFAULT_BLOCK_SIZE,
+        const std::size_t prefetchThreshold = 0) :
+        _coordinator(coordinator),
+        _blockSize(blockSize ? blockSize : 1),
+        _prefetchThreshold(prefetchThreshold ? prefetchThreshold : _blockSize / 4),
+        _available(Type())
+    {
+    }
+
+    HiLoIdProvider(const HiLoIdProvider&) = delete;
+    HiLoIdProvider& operator=(const HiLoIdProvider&) = delete;
+
+    ~HiLoIdProvider() { drain(); }
+
+private:
+    Coordinator& _coordinator;
+    const std::size_t _blockSize;
+    const std::size_t _prefetchThreshold;
+    /** Ids of the leased blocks not handed out */
+    Storage<Type> _available;
+    /** Block being leased in the background, if any */
+    std::future<Block> _prefetch;
+    /** Set when the coordinator ran out of ids, so that no more prefetch are started */
+    bool _exhausted = false;
+    std::size_t _takenIdCount = 0;
+
+private:
+    /** Add a leased block to the available ids */
+    void add(const Block& block);
+
+    /** Add the prefetched block if it is ready, or wait for it */
+    void collect(const bool wait);
+
+    /** Start leasing the next block in the background */
+    void prefetch();
+
+    // ──────── C++ API ──────────
+public:
+    /** \brief Coordinator leasing the blocks */
+    Coordinator& coordinator() const { return _coordinator; }
+
+    /** \brief Count of ids leased at once */
+    std::size_t blockSize() const { return _blockSize; }
+
+    /**
+     * \brief Take the next id of the leased blocks, leasing a block if none is left.
+     * \return Nothing if the coordinator ran out of ids
+     */
+    std::optional<Type> tryTakeNextId();
+
+    /** \brief Take the next id. The function assert if the coordinator ran out of ids */
+    Type takeNextId();
+
+    /** \brief Release an id taken from this provider. It is kept to be handed out again */
+    void releaseId(const Type id);
+
+    /** \brief Count of ids handed out by this provider and not released */
+    std::size_t countOfTakenIds() const { return _takenIdCount; }
+
+    /** \brief Count of leased ids that can be handed out without reaching the coordinator */
+    std::size_t countOfAvailableIds() const { return _available.size(); }
+
+    /** \brief Get if a block is being leased in the background */
+    bool isPrefetching() const { return _prefetch.valid(); }
+
+    /** \brief Wait for the prefetch in flight, then return every id not handed out to the coordinator */
+    void drain();
+};
+
+template<class Provider>
+IdBlock<typename LocalBlockCoordinator<Provider>::Type> LocalBlockCoordinator<Provider>::leaseBlock(
+    const std::size_t count)
+{
+    assert(count > 0);
+    std::lock_guard<std::mutex> lock(_mutex);
+    if(!_provider.areIdsAvailables())
+        return {};
+    ++_leaseCount;
+
+    // ) A returned range or the counter is used at once when it is big enough
+    const auto room = static_cast<std::size_t>(_provider.MAX - _provider.getNextEndId());
+    if(count <= room)
+    {
+        const auto first = _provider.takeContiguousRange(count);
+        return {first, static_cast<Type>(first + static_cast<Type>(count))};
+    }
+
+    // ) Otherwise the block grow from the lowest available id as long as ids are consecutive
+    IdBlock<Type> block;
+    block.first = _provider.takeNextId();
+    block.last = static_cast<Type>(block.first + 1);
+    while(block.size() < count && block.last < _provider.MAX && _provider.takeId(block.last)) ++block.last;
+    return block;
+}
+
+template<class Provider>
+void LocalBlockCoordinator<Provider>::returnRange(const Type first, const Type last)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _provider.releaseIdRange(first, last);
+}
+
+template<class Provider>
+std::size_t LocalBlockCoordinator<Provider>::countOfLeases() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _leaseCount;
+}
+
+template<class Provider>
+std::size_t LocalBlockCoordinator<Provider>::countOfLeasedIds() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _provider.countOfTakenIds();
+}
+
+template<class Coordinator, template<typename> class Storage>
+constexpr std::size_t HiLoIdProvider<Coordinator, Storage>::DEFAULT_BLOCK_SIZE;
+
+template<class Coordinator, template<typename> class Storage>
+void HiLoIdProvider<Coordinator, Storage>::add(const Block& block)
+{
+    _exhausted = block.empty();
+    if(!_exhausted)
+        _available.insertRange(block.first, block.last);
+}
+
+template<class Coordinator, template<typename> class Storage>
+void HiLoIdProvider<Coordinator, Storage>::collect(const bool wait)
+{
+    if(!_prefetch.valid())
+        return;
+    if(!wait && _prefetch.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+        return;
+    add(_prefetch.get());
+}
+
+template<class Coordinator, template<typename> class Storage>
+void HiLoIdProvider<Coordinator, Storage>::prefetch()
+{
+    if(_prefetch.valid() || _exhausted)
+        return;
+    auto& coordinator = _coordinator;
+    const auto count = _blockSize;
+    _prefetch = std::async(std::launch::async, [&coordinator, count] { return coordinator.leaseBlock(count); });
+}
+
+template<class Coordinator, template<typename> class Storage>
+std::optional<typename HiLoIdProvider<Coordinator, Storage>::Type> HiLoIdProvider<Coordinator, Storage>::tryTakeNextId()
+{
+    collect(false);
+    if(_available.empty())
+    {
+        // ) The block was used faster than the prefetch, wait for it or lease one right away
+        if(_prefetch.valid())
+            collect(true);
+        else
+            add(_coordinator.leaseBlock(_blockSize));
+        if(_available.empty())
+            return std::nullopt;
+    }
+
+    const auto id = _available.popFront();
+    ++_takenIdCount;
+    if(_available.size() <= _prefetchThreshold)
+        prefetch();
+    return id;
+}
+
+template<class Coordinator, template<typename> class Storage>
+typename HiLoIdProvider<Coordinator, Storage>::Type HiLoIdProvider<Coordinator, Storage>::takeNextId()
+{
+    const auto id = tryTakeNextId();
+    assert(id.has_value());
+    return id ? *id : Type();
+}
+
+template<class Coordinator, template<typename> class Storage>
+void HiLoIdProvider<Coordinator, Storage>::releaseId(const Type id)
+{
+    assert(_takenIdCount > 0 && !_available.contains(id));
+    _available.insert(id);
+    --_takenIdCount;
+}
+
+template<class Coordinator, template<typename> class Storage>
+void HiLoIdProvider<Coordinator, Storage>::drain()
+{
+    collect(true);
+    _available.forEachRun([this](const Type first, const Type last) { _coordinator.returnRange(first, last); });
+    _available.clear();
+}
+
+}
+
+#endif
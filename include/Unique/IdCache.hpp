@@ -0,0 +1,142 @@
+#ifndef __UNIQUE_ID_CACHE_HPP__
+#define __UNIQUE_ID_CACHE_HPP__
+
+// ─────────────────────────────────────────────────────────────
+//                  INCLUDE
+// ─────────────────────────────────────────────────────────────
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+// ─────────────────────────────────────────────────────────────
+//                  DECLARATION
+// ─────────────────────────────────────────────────────────────
+
+namespace unique {
+
+// ─────────────────────────────────────────────────────────────
+//                  CLASS
+// ─────────────────────────────────────────────────────────────
+
+/**
+ * Per thread front-end of a shared provider (SharedIdProvider or ConcurrentIdProvider), like a
+ * tcmalloc magazine. Ids are taken from the shared provider batchSize at a time, and released ids
+ * are kept locally until more than capacity are cached, then the oldest batchSize are given back.
+ * Most takeNextId/releaseId calls then never touch the shared provider.
+ *
+ * An IdCache isn't thread safe: each thread own its cache, typically in a thread_local variable.
+ * Cached ids are seen as taken by the shared provider until drain() is called.
+ * The destructor drain the cache, so countOfTakenIds() of the shared provider is exact again
+ * once a thread exit.
+ */
+template<class SharedProvider>
+class IdCache
+{
+public:
+    using Type = typename SharedProvider::Type;
+
+    static constexpr std::size_t DEFAULT_BATCH_SIZE = 64;
+
+    /**
+     * \param provider Shared provider, must outlive the cache
+     * \param batchSize Count of ids taken from or given back to the provider at once
+     * \param capacity Maximum count of released ids kept in the cache. Default to 2 * batchSize
+     */
+    explicit IdCache(SharedProvider& provider, const std::size_t batchSize = DEFAULT_BATCH_SIZE,
+        const std::size_t capacity = 0) :
+        _provider(provider),
+        _batchSize(batchSize ? batchSize : 1),
+        _capacity(std::max(capacity ? capacity : 2 * _batchSize, _batchSize))
+    {
+        _ids.reserve(_capacity + 1);
+    }
+
+    IdCache(const IdCache&) = delete;
+    IdCache& operator=(const IdCache&) = delete;
+
+    ~IdCache() { drain(); }
+
+private:
+    SharedProvider& _provider;
+    const std::size_t _batchSize;
+    const std::size_t _capacity;
+    /** Ids owned by the cache. The back is handed out first since it is the hottest */
+    std::vector<Type> _ids;
+
+    // ──────── C++ API ──────────
+public:
+    /** \brief Shared provider used to refill and flush */
+    SharedProvider& provider() const { return _provider; }
+
+    /** \brief Count of ids taken from or given back to the provider at once */
+    std::size_t batchSize() const { return _batchSize; }
+
+    /** \brief Maximum count of released ids kept in the cache */
+    std::size_t capacity() const { return _capacity; }
+
+    /**
+     * \brief Take the next id, refilling the cache with a batch from the provider if it is empty.
+     * Ids aren't handed out lowest first
+     */
+    Type takeNextId();
+
+    /** \brief Release an id taken from this cache or from the provider */
+    void releaseId(const Type id);
+
+    /** \brief Count of ids owned by the cache and not handed out */
+    std::size_t countOfCachedIds() const { return _ids.size(); }
+
+    /** \brief Give every cached id back to the provider */
+    void drain();
+};
+
+template<class SharedProvider>
+constexpr std::size_t IdCache<SharedProvider>::DEFAULT_BATCH_SIZE;
+
+template<class SharedProvider>
+typename IdCache<SharedProvider>::Type IdCache<SharedProvider>::takeNextId()
+{
+    if(_ids.empty())
+    {
+        // ) Ids are pushed so that the lowest one is at the back and handed out first
+        _provider.takeNextIds(_batchSize, std::back_inserter(_ids));
+        std::reverse(_ids.begin(), _ids.end());
+
+        // ) Provider ran out of ids, let it assert or return MAX as IdProvider does
+        if(_ids.empty())
+            return _provider.takeNextId();
+    }
+
+    const auto id = _ids.back();
+    _ids.pop_back();
+    return id;
+}
+
+template<class SharedProvider>
+void IdCache<SharedProvider>::releaseId(const Type id)
+{
+    _ids.push_back(id);
+
+    // ) Give back the oldest ids, the most recently released stay hot in the cache
+    if(_ids.size() > _capacity)
+    {
+        const auto end = _ids.begin() + static_cast<std::ptrdiff_t>(_batchSize);
+        _provider.releaseIds(_ids.begin(), end);
+        _ids.erase(_ids.begin(), end);
+    }
+}
+
+template<class SharedProvider>
+void IdCache<SharedProvider>::drain()
+{
+    if(_ids.empty())
+        return;
+    _provider.releaseIds(_ids.begin(), _ids.end());
+    _ids.clear();
+}
+
+}
+
+#endif
@@ -0,0 +1,212 @@
+#ifndef __UNIQUE_ID_COMPACTION_PLAN_HPP__
+#define __UNIQUE_ID_COMPACTION_PLAN_HPP__
+
+// ─────────────────────────────────────────────────────────────
+//                  INCLUDE
+// ─────────────────────────────────────────────────────────────
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+// ─────────────────────────────────────────────────────────────
+//                  DECLARATION
+// ─────────────────────────────────────────────────────────────
+
+namespace unique {
+
+// ─────────────────────────────────────────────────────────────
+//                  CLASS
+// ─────────────────────────────────────────────────────────────
+
+/**
+ * Remapping that make the taken ids of a provider dense again.
+ * With n taken ids, every taken id at or above MIN + n is moved into a hole below MIN + n. It is
+ * the minimal count of moves: ids already in [MIN, MIN + n) never move.
+ * Holes and moved ids are paired in increasing order, so moved ids keep their relative order.
+ *
+ * The plan is computed from a const provider, then apply() move the ids in the provider and the
+ * keys of a TMap. remaps() is sorted by from, so that arrays indexed by id can be fixed in one sweep:
+ *
+ *     for(const auto& remap: plan.remaps()) array[remap.to] = std::move(array[remap.from]);
+ *     array.resize(plan.end() - MIN);
+ */
+template<typename T>
+class IdCompactionPlan
+{
+public:
+    using Type = T;
+
+    struct Remap
+    {
+        T from;
+        T to;
+    };
+
+    /** Compute the plan of idProvider. The provider must not change before apply */
+    template<class Provider>
+    explicit IdCompactionPlan(const Provider& idProvider);
+
+private:
+    std::vector<Remap> _remaps;
+    T _end;
+
+private:
+    /** Check that the plan still match idProvider, and that no destination key is used in map */
+    template<class Provider>
+    bool isValid(const Provider& idProvider) const;
+
+    template<class Provider, class Map>
+    bool isValid(const Provider& idProvider, const Map& map) const;
+
+    template<class Provider>
+    void applyToProvider(Provider& idProvider) const;
+
+    // ──────── C++ API ──────────
+public:
+    /** \brief Every moved id, sorted by from */
+    const std::vector<Remap>& remaps() const { return _remaps; }
+
+    /** \brief Get if the ids are already dense */
+    bool empty() const { return _remaps.empty(); }
+
+    /** \brief Count of moved ids */
+    std::size_t size() const { return _remaps.size(); }
+
+    /** \brief Exclusive upper bound of taken ids once the plan is applied */
+    T end() const { return _end; }
+
+    /** \brief New id of id, id itself if it doesn't move. O(log moves) */
+    T remap(const T id) const;
+
+    /**
+     * \brief Move the ids in idProvider: each destination is taken, each source released.
+     * \return false without modifying anything if the provider changed since the plan was computed
+     */
+    template<class Provider>
+    bool apply(Provider& idProvider) const;
+
+    /**
+     * \brief Move the ids in idProvider and the id keys of map (a TMap) at once, with TMap::move.
+     * Sources that aren't keys of map are skipped.
+     * \return false without modifying anything if the provider changed or a destination is already a key of map
+     */
+    template<class Provider, class Map>
+    bool apply(Provider& idProvider, Map& map) const;
+};
+
+template<typename T>
+template<class Provider>
+IdCompactionPlan<T>::IdCompactionPlan(const Provider& idProvider) :
+    _end(static_cast<T>(idProvider.MIN + static_cast<T>(idProvider.countOfTakenIds())))
+{
+    // ) Holes below the end, and taken ids at or above it, are collected from the same walk of runs
+    std::vector<T> holes;
+    std::vector<T> moved;
+    const auto end = _end;
+    auto previousLast = idProvider.MIN;
+    const auto collectTaken = [&](const T first, const T last)
+    {
+        for(auto id = std::max(first, end); id < last; ++id) moved.push_back(id);
+    };
+    idProvider.forEachAvailableRun([&](const T first, const T last)
+    {
+        collectTaken(previousLast, first);
+        for(auto id = first; id < std::min(last, end); ++id) holes.push_back(id);
+        previousLast = last;
+    });
+    collectTaken(previousLast, idProvider.getNextEndId());
+    assert(holes.size() == moved.size());
+
+    _remaps.reserve(moved.size());
+    for(std::size_t i = 0; i < moved.size(); ++i) _remaps.push_back({moved[i], holes[i]});
+}
+
+template<typename T>
+T IdCompactionPlan<T>::remap(const T id) const
+{
+    const auto it = std::lower_bound(_remaps.begin(), _remaps.end(), id,
+        [](const Remap& remap, const T value) { return remap.from < value; });
+    return (it != _remaps.end() && it->from == id) ? it->to : id;
+}
+
+template<typename T>
+template<class Provider>
+bool IdCompactionPlan<T>::isValid(const Provider& idProvider) const
+{
+    for(const auto& remap: _remaps)
+    {
+        if(remap.from >= idProvider.getNextEndId() || !idProvider.isIdTaken(remap.from)
+            || !idProvider.isIdAvailable(remap.to))
+            return false;
+    }
+    return true;
+}
+
+template<typename T>
+template<class Provider, class Map>
+bool IdCompactionPlan<T>::isValid(const Provider& idProvider, const Map& map) const
+{
+    if(!isValid(idProvider))
+        return false;
+    for(const auto& remap: _remaps)
+    {
+        if(map.contains(remap.to))
+            return false;
+    }
+    return true;
+}
+
+template<typename T>
+template<class Provider>
+void IdCompactionPlan<T>::applyToProvider(Provider& idProvider) const
+{
+    for(const auto& remap: _remaps)
+    {
+        const auto taken = idProvider.takeId(remap.to);
+        assert(taken);
+        (void)taken;
+    }
+
+    // ) Sources are sorted, they are released as runs and the counter shrink to end()
+    std::vector<T> sources;
+    sources.reserve(_remaps.size());
+    for(const auto& remap: _remaps) sources.push_back(remap.from);
+    idProvider.releaseIds(sources.begin(), sources.end());
+}
+
+template<typename T>
+template<class Provider>
+bool IdCompactionPlan<T>::apply(Provider& idProvider) const
+{
+    if(!isValid(idProvider))
+        return false;
+    applyToProvider(idProvider);
+    return true;
+}
+
+template<typename T>
+template<class Provider, class Map>
+bool IdCompactionPlan<T>::apply(Provider& idProvider, Map& map) const
+{
+    if(!isValid(idProvider, map))
+        return false;
+
+    // ) Destinations are free in map, so every move succeed
+    for(const auto& remap: _remaps)
+    {
+        if(map.contains(remap.from))
+        {
+            const auto moved = map.move(remap.from, remap.to);
+            assert(moved);
+            (void)moved;
+        }
+    }
+    applyToProvider(idProvider);
+    return true;
+}
+
+}
+
+#endif
@@ -0,0 +1,77 @@
+#ifndef __UNIQUE_ID_SNAPSHOT_HPP__
+#define __UNIQUE_ID_SNAPSHOT_HPP__
+
+// ─────────────────────────────────────────────────────────────
+//                  INCLUDE
+// ─────────────────────────────────────────────────────────────
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+// ─────────────────────────────────────────────────────────────
+//                  DECLARATION
+// ─────────────────────────────────────────────────────────────
+
+namespace unique {
+
+// ─────────────────────────────────────────────────────────────
+//                  CLASS
+// ─────────────────────────────────────────────────────────────
+
+/**
+ * Header of a serialized IdProvider, followed by runCount IdSnapshotRun sorted by first id.
+ * Every field is a fixed size integer in native byte order, 8 bytes aligned, so a snapshot can be
+ * read straight from a memory mapped file. Ids are stored as 64-bit whatever the id type.
+ * A snapshot written on a machine of the other endianness is rejected because of the magic.
+ */
+struct IdSnapshotHeader
+{
+    enum : std::uint32_t { MAGIC = 0x44495155 }; // "UQID" in little endian
+    enum : std::uint16_t { VERSION = 1 };
+
+    std::uint32_t magic;
+    std::uint16_t version;
+    /** sizeof the id type */
+    std::uint16_t idSize;
+    std::uint64_t min;
+    std::uint64_t max;
+    /** Next id given by the counter. Every id in [counter, max) is available */
+    std::uint64_t counter;
+    std::uint64_t takenCount;
+    std::uint64_t runCount;
+};
+
+/** Run of available ids [first, last), all below the counter */
+struct IdSnapshotRun
+{
+    std::uint64_t first;
+    std::uint64_t last;
+};
+
+static_assert(sizeof(IdSnapshotHeader) == 48, "IdSnapshotHeader layout should be packed");
+static_assert(sizeof(IdSnapshotRun) == 16, "IdSnapshotRun layout should be packed");
+
+namespace detail {
+
+/** Read a T at any address of a snapshot buffer */
+template<typename T>
+T readSnapshot(const unsigned char* data)
+{
+    T value;
+    std::memcpy(&value, data, sizeof(T));
+    return value;
+}
+
+/** Write value at any address of a snapshot buffer */
+template<typename T>
+void writeSnapshot(unsigned char* data, const T& value)
+{
+    std::memcpy(data, &value, sizeof(T));
+}
+
+}
+
+}
+
+#endif
@@ -0,0 +1,578 @@
+#ifndef __UNIQUE_INTERPROCESS_ID_PROVIDER_HPP__
+#define __UNIQUE_INTERPROCESS_ID_PROVIDER_HPP__
+
+// ) Robust process shared mutexes are needed to recover from a crashed process
+#if defined(__linux__) || defined(__FreeBSD__)
+    #define UNIQUE_HAS_INTERPROCESS_ID_PROVIDER 1
+#endif
+
+#ifdef UNIQUE_HAS_INTERPROCESS_ID_PROVIDER
+
+// ─────────────────────────────────────────────────────────────
+//                  INCLUDE
+// ─────────────────────────────────────────────────────────────
+
+#include <atomic>
+#include <cassert>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// ─────────────────────────────────────────────────────────────
+//                  DECLARATION
+// ─────────────────────────────────────────────────────────────
+
+namespace unique {
+
+// ─────────────────────────────────────────────────────────────
+//                  CLASS
+// ─────────────────────────────────────────────────────────────
+
+/**
+ * Header at the start of an InterprocessIdProvider segment.
+ * Only offsets are stored, so the segment can be mapped at any address in each process.
+ */
+struct InterprocessIdHeader
+{
+    enum : std::uint32_t
+    {
+        /** "UQSM" */
+        MAGIC = 0x4D535155,
+        VERSION = 2,
+    };
+
+    std::uint32_t magic;
+    std::uint16_t version;
+    std::uint16_t idSize;
+    std::uint64_t min;
+    std::uint64_t max;
+    /** Pid of the process initializing the segment, 0 until one claimed it */
+    std::atomic<std::uint32_t> creator;
+    /** Set by the creator once the segment is initialized */
+    std::atomic<std::uint32_t> ready;
+    /** Count of times the state was rebuilt after a process died holding the mutex */
+    std::atomic<std::uint32_t> recoveries;
+    pthread_mutex_t mutex;
+    /** Next offset never handed out */
+    std::atomic<std::uint64_t> counter;
+    std::atomic<std::uint64_t> takenCount;
+    /** Offset + 1 of the first free slot, 0 if the free list is empty. Guarded by mutex */
+    std::uint32_t freeHead;
+};
+
+/** Per id record of an InterprocessIdProvider segment */
+struct InterprocessIdSlot
+{
+    /** Pid of the process that took the id, 0 if the id isn't taken */
+    std::atomic<std::uint32_t> owner;
+    /** Offset + 1 of the neighbours in the free list, 0 for none. Guarded by mutex */
+    std::uint32_t prev;
+    std::uint32_t next;
+};
+
+/**
+ * IdProvider whose state live in a POSIX shared memory segment, so that processes of one host
+ * hand out ids from the same space without a broker.
+ *
+ * Mutations take a robust process shared mutex, which never enter the kernel when uncontended.
+ * Owners and counters are atomics, so queries don't lock. When a process die holding the mutex,
+ * the next process to lock it rebuild the free list and the count of taken ids from the owner
+ * records, which are always up to date.
+ * Each taken id record the pid of its owner: sweepOrphans release the ids of processes that exited
+ * without releasing them. Pids can be reused by the system, sweep soon after a worker exit.
+ *
+ * Differences with IdProvider:
+ * - Released ids are reused last in first out, the counter never go down.
+ * - max - min must be less than 2^32 - 1. The segment reserve 12 bytes per id, pages are only
+ *   backed by memory once touched.
+ * - The pid is read once in open, a forked child must open the segment again.
+ *
+ * Not included by Unique.hpp: on glibc older than 2.34, shm_open need the targets including it to link rt.
+ */
+template<typename T>
+class InterprocessIdProvider
+{
+    // ──────── DEFAULTS ──────────
+public:
+    using Type = T;
+
+    static_assert(std::atomic<std::uint32_t>::is_always_lock_free && std::atomic<std::uint64_t>::is_always_lock_free,
+        "Atomics in shared memory must be lock free");
+
+    InterprocessIdProvider() = default;
+    InterprocessIdProvider(const InterprocessIdProvider&) = delete;
+    InterprocessIdProvider& operator=(const InterprocessIdProvider&) = delete;
+    ~InterprocessIdProvider() { close(); }
+
+private:
+    static constexpr std::size_t SLOTS_OFFSET = (sizeof(InterprocessIdHeader) + 63) / 64 * 64;
+    /** Time given to the creator of a segment to initialize it */
+    static constexpr int OPEN_TIMEOUT_MS = 1000;
+
+    void* _mapping = nullptr;
+    std::size_t _mappingSize = 0;
+    T _min = T();
+    T _max = T();
+    std::uint32_t _pid = 0;
+
+    /** Hold the mutex of the segment, rebuilding the state if its owner died */
+    class Lock
+    {
+    public:
+        explicit Lock(InterprocessIdProvider& provider);
+        ~Lock();
+        explicit operator bool() const { return _locked; }
+
+    private:
+        InterprocessIdProvider& _provider;
+        bool _locked = false;
+    };
+
+private:
+    InterprocessIdHeader& header() const { return *static_cast<InterprocessIdHeader*>(_mapping); }
+
+    InterprocessIdSlot& slot(const std::uint64_t offset) const
+    {
+        return reinterpret_cast<InterprocessIdSlot*>(static_cast<char*>(_mapping) + SLOTS_OFFSET)[offset];
+    }
+
+    std::uint64_t range() const { return static_cast<std::uint64_t>(_max - _min); }
+
+    std::uint64_t offsetOf(const T id) const
+    {
+        assert(id >= _min && id < _max);
+        return static_cast<std::uint64_t>(id - _min);
+    }
+
+    T idOf(const std::uint64_t offset) const { return _min + static_cast<T>(offset); }
+
+    /** Push offset on the free list. Mutex must be held */
+    void pushFree(const std::uint64_t offset);
+
+    /** Remove offset from the free list. Mutex must be held */
+    void unlinkFree(const std::uint64_t offset);
+
+    /** Rebuild the free list and the taken count from the owners, after a process died holding the mutex */
+    void recover();
+
+    static bool isProcessAlive(const std::uint32_t pid);
+
+    /** Wait OPEN_TIMEOUT_MS at most for the creator to set ready. \return false on timeout */
+    static bool waitReady(const InterprocessIdHeader& segment);
+
+    /** Write the header of a segment claimed by this process, then set ready */
+    static void initialize(InterprocessIdHeader& segment, const T min, const T max);
+
+    // ──────── C++ API ──────────
+public:
+    /**
+     * \brief Create the segment name, or attach to it if it already exist.
+     * name follow shm_open rules, for example "/my-ids".
+     * If its creator died before initializing it, the segment is initialized in its place.
+     * \return false if the segment can't be created, or was created with other bounds or id type
+     */
+    bool open(const std::string& name, const T min, const T max);
+
+    /** \brief Unmap the segment. Ids taken by this process stay taken */
+    void close();
+
+    /** \brief Remove the segment name. Processes that mapped it keep using it */
+    static bool remove(const std::string& name) { return shm_unlink(name.c_str()) == 0; }
+
+    bool isOpen() const { return _mapping != nullptr; }
+
+    /** \brief Take a specific id. \return false if id is already taken */
+    bool takeId(const T id);
+
+    /**
+     * \brief Take the next available id, owned by this process.
+     * The function assert and return max if every id is taken
+     */
+    T takeNextId();
+
+    /** \brief Release a taken id, whatever the process that took it */
+    void releaseId(const T id);
+
+    /** \brief Get if an id can be taken. Lock free */
+    bool isIdAvailable(const T id) const { return !isIdTaken(id); }
+
+    /** \brief Get if an id is taken. Lock free */
+    bool isIdTaken(const T id) const;
+
+    /** \brief Pid of the process that took id, 0 if id isn't taken. Lock free */
+    std::uint32_t ownerOf(const T id) const;
+
+    /** \brief Get if takeNextId can be called without reaching max */
+    bool areIdsAvailables() const { return countOfTakenIds() < range(); }
+
+    /** \brief Count of taken ids, by every process */
+    std::size_t countOfTakenIds() const;
+
+    /** \brief Count of times the state was rebuilt because a process died holding the mutex */
+    std::size_t countOfRecoveries() const;
+
+    /**
+     * \brief Release every id owned by a process that doesn't exist anymore. O(ids handed out)
+     * \param out Output iterator receiving the released ids
+     * \return Output iterator past the last written id
+     */
+    template<class OutputIt>
+    OutputIt sweepOrphans(OutputIt out);
+};
+
+template<typename T>
+constexpr std::size_t InterprocessIdProvider<T>::SLOTS_OFFSET;
+template<typename T>
+constexpr int InterprocessIdProvider<T>::OPEN_TIMEOUT_MS;
+
+template<typename T>
+InterprocessIdProvider<T>::Lock::Lock(InterprocessIdProvider& provider) : _provider(provider)
+{
+    auto& mutex = provider.header().mutex;
+    const auto result = pthread_mutex_lock(&mutex);
+    if(result == EOWNERDEAD)
+    {
+        // ) The owner died in the middle of a mutation, owners are the source of truth
+        provider.recover();
+        pthread_mutex_consistent(&mutex);
+        _locked = true;
+    }
+    else
+    {
+        _locked = result == 0;
+    }
+}
+
+template<typename T>
+InterprocessIdProvider<T>::Lock::~Lock()
+{
+    if(_locked)
+        pthread_mutex_unlock(&_provider.header().mutex);
+}
+
+template<typename T>
+void InterprocessIdProvider<T>::pushFree(const std::uint64_t offset)
+{
+    auto& head = header().freeHead;
+    auto& node = slot(offset);
+    node.prev = 0;
+    node.next = head;
+    if(head)
+        slot(head - 1).prev = static_cast<std::uint32_t>(offset + 1);
+    head = static_cast<std::uint32_t>(offset + 1);
+}
+
+template<typename T>
+void InterprocessIdProvider<T>::unlinkFree(const std::uint64_t offset)
+{
+    auto& node = slot(offset);
+    if(node.prev)
+        slot(node.prev - 1).next = node.next;
+    else
+        header().freeHead = node.next;
+    if(node.next)
+        slot(node.next - 1).prev = node.prev;
+    node.prev = 0;
+    node.next = 0;
+}
+
+template<typename T>
+void InterprocessIdProvider<T>::recover()
+{
+    auto& segment = header();
+    segment.freeHead = 0;
+    std::uint64_t taken = 0;
+
+    // ) Pushed from the top, so that the lowest free id is reused first
+    for(auto offset = segment.counter.load(); offset-- > 0;)
+    {
+        if(slot(offset).owner.load())
+            ++taken;
+        else
+            pushFree(offset);
+    }
+    segment.takenCount.store(taken);
+    segment.recoveries.fetch_add(1);
+}
+
+template<typename T>
+bool InterprocessIdProvider<T>::isProcessAlive(const std::uint32_t pid)
+{
+    return kill(static_cast<pid_t>(pid), 0) == 0 || errno == EPERM;
+}
+
+template<typename T>
+bool InterprocessIdProvider<T>::waitReady(const InterprocessIdHeader& segment)
+{
+    for(int elapsed = 0; !segment.ready.load(std::memory_order_acquire); ++elapsed)
+    {
+        if(elapsed == OPEN_TIMEOUT_MS)
+            return false;
+        usleep(1000);
+    }
+    return true;
+}
+
+template<typename T>
+void InterprocessIdProvider<T>::initialize(InterprocessIdHeader& segment, const T min, const T max)
+{
+    // ) Pages of a new segment are zero: every slot is free and linked nowhere.
+    // ) A dead creator may have written the header, every field is written again
+    segment.magic = InterprocessIdHeader::MAGIC;
+    segment.version = InterprocessIdHeader::VERSION;
+    segment.idSize = sizeof(T);
+    segment.min = static_cast<std::uint64_t>(min);
+    segment.max = static_cast<std::uint64_t>(max);
+    segment.recoveries.store(0);
+    segment.counter.store(0);
+    segment.takenCount.store(0);
+    segment.freeHead = 0;
+    pthread_mutexattr_t attributes;
+    pthread_mutexattr_init(&attributes);
+    pthread_mutexattr_setpshared(&attributes, PTHREAD_PROCESS_SHARED);
+    pthread_mutexattr_setrobust(&attributes, PTHREAD_MUTEX_ROBUST);
+    pthread_mutex_init(&segment.mutex, &attributes);
+    pthread_mutexattr_destroy(&attributes);
+    segment.ready.store(1, std::memory_order_release);
+}
+
+template<typename T>
+bool InterprocessIdProvider<T>::open(const std::string& name, const T min, const T max)
+{
+    close();
+    if(!(min < max) || static_cast<std::uint64_t>(max - min) >= 0xFFFFFFFFull)
+        return false;
+
+    const auto size = SLOTS_OFFSET + static_cast<std::size_t>(max - min) * sizeof(InterprocessIdSlot);
+    auto fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+    const bool creator = fd >= 0;
+    if(creator)
+    {
+        if(ftruncate(fd, static_cast<off_t>(size)) != 0)
+        {
+            ::close(fd);
+            shm_unlink(name.c_str());
+            return false;
+        }
+    }
+    else
+    {
+        if(errno != EEXIST)
+            return false;
+        fd = shm_open(name.c_str(), O_RDWR, 0600);
+        if(fd < 0)
+            return false;
+
+        // ) The creator may not have sized the segment yet
+        struct stat status = {};
+        for(int elapsed = 0; fstat(fd, &status) == 0 && status.st_size < static_cast<off_t>(size); ++elapsed)
+        {
+            if(elapsed == OPEN_TIMEOUT_MS)
+                break;
+            usleep(1000);
+        }
+        // ) A creator that died before sizing the segment left it empty, size it in its place
+        if(status.st_size == 0 && ftruncate(fd, static_cast<off_t>(size)) == 0)
+            status.st_size = static_cast<off_t>(size);
+        if(status.st_size < static_cast<off_t>(size))
+        {
+            ::close(fd);
+            return false;
+        }
+    }
+
+    auto* mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if(mapping == MAP_FAILED)
+        return false;
+
+    // ) The creator claim the segment at once. If it died before setting ready, the first opener to
+    // ) notice claim it in its place. A creator still alive is only slow, and the open fail
+    auto& segment = *static_cast<InterprocessIdHeader*>(mapping);
+    const auto pid = static_cast<std::uint32_t>(getpid());
+    std::uint32_t owner = 0;
+    bool claimed = creator && segment.creator.compare_exchange_strong(owner, pid);
+    while(!claimed && !waitReady(segment))
+    {
+        owner = segment.creator.load();
+        if(owner && isProcessAlive(owner))
+            break;
+        claimed = segment.creator.compare_exchange_strong(owner, pid);
+    }
+    if(claimed)
+        initialize(segment, min, max);
+
+    if(!segment.ready.load(std::memory_order_acquire) || segment.magic != InterprocessIdHeader::MAGIC
+        || segment.version != InterprocessIdHeader::VERSION || segment.idSize != sizeof(T)
+        || segment.min != static_cast<std::uint64_t>(min) || segment.max != static_cast<std::uint64_t>(max))
+    {
+        munmap(mapping, size);
+        return false;
+    }
+
+    _mapping = mapping;
+    _mappingSize = size;
+    _min = min;
+    _max = max;
+    _pid = pid;
+    return true;
+}
+
+template<typename T>
+void InterprocessIdProvider<T>::close()
+{
+    if(!_mapping)
+        return;
+    munmap(_mapping, _mappingSize);
+    _mapping = nullptr;
+    _mappingSize = 0;
+}
+
+template<typename T>
+bool InterprocessIdProvider<T>::takeId(const T id)
+{
+    const auto offset = offsetOf(id);
+    Lock lock(*this);
+    if(!lock)
+        return false;
+
+    auto& segment = header();
+    const auto counter = segment.counter.load();
+    if(offset < counter)
+    {
+        if(slot(offset).owner.load())
+            return false;
+        unlinkFree(offset);
+    }
+    else
+    {
+        // ) Ids skipped by the counter are free, the lowest one on top
+        for(auto skipped = offset; skipped-- > counter;) pushFree(skipped);
+        segment.counter.store(offset + 1);
+    }
+    slot(offset).owner.store(_pid, std::memory_order_release);
+    segment.takenCount.fetch_add(1);
+    return true;
+}
+
+template<typename T>
+T InterprocessIdProvider<T>::takeNextId()
+{
+    Lock lock(*this);
+    assert(lock);
+    if(!lock)
+        return _max;
+
+    auto& segment = header();
+    std::uint64_t offset = 0;
+    if(segment.freeHead)
+    {
+        offset = segment.freeHead - 1;
+        unlinkFree(offset);
+    }
+    else
+    {
+        offset = segment.counter.load();
+        assert(offset < range());
+        if(offset >= range())
+            return _max;
+        segment.counter.store(offset + 1);
+    }
+    slot(offset).owner.store(_pid, std::memory_order_release);
+    segment.takenCount.fetch_add(1);
+    return idOf(offset);
+}
+
+template<typename T>
+void InterprocessIdProvider<T>::releaseId(const T id)
+{
+    const auto offset = offsetOf(id);
+    Lock lock(*this);
+    assert(lock);
+    if(!lock)
+        return;
+
+    auto& owner = slot(offset).owner;
+    assert(owner.load() != 0);
+    if(!owner.load())
+        return;
+
+    // ) The owner is cleared first: a crash after it is repaired by recover
+    owner.store(0, std::memory_order_release);
+    pushFree(offset);
+    header().takenCount.fetch_sub(1);
+}
+
+template<typename T>
+bool InterprocessIdProvider<T>::isIdTaken(const T id) const
+{
+    return ownerOf(id) != 0;
+}
+
+template<typename T>
+std::uint32_t InterprocessIdProvider<T>::ownerOf(const T id) const
+{
+    const auto offset = offsetOf(id);
+    if(offset >= header().counter.load(std::memory_order_acquire))
+        return 0;
+    return slot(offset).owner.load(std::memory_order_acquire);
+}
+
+template<typename T>
+std::size_t InterprocessIdProvider<T>::countOfTakenIds() const
+{
+    return static_cast<std::size_t>(header().takenCount.load(std::memory_order_acquire));
+}
+
+template<typename T>
+std::size_t InterprocessIdProvider<T>::countOfRecoveries() const
+{
+    return header().recoveries.load(std::memory_order_acquire);
+}
+
+template<typename T>
+template<class OutputIt>
+OutputIt InterprocessIdProvider<T>::sweepOrphans(OutputIt out)
+{
+    Lock lock(*this);
+    if(!lock)
+        return out;
+
+    // ) Each owner is checked once, a worker usually own many ids
+    std::map<std::uint32_t, bool> alive;
+    auto& segment = header();
+    const auto counter = segment.counter.load();
+    for(std::uint64_t offset = 0; offset < counter; ++offset)
+    {
+        auto& owner = slot(offset).owner;
+        const auto pid = owner.load();
+        if(!pid || pid == _pid)
+            continue;
+        auto it = alive.find(pid);
+        if(it == alive.end())
+            it = alive.emplace(pid, isProcessAlive(pid)).first;
+        if(it->second)
+            continue;
+
+        owner.store(0, std::memory_order_release);
+        pushFree(offset);
+        segment.takenCount.fetch_sub(1);
+        *out++ = idOf(offset);
+    }
+    return out;
+}
+
+}
+
+#endif
+
+#endif
@@ -0,0 +1,306 @@
+#ifndef __UNIQUE_INTERVAL_ID_STORAGE_HPP__
+#define __UNIQUE_INTERVAL_ID_STORAGE_HPP__
+
+// ─────────────────────────────────────────────────────────────
+//                  INCLUDE
+// ─────────────────────────────────────────────────────────────
+
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <map>
+
+// ─────────────────────────────────────────────────────────────
+//                  DECLARATION
+// ─────────────────────────────────────────────────────────────
+
+namespace unique {
+
+// ─────────────────────────────────────────────────────────────
+//                  CLASS
+// ─────────────────────────────────────────────────────────────
+
+/**
+ * Storage of the available ids of an IdProvider as disjoint [first, last) runs.
+ * Runs are never adjacent: they are merged as soon as they touch.
+ * Every operation cost O(log runs) time, memory is O(runs) whatever the count of ids in each run.
+ * Ids are handed back lowest first.
+ */
+template<typename T>
+class IntervalIdStorage
+{
+public:
+    /** Ids are handed out lowest first, the provider can shrink its counter */
+    static constexpr bool LOWEST_FIRST = true;
+
+    explicit IntervalIdStorage(const T /*base*/ = T()) {}
+
+private:
+    /** Key is last id of the run excluded, value is first id. Keying by the end let popFront and
+     * erase shrink a run in place */
+    using Runs = std::map<T, T>;
+    Runs _runs;
+    std::size_t _size = 0;
+
+private:
+    /** Run containing id, or _runs.end() */
+    typename Runs::const_iterator findRun(const T id) const;
+    typename Runs::iterator findRun(const T id);
+
+public:
+    /** Get if there is no available id */
+    bool empty() const { return _size == 0; }
+
+    /** Count of available ids */
+    std::size_t size() const { return _size; }
+
+    /** Count of disjoint runs of available ids */
+    std::size_t runCount() const { return _runs.size(); }
+
+    /** Get if id is available */
+    bool contains(const T id) const { return findRun(id) != _runs.end(); }
+
+    /** Make id available. id must not already be available */
+    void insert(const T id) { insertRange(id, id + 1); }
+
+    /** Make every id in [first, last) available. None of them must already be available */
+    void insertRange(const T first, const T last);
+
+    /**
+     * \brief Remove id from the available ids
+     * \return false if id wasn't available
+     */
+    bool erase(const T id);
+
+    /**
+     * \brief Remove the run of available ids that end right before end.
+     * \return First id of the removed run, or end if end - 1 isn't available
+     */
+    T eraseRunEndingAt(const T end);
+
+    /** Next id to hand out, the lowest one. Storage must not be empty */
+    T front() const
+    {
+        assert(!empty());
+        return _runs.begin()->second;
+    }
+
+    /** Remove and return front(). Storage must not be empty */
+    T popFront();
+
+    /**
+     * \brief Remove the lowest available ids as long as they are consecutive, up to maxCount ids
+     * \param first Receive the first removed id
+     * \return Count of removed ids, [first, first + count) were removed
+     */
+    std::size_t popFrontRun(const std::size_t maxCount, T& first);
+
+    /**
+     * \brief Remove the lowest run of at least count consecutive available ids
+     * \param first Receive the first removed id, [first, first + count) were removed
+     * \return false if there is no such run
+     */
+    bool popContiguous(const std::size_t count, T& first);
+
+    /**
+     * \brief Find the available id closest to hint, the lowest one on a tie. O(log runs)
+     * \return false if the storage is empty
+     */
+    bool findNear(const T hint, T& id) const;
+
+    /** Call function(first, last) for each run of available ids, lowest first */
+    template<class Function>
+    void forEachRun(Function function) const
+    {
+        for(const auto& run: _runs) function(run.second, run.first);
+    }
+
+    /** Remove every available id */
+    void clear()
+    {
+        _runs.clear();
+        _size = 0;
+    }
+};
+
+template<typename T>
+constexpr bool IntervalIdStorage<T>::LOWEST_FIRST;
+
+template<typename T>
+typename IntervalIdStorage<T>::Runs::const_iterator IntervalIdStorage<T>::findRun(const T id) const
+{
+    // ) First run ending after id
+    const auto it = _runs.upper_bound(id);
+    return (it != _runs.end() && it->second <= id) ? it : _runs.end();
+}
+
+template<typename T>
+typename IntervalIdStorage<T>::Runs::iterator IntervalIdStorage<T>::findRun(const T id)
+{
+    const auto it = _runs.upper_bound(id);
+    return (it != _runs.end() && it->second <= id) ? it : _runs.end();
+}
+
+template<typename T>
+bool IntervalIdStorage<T>::findNear(const T hint, T& id) const
+{
+    if(empty())
+        return false;
+
+    // ) First run ending after hint: it contain hint or start above it
+    const auto next = _runs.upper_bound(hint);
+    if(next != _runs.end() && next->second <= hint)
+    {
+        id = hint;
+        return true;
+    }
+    if(next == _runs.begin())
+    {
+        id = next->second;
+        return true;
+    }
+
+    // ) Runs are disjoint, so the last id of the previous run is the closest below hint
+    const T below = std::prev(next)->first - 1;
+    id = (next == _runs.end() || hint - below <= next->second - hint) ? below : next->second;
+    return true;
+}
+
+template<typename T>
+void IntervalIdStorage<T>::insertRange(const T first, const T last)
+{
+    if(first >= last)
+        return;
+
+    // ) next is the first run ending after first, it must start after last
+    const auto next = _runs.upper_bound(first);
+    assert(next == _runs.end() || next->second >= last);
+
+    // ) The previous run is the one ending exactly at first
+    auto previous = _runs.end();
+    if(next != _runs.begin())
+    {
+        previous = std::prev(next);
+        assert(previous->first <= first);
+        if(previous->first != first)
+            previous = _runs.end();
+    }
+
+    if(next != _runs.end() && next->second == last)
+    {
+        // ) Extend next run to the front, absorbing previous run if it touch
+        if(previous != _runs.end())
+        {
+            next->second = previous->second;
+            _runs.erase(previous);
+        }
+        else
+            next->second = first;
+    }
+    else if(previous != _runs.end())
+    {
+        // ) The key of previous change, so it need to be reinserted
+        const auto previousFirst = previous->second;
+        _runs.erase(previous);
+        _runs.emplace_hint(next, last, previousFirst);
+    }
+    else
+    {
+        _runs.emplace_hint(next, last, first);
+    }
+
+    _size += static_cast<std::size_t>(last - first);
+}
+
+template<typename T>
+bool IntervalIdStorage<T>::erase(const T id)
+{
+    const auto it = findRun(id);
+    if(it == _runs.end())
+        return false;
+
+    // ) Split the run in [first, id) and [id + 1, last). The upper part keep the node
+    const auto runFirst = it->second;
+    it->second = id + 1;
+    if(runFirst < id)
+        _runs.emplace_hint(it, id, runFirst);
+    if(it->second == it->first)
+        _runs.erase(it);
+
+    --_size;
+    return true;
+}
+
+template<typename T>
+T IntervalIdStorage<T>::eraseRunEndingAt(const T end)
+{
+    const auto it = _runs.find(end);
+    if(it == _runs.end())
+        return end;
+
+    const auto first = it->second;
+    _size -= static_cast<std::size_t>(end - first);
+    _runs.erase(it);
+    return first;
+}
+
+template<typename T>
+T IntervalIdStorage<T>::popFront()
+{
+    assert(!empty());
+    const auto it = _runs.begin();
+    const auto id = it->second;
+
+    // ) Runs are keyed by their end, so shrinking from the front never reallocate a node
+    if(++it->second == it->first)
+        _runs.erase(it);
+
+    --_size;
+    return id;
+}
+
+template<typename T>
+std::size_t IntervalIdStorage<T>::popFrontRun(const std::size_t maxCount, T& first)
+{
+    assert(!empty() && maxCount);
+    const auto it = _runs.begin();
+    first = it->second;
+
+    // ) Runs are never adjacent, so a single run is consumed at most
+    const auto length = static_cast<std::size_t>(it->first - it->second);
+    const auto count = length < maxCount ? length : maxCount;
+    if(count == length)
+        _runs.erase(it);
+    else
+        it->second += static_cast<T>(count);
+
+    _size -= count;
+    return count;
+}
+
+template<typename T>
+bool IntervalIdStorage<T>::popContiguous(const std::size_t count, T& first)
+{
+    assert(count);
+
+    // ) First fit: the lowest run long enough is shrunk from the front
+    for(auto it = _runs.begin(); it != _runs.end(); ++it)
+    {
+        const auto length = static_cast<std::size_t>(it->first - it->second);
+        if(length < count)
+            continue;
+
+        first = it->second;
+        if(length == count)
+            _runs.erase(it);
+        else
+            it->second += static_cast<T>(count);
+        _size -= count;
+        return true;
+    }
+    return false;
+}
+
+}
+
+#endif
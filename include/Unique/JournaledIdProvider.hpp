@@ -0,0 +1,571 @@
+#ifndef __UNIQUE_JOURNALED_ID_PROVIDER_HPP__
+#define __UNIQUE_JOURNALED_ID_PROVIDER_HPP__
+
+// ─────────────────────────────────────────────────────────────
+//                  INCLUDE
+// ─────────────────────────────────────────────────────────────
+
+#include <Unique/IdSnapshot.hpp>
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <optional>
+#include <string>
+#include <vector>
+
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+// ─────────────────────────────────────────────────────────────
+//                  DECLARATION
+// ─────────────────────────────────────────────────────────────
+
+namespace unique {
+
+/**
+ * Header of a journal file and of a checkpoint file. A checkpoint is followed by an IdProvider
+ * snapshot, a journal by group committed batches. A journal is only replayed on top of the
+ * checkpoint of the same generation.
+ */
+struct IdJournalHeader
+{
+    enum : std::uint32_t
+    {
+        CHECKPOINT_MAGIC = 0x4B435155, // "UQCK" in little endian
+        JOURNAL_MAGIC = 0x4C4A5155, // "UQJL" in little endian
+    };
+    enum : std::uint16_t { VERSION = 1 };
+
+    std::uint32_t magic;
+    std::uint16_t version;
+    std::uint16_t reserved;
+    std::uint64_t generation;
+};
+
+/** Header of each group committed batch of records. A batch with a wrong checksum is a torn write */
+struct IdJournalBatch
+{
+    std::uint32_t size;
+    std::uint32_t checksum;
+};
+
+static_assert(sizeof(IdJournalHeader) == 16, "IdJournalHeader layout should be packed");
+static_assert(sizeof(IdJournalBatch) == 8, "IdJournalBatch layout should be packed");
+
+namespace detail {
+
+/** FNV-1a of a journal batch */
+inline std::uint32_t journalChecksum(const unsigned char* data, const std::size_t size)
+{
+    std::uint32_t hash = 2166136261u;
+    for(std::size_t i = 0; i < size; ++i)
+    {
+        hash ^= data[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/** Push value as LEB128, 7 bits per byte */
+inline void pushVarint(std::vector<unsigned char>& buffer, std::uint64_t value)
+{
+    while(value >= 0x80)
+    {
+        buffer.push_back(static_cast<unsigned char>(value | 0x80));
+        value >>= 7;
+    }
+    buffer.push_back(static_cast<unsigned char>(value));
+}
+
+/** Read a LEB128 value at offset. \return false if the buffer end before the value */
+inline bool readVarint(const unsigned char* data, const std::size_t size, std::size_t& offset,
+    std::uint64_t& value)
+{
+    value = 0;
+    for(unsigned shift = 0; offset < size && shift < 64; shift += 7)
+    {
+        const auto byte = data[offset++];
+        value |= std::uint64_t(byte & 0x7F) << shift;
+        if(!(byte & 0x80))
+            return true;
+    }
+    return false;
+}
+
+/** Read the whole file at path. \return false if the file can't be opened */
+inline bool readFile(const std::string& path, std::vector<unsigned char>& content)
+{
+    content.clear();
+    auto* file = std::fopen(path.c_str(), "rb");
+    if(!file)
+        return false;
+    unsigned char chunk[4096];
+    std::size_t read;
+    while((read = std::fread(chunk, 1, sizeof(chunk), file)) > 0)
+        content.insert(content.end(), chunk, chunk + read);
+    std::fclose(file);
+    return true;
+}
+
+/** Cut file at size and move the write position there. Unbuffered files only, nothing must be left to flush */
+inline bool truncateFile(std::FILE* file, const std::uint64_t size)
+{
+    std::clearerr(file);
+#if defined(_WIN32)
+    if(_chsize_s(_fileno(file), static_cast<long long>(size)) != 0)
+        return false;
+#else
+    if(ftruncate(fileno(file), static_cast<off_t>(size)) != 0)
+        return false;
+#endif
+    return std::fseek(file, static_cast<long>(size), SEEK_SET) == 0;
+}
+
+/** Flush file to the OS then to the disk */
+inline bool syncFile(std::FILE* file)
+{
+    if(std::fflush(file) != 0)
+        return false;
+#if defined(_WIN32)
+    return _commit(_fileno(file)) == 0;
+#else
+    return fsync(fileno(file)) == 0;
+#endif
+}
+
+/** Sync the directory of path to the disk, so that a rename in it is durable. Nothing to do on Windows */
+inline bool syncDirectory(const std::string& path)
+{
+#if defined(_WIN32)
+    (void)path;
+    return true;
+#else
+    const auto separator = path.find_last_of('/');
+    const auto directory = separator == std::string::npos ? std::string(".") : path.substr(0, separator ? separator : 1);
+    const auto descriptor = ::open(directory.c_str(), O_RDONLY);
+    if(descriptor < 0)
+        return false;
+    const auto synced = fsync(descriptor) == 0;
+    ::close(descriptor);
+    return synced;
+#endif
+}
+
+}
+
+// ─────────────────────────────────────────────────────────────
+//                  CLASS
+// ─────────────────────────────────────────────────────────────
+
+/**
+ * Make an IdProvider (or DynamicIdProvider) crash consistent with an append-only journal.
+ * takeId, takeNextId, releaseId and clear are applied then appended as compact records (one op
+ * byte and the id offset as a varint). Records are group committed: written and synced to the
+ * disk groupSize at a time, or when commit() is called.
+ * An id is durable once the commit including it returned, so commit before persisting data
+ * refering to new ids.
+ *
+ * A failed commit cut the journal back after the last committed batch, so that later batches are
+ * never written after a torn one, and keep its records pending for the next commit. When a record
+ * commit its group and that commit fail, the operation isn't applied and report the failure.
+ * If the journal can't be cut, or a checkpoint can't be synced after its rename, every commit fail
+ * until checkpoint() or open() succeed.
+ *
+ * checkpoint() write a snapshot of the provider and start a new empty journal. open() recover the
+ * state: load the last checkpoint then replay the journal, up to the first torn batch.
+ * This class isn't thread safe, wrap it in a SharedIdProvider if needed.
+ */
+template<class Provider>
+class JournaledIdProvider
+{
+public:
+    using ProviderType = Provider;
+    using Type = typename Provider::Type;
+
+    static constexpr std::size_t DEFAULT_GROUP_SIZE = 64;
+
+    /** \param groupSize Count of records written to the disk at once */
+    explicit JournaledIdProvider(const std::size_t groupSize = DEFAULT_GROUP_SIZE) :
+        _groupSize(groupSize ? groupSize : 1)
+    {
+    }
+
+    JournaledIdProvider(const JournaledIdProvider&) = delete;
+    JournaledIdProvider& operator=(const JournaledIdProvider&) = delete;
+
+    ~JournaledIdProvider() { close(); }
+
+private:
+    enum Operation : unsigned char
+    {
+        TAKE = 1,
+        RELEASE = 2,
+        CLEAR = 3,
+    };
+
+    Provider _provider;
+    const std::size_t _groupSize;
+    std::string _checkpointPath;
+    std::string _journalPath;
+    std::FILE* _journal = nullptr;
+    std::uint64_t _generation = 0;
+    /** Journal size after the last committed batch, where the next batch is written */
+    std::uint64_t _committedSize = 0;
+    /** The journal couldn't be cut back after a failed write, nothing can be appended safely */
+    bool _failed = false;
+    /** Records not written yet */
+    std::vector<unsigned char> _pending;
+    std::size_t _pendingCount = 0;
+
+private:
+    /**
+     * Add a record, and commit the group if it is full.
+     * \return false if that commit failed, the record is then dropped
+     */
+    bool append(const Operation operation, const Type id);
+    bool append(const Operation operation);
+
+    /** Commit the group if it is full. On failure the last record is dropped */
+    bool commitIfFull(const std::size_t recordOffset);
+
+    /** Load the checkpoint file. \return false if it exists but is invalid */
+    bool loadCheckpoint();
+
+    /** Replay the journal if it match the checkpoint generation. \return Count of replayed records */
+    std::size_t replayJournal();
+
+    /** Replay the records of one batch. \return false if a record is invalid */
+    bool replayBatch(const unsigned char* data, const std::size_t size, std::size_t& replayed);
+
+    // ──────── C++ API ──────────
+public:
+    /**
+     * \brief Recover the provider from checkpointPath and journalPath, then write a new checkpoint.
+     * Missing files mean an empty provider
+     * \return false if the checkpoint is corrupted or the files can't be written
+     */
+    bool open(const std::string& checkpointPath, const std::string& journalPath);
+
+    /** \brief Commit pending records and close the journal */
+    void close();
+
+    /** \brief Get if open succeeded and close wasn't called */
+    bool isOpen() const { return _journal != nullptr; }
+
+    /** \brief Provider holding the state, for queries */
+    const Provider& provider() const { return _provider; }
+
+    /** \brief Take a specific id and journal it. \return false if id is already taken or the commit failed */
+    bool takeId(const Type id);
+
+    /** \brief Take the next available id and journal it. \return No id if every id is taken or the commit failed */
+    std::optional<Type> takeNextId();
+
+    /** \brief Release an id and journal it. \return false if the commit failed, id is still taken */
+    bool releaseId(const Type id);
+
+    /** \brief Release every id and journal it. \return false if the commit failed, nothing is released */
+    bool clear();
+
+    /** \brief Count of records not written to the disk yet */
+    std::size_t countOfPendingRecords() const { return _pendingCount; }
+
+    /**
+     * \brief Write pending records as one batch and sync it to the disk.
+     * On failure the records stay pending, and the journal is cut back to the previous batch
+     * \return false on I/O error
+     */
+    bool commit();
+
+    /**
+     * \brief Write a snapshot of the provider and start a new empty journal.
+     * The snapshot replace the previous one atomically, pending records are dropped only once it is durable
+     * \return false on I/O error
+     */
+    bool checkpoint();
+};
+
+template<class Provider>
+constexpr std::size_t JournaledIdProvider<Provider>::DEFAULT_GROUP_SIZE;
+
+template<class Provider>
+bool JournaledIdProvider<Provider>::append(const Operation operation, const Type id)
+{
+    assert(isOpen());
+    const auto recordOffset = _pending.size();
+    _pending.push_back(operation);
+    detail::pushVarint(_pending, static_cast<std::uint64_t>(id - _provider.MIN));
+    return commitIfFull(recordOffset);
+}
+
+template<class Provider>
+bool JournaledIdProvider<Provider>::append(const Operation operation)
+{
+    assert(isOpen());
+    const auto recordOffset = _pending.size();
+    _pending.push_back(operation);
+    return commitIfFull(recordOffset);
+}
+
+template<class Provider>
+bool JournaledIdProvider<Provider>::commitIfFull(const std::size_t recordOffset)
+{
+    if(++_pendingCount < _groupSize || commit())
+        return true;
+
+    // ) The previous records stay pending, they were already reported as applied
+    _pending.resize(recordOffset);
+    --_pendingCount;
+    return false;
+}
+
+template<class Provider>
+bool JournaledIdProvider<Provider>::loadCheckpoint()
+{
+    std::vector<unsigned char> content;
+    if(!detail::readFile(_checkpointPath, content))
+        return true;
+
+    if(content.size() < sizeof(IdJournalHeader))
+        return false;
+    const auto header = detail::readSnapshot<IdJournalHeader>(content.data());
+    if(header.magic != IdJournalHeader::CHECKPOINT_MAGIC || header.version != IdJournalHeader::VERSION)
+        return false;
+    if(!_provider.deserialize(content.data() + sizeof(IdJournalHeader), content.size() - sizeof(IdJournalHeader)))
+        return false;
+
+    _generation = header.generation;
+    return true;
+}
+
+template<class Provider>
+std::size_t JournaledIdProvider<Provider>::replayJournal()
+{
+    std::vector<unsigned char> content;
+    if(!detail::readFile(_journalPath, content) || content.size() < sizeof(IdJournalHeader))
+        return 0;
+
+    // ) A journal of another generation is already included in the checkpoint
+    const auto header = detail::readSnapshot<IdJournalHeader>(content.data());
+    if(header.magic != IdJournalHeader::JOURNAL_MAGIC || header.version != IdJournalHeader::VERSION
+        || header.generation != _generation)
+        return 0;
+
+    // ) Replay batches up to the first torn one, the crash happened while writing it
+    std::size_t replayed = 0;
+    std::size_t offset = sizeof(IdJournalHeader);
+    while(content.size() - offset >= sizeof(IdJournalBatch))
+    {
+        const auto batch = detail::readSnapshot<IdJournalBatch>(content.data() + offset);
+        offset += sizeof(IdJournalBatch);
+        if(batch.size > content.size() - offset
+            || batch.checksum != detail::journalChecksum(content.data() + offset, batch.size)
+            || !replayBatch(content.data() + offset, batch.size, replayed))
+            break;
+        offset += batch.size;
+    }
+    return replayed;
+}
+
+template<class Provider>
+bool JournaledIdProvider<Provider>::replayBatch(const unsigned char* data, const std::size_t size,
+    std::size_t& replayed)
+{
+    const auto range = static_cast<std::uint64_t>(_provider.MAX - _provider.MIN);
+    std::size_t offset = 0;
+    while(offset < size)
+    {
+        const auto operation = data[offset++];
+        if(operation == CLEAR)
+        {
+            _provider.clear();
+            ++replayed;
+            continue;
+        }
+
+        std::uint64_t value;
+        if(!detail::readVarint(data, size, offset, value) || value >= range)
+            return false;
+        const auto id = static_cast<Type>(_provider.MIN + static_cast<Type>(value));
+        if(operation == TAKE)
+        {
+            if(!_provider.takeId(id))
+                return false;
+        }
+        else if(operation == RELEASE && _provider.isIdTaken(id))
+            _provider.releaseId(id);
+        else
+            return false;
+        ++replayed;
+    }
+    return true;
+}
+
+template<class Provider>
+bool JournaledIdProvider<Provider>::open(const std::string& checkpointPath, const std::string& journalPath)
+{
+    close();
+    _checkpointPath = checkpointPath;
+    _journalPath = journalPath;
+    _provider.clear();
+    _generation = 0;
+
+    if(!loadCheckpoint())
+        return false;
+    replayJournal();
+
+    // ) Start from a clean journal, so that a torn tail is never followed by new batches
+    return checkpoint();
+}
+
+template<class Provider>
+void JournaledIdProvider<Provider>::close()
+{
+    if(!_journal)
+        return;
+    commit();
+    std::fclose(_journal);
+    _journal = nullptr;
+}
+
+template<class Provider>
+bool JournaledIdProvider<Provider>::takeId(const Type id)
+{
+    if(!_provider.takeId(id))
+        return false;
+    if(append(TAKE, id))
+        return true;
+    _provider.releaseId(id);
+    return false;
+}
+
+template<class Provider>
+std::optional<typename JournaledIdProvider<Provider>::Type> JournaledIdProvider<Provider>::takeNextId()
+{
+    // ) An exhausted provider return MAX, that must neither be handed out nor journaled
+    if(!_provider.areIdsAvailables())
+        return std::nullopt;
+
+    // ) Journaled as the id taken, so that replay doesn't depend on the storage policy
+    const auto id = _provider.takeNextId();
+    if(append(TAKE, id))
+        return id;
+    _provider.releaseId(id);
+    return std::nullopt;
+}
+
+template<class Provider>
+bool JournaledIdProvider<Provider>::releaseId(const Type id)
+{
+    // ) Journaled first, a release can't fail once its record is committed
+    assert(_provider.isIdTaken(id));
+    if(!append(RELEASE, id))
+        return false;
+    _provider.releaseId(id);
+    return true;
+}
+
+template<class Provider>
+bool JournaledIdProvider<Provider>::clear()
+{
+    if(!append(CLEAR))
+        return false;
+    _provider.clear();
+    return true;
+}
+
+template<class Provider>
+bool JournaledIdProvider<Provider>::commit()
+{
+    if(!_pendingCount)
+        return true;
+    assert(isOpen());
+    if(_failed)
+        return false;
+
+    IdJournalBatch batch;
+    batch.size = static_cast<std::uint32_t>(_pending.size());
+    batch.checksum = detail::journalChecksum(_pending.data(), _pending.size());
+    if(std::fwrite(&batch, sizeof(batch), 1, _journal) != 1
+        || std::fwrite(_pending.data(), 1, _pending.size(), _journal) != _pending.size()
+        || !detail::syncFile(_journal))
+    {
+        // ) Recovery stop at the first torn batch: cut it, so that the next batches are replayed
+        _failed = !detail::truncateFile(_journal, _committedSize);
+        return false;
+    }
+
+    _committedSize += sizeof(batch) + _pending.size();
+    _pending.clear();
+    _pendingCount = 0;
+    return true;
+}
+
+template<class Provider>
+bool JournaledIdProvider<Provider>::checkpoint()
+{
+    IdJournalHeader header;
+    header.magic = IdJournalHeader::CHECKPOINT_MAGIC;
+    header.version = IdJournalHeader::VERSION;
+    header.reserved = 0;
+    header.generation = _generation + 1;
+
+    std::vector<unsigned char> content(sizeof(IdJournalHeader) + _provider.serializedSize());
+    detail::writeSnapshot(content.data(), header);
+    _provider.serialize(content.data() + sizeof(IdJournalHeader), content.size() - sizeof(IdJournalHeader));
+
+    // ) Write aside then rename, a crash leave either the old or the new checkpoint
+    const auto temporaryPath = _checkpointPath + ".tmp";
+    auto* file = std::fopen(temporaryPath.c_str(), "wb");
+    if(!file)
+        return false;
+    const auto written = std::fwrite(content.data(), 1, content.size(), file) == content.size()
+        && detail::syncFile(file);
+    std::fclose(file);
+#if defined(_WIN32)
+    std::remove(_checkpointPath.c_str());
+#endif
+    if(!written || std::rename(temporaryPath.c_str(), _checkpointPath.c_str()) != 0)
+        return false;
+
+    // ) The new checkpoint may already hide the old journal, nothing must be committed there anymore
+    if(!detail::syncDirectory(_checkpointPath))
+    {
+        _failed = true;
+        return false;
+    }
+
+    // ) Records are in the snapshot, they don't need to be written.
+    // ) The old journal is now ignored because of its generation, it can be truncated
+    _pending.clear();
+    _pendingCount = 0;
+    _generation = header.generation;
+    if(_journal)
+        std::fclose(_journal);
+    _journal = std::fopen(_journalPath.c_str(), "wb");
+    if(!_journal)
+        return false;
+
+    // ) Unbuffered, so that a failed batch leave nothing in the stream to flush after the cut
+    std::setvbuf(_journal, nullptr, _IONBF, 0);
+    header.magic = IdJournalHeader::JOURNAL_MAGIC;
+    if(std::fwrite(&header, sizeof(header), 1, _journal) != 1 || !detail::syncFile(_journal))
+    {
+        std::fclose(_journal);
+        _journal = nullptr;
+        return false;
+    }
+    _committedSize = sizeof(header);
+    _failed = false;
+    return true;
+}
+
+}
+
+#endif
@@ -0,0 +1,371 @@
+#ifndef __UNIQUE_LEASED_ID_PROVIDER_HPP__
+#define __UNIQUE_LEASED_ID_PROVIDER_HPP__
+
+// ─────────────────────────────────────────────────────────────
+//                  INCLUDE
+// ─────────────────────────────────────────────────────────────
+
+#include <Unique/Bits.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+// ─────────────────────────────────────────────────────────────
+//                  DECLARATION
+// ─────────────────────────────────────────────────────────────
+
+namespace unique {
+
+// ─────────────────────────────────────────────────────────────
+//                  CLASS
+// ─────────────────────────────────────────────────────────────
+
+/**
+ * Lease the ids of a Provider for a time to live, and reclaim the ids that aren't renewed in time.
+ * Time is counted in ticks given by the caller, for example milliseconds of a steady clock.
+ *
+ * Leases are kept in a hierarchical timer wheel of 4 levels of 64 slots: level n hold the leases
+ * expiring in the current window of 64^(n + 1) ticks, a slot being 64^n ticks wide. Leases further
+ * than 2^24 ticks wait in an overflow list, looked at once every 2^24 ticks. When time reach a slot
+ * of level n, its leases cascade to lower levels, each lease cascade at most 4 times.
+ * Each lease is a node of an intrusive list indexed by id, so lease, renew and release are O(1)
+ * whatever the count of leases. advance jump from one non empty slot to the next with a bit scan.
+ */
+template<class Provider>
+class LeasedIdProvider
+{
+public:
+    using ProviderType = Provider;
+    using Type = typename Provider::Type;
+    using Tick = std::uint64_t;
+
+    static constexpr unsigned LEVEL_COUNT = 4;
+    static constexpr unsigned SLOT_BITS = 6;
+    static constexpr unsigned SLOT_COUNT = 1u << SLOT_BITS;
+
+    explicit LeasedIdProvider(const Tick now = 0) : _now(now)
+    {
+        std::fill(std::begin(_heads), std::end(_heads), NONE);
+    }
+
+private:
+    using Word = std::uint64_t;
+
+    static constexpr std::size_t NONE = std::size_t(-1);
+    /** List of the leases too far to fit in the wheel */
+    static constexpr std::size_t OVERFLOW_LIST = LEVEL_COUNT * SLOT_COUNT;
+    /** list of an id without lease */
+    static constexpr std::size_t NOT_LEASED = OVERFLOW_LIST + 1;
+
+    struct Lease
+    {
+        Tick deadline = 0;
+        Tick ttl = 0;
+        std::size_t prev = NONE;
+        std::size_t next = NONE;
+        /** Slot of the wheel holding the lease: level * SLOT_COUNT + slot, or OVERFLOW_LIST */
+        std::size_t list = NOT_LEASED;
+    };
+
+    Provider _provider;
+    Tick _now;
+    /** Lease of each id, indexed by offset from Provider MIN */
+    std::vector<Lease> _leases;
+    /** First lease of each slot, then of the overflow list */
+    std::size_t _heads[LEVEL_COUNT * SLOT_COUNT + 1];
+    /** Bit set for each non empty slot of each level */
+    Word _occupied[LEVEL_COUNT] = {};
+    std::size_t _leaseCount = 0;
+
+private:
+    std::size_t offsetOf(const Type id) const { return static_cast<std::size_t>(id - _provider.MIN); }
+
+    Type idOf(const std::size_t offset) const { return _provider.MIN + static_cast<Type>(offset); }
+
+    /** Link offset in the slot matching its deadline */
+    void link(const std::size_t offset);
+
+    void unlink(const std::size_t offset);
+
+    /** Start or restart the lease of id */
+    void lease(const Type id, const Tick ttl);
+
+    /** Move every lease of list to the slot matching its deadline */
+    void cascade(const std::size_t list);
+
+    /** Next tick after _now where a slot has to be processed, or now if there is none before */
+    Tick nextEvent(const Tick now) const;
+
+    // ──────── C++ API ──────────
+public:
+    /** \brief Wrapped provider, to query it. Ids must not be released directly */
+    const Provider& provider() const { return _provider; }
+
+    /** \brief Current tick, the last one given to advance */
+    Tick now() const { return _now; }
+
+    /**
+     * \brief Take the next id with a lease of ttl ticks. ttl must not be 0.
+     * The function assert like Provider::takeNextId if every id is taken
+     */
+    Type takeNextId(const Tick ttl);
+
+    /** \brief Take id with a lease of ttl ticks. \return false if id is already taken */
+    bool takeId(const Type id, const Tick ttl);
+
+    /** \brief Extend the lease of id to now + its ttl. \return false if id isn't leased */
+    bool renew(const Type id);
+
+    /** \brief Extend the lease of id to now + ttl, the new ttl is kept for next renewals */
+    bool renew(const Type id, const Tick ttl);
+
+    /** \brief Cancel the lease of id and release it */
+    void releaseId(const Type id);
+
+    /**
+     * \brief Move time to now, release every id whose lease expire at or before now
+     * \param expired Output iterator receiving the released ids, to clean their associated state
+     * \return Output iterator past the last written id
+     */
+    template<class OutputIt>
+    OutputIt advance(const Tick now, OutputIt expired);
+
+    /** \brief Get if id has a lease */
+    bool isLeased(const Type id) const;
+
+    /** \brief Tick at which the lease of id expire. id must be leased */
+    Tick deadlineOf(const Type id) const;
+
+    /** \brief Count of leased ids */
+    std::size_t countOfLeases() const { return _leaseCount; }
+};
+
+template<class Provider>
+constexpr unsigned LeasedIdProvider<Provider>::LEVEL_COUNT;
+template<class Provider>
+constexpr unsigned LeasedIdProvider<Provider>::SLOT_BITS;
+template<class Provider>
+constexpr unsigned LeasedIdProvider<Provider>::SLOT_COUNT;
+template<class Provider>
+constexpr std::size_t LeasedIdProvider<Provider>::NONE;
+template<class Provider>
+constexpr std::size_t LeasedIdProvider<Provider>::OVERFLOW_LIST;
+template<class Provider>
+constexpr std::size_t LeasedIdProvider<Provider>::NOT_LEASED;
+
+template<class Provider>
+void LeasedIdProvider<Provider>::link(const std::size_t offset)
+{
+    // ) A cascade link leases expiring now in the current slot of level 0, processed right after
+    auto& lease = _leases[offset];
+    assert(lease.deadline >= _now);
+
+    // ) The lowest level whose window hold both now and the deadline
+    const auto diff = lease.deadline ^ _now;
+    std::size_t list = OVERFLOW_LIST;
+    for(unsigned level = 0; level < LEVEL_COUNT; ++level)
+    {
+        if(diff >> (SLOT_BITS * (level + 1)) == 0)
+        {
+            const auto slot = static_cast<unsigned>((lease.deadline >> (SLOT_BITS * level)) % SLOT_COUNT);
+            list = level * SLOT_COUNT + slot;
+            _occupied[level] |= Word(1) << slot;
+            break;
+        }
+    }
+
+    lease.list = list;
+    lease.prev = NONE;
+    lease.next = _heads[list];
+    if(lease.next != NONE)
+        _leases[lease.next].prev = offset;
+    _heads[list] = offset;
+}
+
+template<class Provider>
+void LeasedIdProvider<Provider>::unlink(const std::size_t offset)
+{
+    auto& lease = _leases[offset];
+    assert(lease.list != NOT_LEASED);
+    if(lease.prev != NONE)
+        _leases[lease.prev].next = lease.next;
+    else
+        _heads[lease.list] = lease.next;
+    if(lease.next != NONE)
+        _leases[lease.next].prev = lease.prev;
+
+    if(lease.list != OVERFLOW_LIST && _heads[lease.list] == NONE)
+        _occupied[lease.list / SLOT_COUNT] &= ~(Word(1) << (lease.list % SLOT_COUNT));
+    lease.list = NOT_LEASED;
+}
+
+template<class Provider>
+void LeasedIdProvider<Provider>::lease(const Type id, const Tick ttl)
+{
+    assert(ttl > 0);
+    const auto offset = offsetOf(id);
+    if(offset >= _leases.size())
+        _leases.resize(offset + 1);
+
+    auto& lease = _leases[offset];
+    if(lease.list != NOT_LEASED)
+        unlink(offset);
+    else
+        ++_leaseCount;
+    lease.ttl = ttl;
+    lease.deadline = _now + ttl;
+    link(offset);
+}
+
+template<class Provider>
+void LeasedIdProvider<Provider>::cascade(const std::size_t list)
+{
+    auto offset = _heads[list];
+    _heads[list] = NONE;
+    if(list != OVERFLOW_LIST)
+        _occupied[list / SLOT_COUNT] &= ~(Word(1) << (list % SLOT_COUNT));
+    while(offset != NONE)
+    {
+        const auto next = _leases[offset].next;
+        link(offset);
+        offset = next;
+    }
+}
+
+template<class Provider>
+typename LeasedIdProvider<Provider>::Tick LeasedIdProvider<Provider>::nextEvent(const Tick now) const
+{
+    auto next = now;
+    for(unsigned level = 0; level < LEVEL_COUNT; ++level)
+    {
+        // ) Slots of a level after the current one are reached in the current window of the level above
+        const auto shift = SLOT_BITS * level;
+        const auto current = static_cast<unsigned>((_now >> shift) % SLOT_COUNT);
+        if(current + 1 == SLOT_COUNT)
+            continue;
+        const auto after = _occupied[level] & (~Word(0) << (current + 1));
+        if(!after)
+            continue;
+        const auto window = _now >> (shift + SLOT_BITS) << (shift + SLOT_BITS);
+        next = std::min(next, window + (Tick(detail::countTrailingZeros(after)) << shift));
+    }
+    if(_heads[OVERFLOW_LIST] != NONE)
+    {
+        const auto shift = SLOT_BITS * LEVEL_COUNT;
+        next = std::min(next, ((_now >> shift) + 1) << shift);
+    }
+    return next;
+}
+
+template<class Provider>
+typename LeasedIdProvider<Provider>::Type LeasedIdProvider<Provider>::takeNextId(const Tick ttl)
+{
+    const auto id = _provider.takeNextId();
+    lease(id, ttl);
+    return id;
+}
+
+template<class Provider>
+bool LeasedIdProvider<Provider>::takeId(const Type id, const Tick ttl)
+{
+    if(!_provider.takeId(id))
+        return false;
+    lease(id, ttl);
+    return true;
+}
+
+template<class Provider>
+bool LeasedIdProvider<Provider>::renew(const Type id)
+{
+    if(!isLeased(id))
+        return false;
+    lease(id, _leases[offsetOf(id)].ttl);
+    return true;
+}
+
+template<class Provider>
+bool LeasedIdProvider<Provider>::renew(const Type id, const Tick ttl)
+{
+    if(!isLeased(id))
+        return false;
+    lease(id, ttl);
+    return true;
+}
+
+template<class Provider>
+void LeasedIdProvider<Provider>::releaseId(const Type id)
+{
+    if(isLeased(id))
+    {
+        unlink(offsetOf(id));
+        --_leaseCount;
+    }
+    _provider.releaseId(id);
+}
+
+template<class Provider>
+template<class OutputIt>
+OutputIt LeasedIdProvider<Provider>::advance(const Tick now, OutputIt expired)
+{
+    if(!_leaseCount)
+    {
+        _now = std::max(_now, now);
+        return expired;
+    }
+
+    while(_now < now)
+    {
+        _now = nextEvent(now);
+
+        // ) Higher levels first, so that leases cascading to the current slot of level 0 expire now
+        if(_now % (Tick(1) << (SLOT_BITS * LEVEL_COUNT)) == 0)
+            cascade(OVERFLOW_LIST);
+        for(auto level = LEVEL_COUNT; level-- > 1;)
+        {
+            const auto shift = SLOT_BITS * level;
+            if(_now % (Tick(1) << shift) == 0)
+                cascade(level * SLOT_COUNT + static_cast<std::size_t>((_now >> shift) % SLOT_COUNT));
+        }
+
+        const auto list = static_cast<std::size_t>(_now % SLOT_COUNT);
+        auto offset = _heads[list];
+        _heads[list] = NONE;
+        _occupied[0] &= ~(Word(1) << list);
+        while(offset != NONE)
+        {
+            auto& lease = _leases[offset];
+            assert(lease.deadline == _now);
+            const auto next = lease.next;
+            lease.list = NOT_LEASED;
+            --_leaseCount;
+
+            const auto id = idOf(offset);
+            _provider.releaseId(id);
+            *expired++ = id;
+            offset = next;
+        }
+    }
+    return expired;
+}
+
+template<class Provider>
+bool LeasedIdProvider<Provider>::isLeased(const Type id) const
+{
+    const auto offset = offsetOf(id);
+    return offset < _leases.size() && _leases[offset].list != NOT_LEASED;
+}
+
+template<class Provider>
+typename LeasedIdProvider<Provider>::Tick LeasedIdProvider<Provider>::deadlineOf(const Type id) const
+{
+    assert(isLeased(id));
+    return _leases[offsetOf(id)].deadline;
+}
+
+}
+
+#endif
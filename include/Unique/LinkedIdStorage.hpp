@@ -0,0 +1,390 @@
+#ifndef __UNIQUE_LINKED_ID_STORAGE_HPP__
+#define __UNIQUE_LINKED_ID_STORAGE_HPP__
+
+// ─────────────────────────────────────────────────────────────
+//                  INCLUDE
+// ─────────────────────────────────────────────────────────────
+
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+// ─────────────────────────────────────────────────────────────
+//                  DECLARATION
+// ─────────────────────────────────────────────────────────────
+
+namespace unique {
+
+// ─────────────────────────────────────────────────────────────
+//                  CLASS
+// ─────────────────────────────────────────────────────────────
+
+/** Order in which a LinkedIdStorage hand out its ids */
+enum class LinkedIdOrder
+{
+    /** Last released first: the hottest slot of arrays indexed by id is reused */
+    Lifo,
+    /** First released first: an id is reused as late as possible */
+    Fifo,
+};
+
+/**
+ * Storage of the available ids of an IdProvider as an intrusive doubly linked list, stored in a
+ * vector indexed by id offset from base. insert, erase, contains, front and popFront are O(1).
+ * Memory is two std::size_t (16 bytes on 64 bits) per id up to the highest id ever made available,
+ * whether they are available or not: prefer BitmapIdStorage or IntervalIdStorage for wide sparse ranges.
+ * The list doesn't keep ids sorted, so findNear, popContiguous and forEachRun scan the links: use
+ * BitmapIdStorage or IntervalIdStorage for takeIdNear heavy workloads.
+ *
+ * With a Quarantine, the Quarantine last released ids are never handed out: they are available for
+ * contains and erase, but not counted by size(), and the provider take new ids from its counter instead.
+ * popContiguous only reuse ids when there is no quarantine, since it doesn't follow the order.
+ */
+template<typename T, LinkedIdOrder Order, std::size_t Quarantine = 0>
+class LinkedIdStorage
+{
+public:
+    /** The provider never shrink its counter, so that released ids go through the list */
+    static constexpr bool LOWEST_FIRST = false;
+
+    explicit LinkedIdStorage(const T base = T()) : _base(base) {}
+
+private:
+    static constexpr std::size_t NONE = std::size_t(-1);
+    /** prev of an offset that isn't in the list */
+    static constexpr std::size_t UNLINKED = std::size_t(-2);
+
+    struct Link
+    {
+        std::size_t prev = UNLINKED;
+        std::size_t next = NONE;
+    };
+
+    /** Id matching offset 0 */
+    T _base;
+    std::vector<Link> _links;
+    /** Next offset to hand out */
+    std::size_t _head = NONE;
+    /** Offset handed out last */
+    std::size_t _tail = NONE;
+    std::size_t _size = 0;
+
+private:
+    std::size_t offsetOf(const T id) const
+    {
+        assert(id >= _base);
+        return static_cast<std::size_t>(id - _base);
+    }
+
+    bool isLinked(const std::size_t offset) const
+    {
+        return offset < _links.size() && _links[offset].prev != UNLINKED;
+    }
+
+    /** Link offset at the end handed out first (Lifo) or last (Fifo) */
+    void link(const std::size_t offset);
+
+    void unlink(const std::size_t offset);
+
+public:
+    /** Get if no id can be handed out. Ids in quarantine can't */
+    bool empty() const { return _size <= Quarantine; }
+
+    /** Count of ids that can be handed out, ids in quarantine excluded */
+    std::size_t size() const { return _size - quarantinedCount(); }
+
+    /** Count of available ids in quarantine, at most Quarantine */
+    std::size_t quarantinedCount() const { return _size < Quarantine ? _size : Quarantine; }
+
+    /** Get if id is available */
+    bool contains(const T id) const { return id >= _base && isLinked(offsetOf(id)); }
+
+    /** Make id available. id must not already be available */
+    void insert(const T id);
+
+    /** Make every id in [first, last) available, first is handed out first among them */
+    void insertRange(const T first, const T last);
+
+    /**
+     * \brief Remove id from the available ids
+     * \return false if id wasn't available
+     */
+    bool erase(const T id);
+
+    /**
+     * \brief Remove the run of available ids that end right before end.
+     * \return First id of the removed run, or end if end - 1 isn't available
+     */
+    T eraseRunEndingAt(const T end);
+
+    /** Next id to hand out. Storage must not be empty */
+    T front() const
+    {
+        assert(!empty());
+        return _base + static_cast<T>(_head);
+    }
+
+    /** Remove and return front(). Storage must not be empty */
+    T popFront();
+
+    /**
+     * \brief Remove front() and the ids that follow it in the list as long as they are consecutive,
+     * up to maxCount ids
+     * \param first Receive the first removed id
+     * \return Count of removed ids, [first, first + count) were removed
+     */
+    std::size_t popFrontRun(const std::size_t maxCount, T& first);
+
+    /**
+     * \brief Remove the lowest run of at least count consecutive available ids. O(highest id)
+     * \param first Receive the first removed id, [first, first + count) were removed
+     * \return false if there is no such run, or if there is a quarantine
+     */
+    bool popContiguous(const std::size_t count, T& first);
+
+    /**
+     * \brief Find the available id closest to hint, the lowest one on a tie.
+     * O(distance to the id), that is O(highest id) when few ids are available
+     * \return false if the storage is empty, or if there is a quarantine
+     */
+    bool findNear(const T hint, T& id) const;
+
+    /**
+     * Call function(first, last) for each run of consecutive available ids, lowest first.
+     * O(highest id)
+     */
+    template<class Function>
+    void forEachRun(Function function) const;
+
+    /** Remove every available id. Allocated links are kept for reuse */
+    void clear();
+};
+
+template<typename T, LinkedIdOrder Order, std::size_t Quarantine>
+constexpr bool LinkedIdStorage<T, Order, Quarantine>::LOWEST_FIRST;
+template<typename T, LinkedIdOrder Order, std::size_t Quarantine>
+constexpr std::size_t LinkedIdStorage<T, Order, Quarantine>::NONE;
+template<typename T, LinkedIdOrder Order, std::size_t Quarantine>
+constexpr std::size_t LinkedIdStorage<T, Order, Quarantine>::UNLINKED;
+
+/** Hand out the last released id first */
+template<typename T>
+using LifoIdStorage = LinkedIdStorage<T, LinkedIdOrder::Lifo>;
+
+/** Hand out the first released id first */
+template<typename T>
+using FifoIdStorage = LinkedIdStorage<T, LinkedIdOrder::Fifo>;
+
+/**
+ * Fifo storage that never hand out the Quarantine last released ids.
+ * Use it as IdProvider<T, min, max, QuarantineFifoIdStorage<1024>::Storage>
+ */
+template<std::size_t Quarantine>
+struct QuarantineFifoIdStorage
+{
+    template<typename T>
+    using Storage = LinkedIdStorage<T, LinkedIdOrder::Fifo, Quarantine>;
+};
+
+template<typename T, LinkedIdOrder Order, std::size_t Quarantine>
+void LinkedIdStorage<T, Order, Quarantine>::link(const std::size_t offset)
+{
+    if(offset >= _links.size())
+        _links.resize(offset + 1);
+    assert(!isLinked(offset));
+
+    auto& node = _links[offset];
+    if(Order == LinkedIdOrder::Lifo)
+    {
+        // ) Push at the head
+        node.prev = NONE;
+        node.next = _head;
+        if(_head != NONE)
+            _links[_head].prev = offset;
+        else
+            _tail = offset;
+        _head = offset;
+    }
+    else
+    {
+        // ) Push at the tail
+        node.prev = _tail;
+        node.next = NONE;
+        if(_tail != NONE)
+            _links[_tail].next = offset;
+        else
+            _head = offset;
+        _tail = offset;
+    }
+    ++_size;
+}
+
+template<typename T, LinkedIdOrder Order, std::size_t Quarantine>
+void LinkedIdStorage<T, Order, Quarantine>::unlink(const std::size_t offset)
+{
+    assert(isLinked(offset));
+    auto& node = _links[offset];
+    if(node.prev != NONE)
+        _links[node.prev].next = node.next;
+    else
+        _head = node.next;
+    if(node.next != NONE)
+        _links[node.next].prev = node.prev;
+    else
+        _tail = node.prev;
+    node.prev = UNLINKED;
+    node.next = NONE;
+    --_size;
+}
+
+template<typename T, LinkedIdOrder Order, std::size_t Quarantine>
+void LinkedIdStorage<T, Order, Quarantine>::insert(const T id)
+{
+    link(offsetOf(id));
+}
+
+template<typename T, LinkedIdOrder Order, std::size_t Quarantine>
+void LinkedIdStorage<T, Order, Quarantine>::insertRange(const T first, const T last)
+{
+    if(first >= last)
+        return;
+    const auto from = offsetOf(first);
+    const auto to = offsetOf(last);
+    if(to > _links.size())
+        _links.resize(to);
+
+    // ) Lifo hand out the last linked first, so the range is linked from the top
+    if(Order == LinkedIdOrder::Lifo)
+    {
+        for(auto offset = to; offset-- > from;)
+            link(offset);
+    }
+    else
+    {
+        for(auto offset = from; offset < to; ++offset)
+            link(offset);
+    }
+}
+
+template<typename T, LinkedIdOrder Order, std::size_t Quarantine>
+bool LinkedIdStorage<T, Order, Quarantine>::erase(const T id)
+{
+    if(!contains(id))
+        return false;
+    unlink(offsetOf(id));
+    return true;
+}
+
+template<typename T, LinkedIdOrder Order, std::size_t Quarantine>
+T LinkedIdStorage<T, Order, Quarantine>::eraseRunEndingAt(const T end)
+{
+    auto first = end;
+    while(first > _base && erase(first - 1)) --first;
+    return first;
+}
+
+template<typename T, LinkedIdOrder Order, std::size_t Quarantine>
+T LinkedIdStorage<T, Order, Quarantine>::popFront()
+{
+    const auto id = front();
+    unlink(_head);
+    return id;
+}
+
+template<typename T, LinkedIdOrder Order, std::size_t Quarantine>
+std::size_t LinkedIdStorage<T, Order, Quarantine>::popFrontRun(const std::size_t maxCount, T& first)
+{
+    assert(maxCount);
+    first = popFront();
+    const auto from = offsetOf(first);
+    std::size_t count = 1;
+    while(count < maxCount && !empty() && _head == from + count)
+    {
+        unlink(_head);
+        ++count;
+    }
+    return count;
+}
+
+template<typename T, LinkedIdOrder Order, std::size_t Quarantine>
+bool LinkedIdStorage<T, Order, Quarantine>::popContiguous(const std::size_t count, T& first)
+{
+    assert(count);
+    if(Quarantine || _size < count)
+        return false;
+
+    std::size_t length = 0;
+    for(std::size_t offset = 0; offset < _links.size(); ++offset)
+    {
+        length = isLinked(offset) ? length + 1 : 0;
+        if(length == count)
+        {
+            const auto from = offset + 1 - count;
+            for(auto i = from; i <= offset; ++i)
+                unlink(i);
+            first = _base + static_cast<T>(from);
+            return true;
+        }
+    }
+    return false;
+}
+
+template<typename T, LinkedIdOrder Order, std::size_t Quarantine>
+bool LinkedIdStorage<T, Order, Quarantine>::findNear(const T hint, T& id) const
+{
+    if(Quarantine || !_size)
+        return false;
+
+    // ) The list doesn't keep ids sorted, look around hint in the links.
+    // ) Nothing is linked above the links, a hint there start from the last one
+    const auto offset = offsetOf(hint);
+    for(auto distance = offset < _links.size() ? 0 : offset - _links.size() + 1;; ++distance)
+    {
+        if(distance <= offset && isLinked(offset - distance))
+        {
+            id = hint - static_cast<T>(distance);
+            return true;
+        }
+        if(isLinked(offset + distance))
+        {
+            id = hint + static_cast<T>(distance);
+            return true;
+        }
+    }
+}
+
+template<typename T, LinkedIdOrder Order, std::size_t Quarantine>
+template<class Function>
+void LinkedIdStorage<T, Order, Quarantine>::forEachRun(Function function) const
+{
+    std::size_t offset = 0;
+    while(offset < _links.size())
+    {
+        if(!isLinked(offset))
+        {
+            ++offset;
+            continue;
+        }
+        const auto from = offset;
+        while(offset < _links.size() && isLinked(offset)) ++offset;
+        function(_base + static_cast<T>(from), _base + static_cast<T>(offset));
+    }
+}
+
+template<typename T, LinkedIdOrder Order, std::size_t Quarantine>
+void LinkedIdStorage<T, Order, Quarantine>::clear()
+{
+    for(auto offset = _head; offset != NONE;)
+    {
+        const auto next = _links[offset].next;
+        _links[offset] = Link();
+        offset = next;
+    }
+    _head = NONE;
+    _tail = NONE;
+    _size = 0;
+}
+
+}
+
+#endif
@@ -6,6 +6,8 @@
 // ─────────────────────────────────────────────────────────────
 
 #include <Unique/TMap.hpp>
+#include <Unique/TransparentKey.hpp>
+
 #include <map>
 
 // ─────────────────────────────────────────────────────────────
@@ -18,11 +20,29 @@ namespace unique {
 //                  CLASS
 // ─────────────────────────────────────────────────────────────
 
+namespace detail {
+
+/** std::map with a transparent compare */
+template<class Key, class Value, class...>
+using TransparentStdMap = std::map<Key, Value, TransparentLess>;
+
+}
+
 template<class Key1, class Key2>
 class Map : public TMap<std::map, std::map, Key1, Key2>
 {
 };
 
+/**
+ * Map on two std::map with TransparentLess: find, contains and erase accept lookup keys without
+ * building a key, std::string_view for std::string keys and raw pointers for smart pointer keys. See KeyLookup.
+ * Key1Map is std::map<Key1, Key2, TransparentLess>, so keys are ordered by their lookup view.
+ */
+template<class Key1, class Key2>
+class TransparentMap : public TMap<detail::TransparentStdMap, detail::TransparentStdMap, Key1, Key2>
+{
+};
+
 }
 
 #endif
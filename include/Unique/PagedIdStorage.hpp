@@ -0,0 +1,574 @@
+#ifndef __UNIQUE_PAGED_ID_STORAGE_HPP__
+#define __UNIQUE_PAGED_ID_STORAGE_HPP__
+
+// ─────────────────────────────────────────────────────────────
+//                  INCLUDE
+// ─────────────────────────────────────────────────────────────
+
+#include <Unique/Bits.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+// ─────────────────────────────────────────────────────────────
+//                  DECLARATION
+// ─────────────────────────────────────────────────────────────
+
+namespace unique {
+
+// ─────────────────────────────────────────────────────────────
+//                  CLASS
+// ─────────────────────────────────────────────────────────────
+
+/**
+ * Storage of the available ids of an IdProvider as a sparse radix tree, for 64-bit ids taken at
+ * scattered points of the id space.
+ * Each node has 64 children, a node of level 1 is a page of 64 words holding one bit per id. For
+ * each child a node keep two bits: the child has an available id, every id of the child is
+ * available. Children where every id is available or every id is taken are uniform: they are only
+ * those two bits, never allocated, whatever their size. A child is allocated when it become
+ * partially available, and freed as soon as it is uniform again.
+ * Memory scale with the count of clusters of ids, each one costing at most a page per level.
+ * Every operation cost one or two bit scans per level, 10 levels for 64-bit ids.
+ */
+template<typename T>
+class PagedIdStorage
+{
+public:
+    using Word = std::uint64_t;
+    static constexpr unsigned WORD_BITS = 64;
+    /** Ids are handed out lowest first, the provider can shrink its counter */
+    static constexpr bool LOWEST_FIRST = true;
+
+    explicit PagedIdStorage(const T base = T()) : _base(base), _root(makeNode(ROOT_LEVEL, false)) {}
+
+private:
+    static constexpr unsigned ID_BITS = sizeof(T) * CHAR_BIT;
+    /** A node of level n cover 64^(n + 1) ids, the root cover every id of T */
+    static constexpr unsigned ROOT_LEVEL = (ID_BITS + 5) / 6 - 1;
+    /** Children of the root that hold ids of T */
+    static constexpr Word ROOT_CHILDREN = ID_BITS - 6 * ROOT_LEVEL == 6 ? ~Word(0)
+        : (Word(1) << (Word(1) << (ID_BITS - 6 * ROOT_LEVEL))) - 1;
+
+    struct Node
+    {
+        /** Bit set for each child with at least one available id */
+        Word anyAvailable = 0;
+        /** Bit set for each child where every id is available */
+        Word allAvailable = 0;
+        /** Count of available ids in the node */
+        std::uint64_t count = 0;
+        /** Level 1: one bit per id */
+        std::unique_ptr<Word[]> words;
+        /** Level 2 and more: children that are partially available, null otherwise */
+        std::unique_ptr<std::unique_ptr<Node>[]> children;
+    };
+
+    /** Id matching offset 0 */
+    T _base;
+    std::unique_ptr<Node> _root;
+    std::size_t _countOfNodes = 0;
+
+private:
+    std::uint64_t offsetOf(const T id) const
+    {
+        assert(id >= _base);
+        return static_cast<std::uint64_t>(id - _base);
+    }
+
+    T idOf(const std::uint64_t offset) const { return _base + static_cast<T>(offset); }
+
+    /** Count of ids covered by a child of a node of level */
+    static std::uint64_t childSpan(const unsigned level) { return std::uint64_t(1) << (6 * level); }
+
+    /** Node of level where every id is available or every id is taken */
+    std::unique_ptr<Node> makeNode(const unsigned level, const bool available);
+
+    /** Count of available ids in child of node */
+    static std::uint64_t countOf(const Node& node, const unsigned level, const unsigned child);
+
+    /**
+     * Make [first, last) available or taken, offsets relative to node.
+     * Children that become uniform are freed
+     */
+    void assign(Node& node, const unsigned level, std::uint64_t first, std::uint64_t last, const bool available);
+
+    /** Lowest offset >= from, relative to node, that is available (or taken) */
+    bool findNext(const Node& node, const unsigned level, const std::uint64_t from, const bool available,
+        std::uint64_t& offset) const;
+
+    /** Highest offset <= from, relative to node, that is available (or taken) */
+    bool findPrevious(const Node& node, const unsigned level, const std::uint64_t from, const bool available,
+        std::uint64_t& offset) const;
+
+    /** End of the run of available ids starting at offset */
+    std::uint64_t runEnd(const std::uint64_t offset) const;
+
+public:
+    PagedIdStorage(PagedIdStorage&&) = default;
+    PagedIdStorage& operator=(PagedIdStorage&&) = default;
+
+    /** Get if there is no available id */
+    bool empty() const { return _root->count == 0; }
+
+    /** Count of available ids */
+    std::size_t size() const { return static_cast<std::size_t>(_root->count); }
+
+    /** Count of allocated nodes, root included. Memory is about 528 bytes per node */
+    std::size_t countOfNodes() const { return _countOfNodes; }
+
+    /** Get if id is available */
+    bool contains(const T id) const;
+
+    /** Make id available. id must not already be available */
+    void insert(const T id);
+
+    /** Make every id in [first, last) available. O(levels) nodes are touched */
+    void insertRange(const T first, const T last);
+
+    /**
+     * \brief Remove id from the available ids
+     * \return false if id wasn't available
+     */
+    bool erase(const T id);
+
+    /**
+     * \brief Remove the run of available ids that end right before end.
+     * \return First id of the removed run, or end if end - 1 isn't available
+     */
+    T eraseRunEndingAt(const T end);
+
+    /** Lowest available id. Storage must not be empty */
+    T front() const;
+
+    /** Remove and return the lowest available id. Storage must not be empty */
+    T popFront();
+
+    /**
+     * \brief Remove the lowest run of consecutive available ids, up to maxCount ids
+     * \param first Receive the first removed id
+     * \return Count of removed ids, [first, first + count) were removed
+     */
+    std::size_t popFrontRun(const std::size_t maxCount, T& first);
+
+    /**
+     * \brief Remove the lowest run of at least count consecutive available ids. O(runs)
+     * \param first Receive the first removed id, [first, first + count) were removed
+     * \return false if there is no such run
+     */
+    bool popContiguous(const std::size_t count, T& first);
+
+    /**
+     * \brief Find the available id closest to hint, the lowest one on a tie
+     * \return false if the storage is empty
+     */
+    bool findNear(const T hint, T& id) const;
+
+    /** Call function(first, last) for each run of consecutive available ids, lowest first */
+    template<class Function>
+    void forEachRun(Function function) const;
+
+    /** Remove every available id and free every node */
+    void clear();
+};
+
+template<typename T>
+constexpr unsigned PagedIdStorage<T>::WORD_BITS;
+template<typename T>
+constexpr bool PagedIdStorage<T>::LOWEST_FIRST;
+template<typename T>
+constexpr unsigned PagedIdStorage<T>::ID_BITS;
+template<typename T>
+constexpr unsigned PagedIdStorage<T>::ROOT_LEVEL;
+template<typename T>
+constexpr typename PagedIdStorage<T>::Word PagedIdStorage<T>::ROOT_CHILDREN;
+
+template<typename T>
+std::unique_ptr<typename PagedIdStorage<T>::Node> PagedIdStorage<T>::makeNode(const unsigned level, const bool available)
+{
+    std::unique_ptr<Node> node(new Node());
+    const auto fill = available ? ~Word(0) : Word(0);
+    node->anyAvailable = fill;
+    node->allAvailable = fill;
+    if(level == 1)
+    {
+        node->words.reset(new Word[WORD_BITS]);
+        std::fill(node->words.get(), node->words.get() + WORD_BITS, fill);
+    }
+    else
+    {
+        node->children.reset(new std::unique_ptr<Node>[WORD_BITS]);
+    }
+    // ) Only nodes below the root are created available, the span of the root may not fit 64 bits
+    node->count = available ? childSpan(level) * WORD_BITS : 0;
+    ++_countOfNodes;
+    return node;
+}
+
+template<typename T>
+std::uint64_t PagedIdStorage<T>::countOf(const Node& node, const unsigned level, const unsigned child)
+{
+    const auto bit = Word(1) << child;
+    if(level == 1)
+        return detail::popCount(node.words[child]);
+    if(node.allAvailable & bit)
+        return childSpan(level);
+    if(!(node.anyAvailable & bit))
+        return 0;
+    return node.children[child]->count;
+}
+
+template<typename T>
+void PagedIdStorage<T>::assign(Node& node, const unsigned level, std::uint64_t first, std::uint64_t last,
+    const bool available)
+{
+    assert(first < last);
+    const auto shift = 6 * level;
+    const auto span = childSpan(level);
+    for(auto child = unsigned(first >> shift); child <= unsigned((last - 1) >> shift); ++child)
+    {
+        const auto bit = Word(1) << child;
+        const auto childFirst = std::uint64_t(child) << shift;
+        const auto from = std::max(first, childFirst) - childFirst;
+        const auto to = std::min(last - childFirst, span);
+        const auto before = countOf(node, level, child);
+
+        if(level == 1)
+        {
+            const auto mask = detail::bitRangeMask(unsigned(from), unsigned(to));
+            node.words[child] = available ? node.words[child] | mask : node.words[child] & ~mask;
+        }
+        else if(from == 0 && to == span)
+        {
+            // ) The whole child is assigned, it collapse to its two bits
+            if(node.children[child])
+            {
+                node.children[child].reset();
+                --_countOfNodes;
+            }
+            node.anyAvailable = available ? node.anyAvailable | bit : node.anyAvailable & ~bit;
+            node.allAvailable = available ? node.allAvailable | bit : node.allAvailable & ~bit;
+        }
+        else
+        {
+            auto& childNode = node.children[child];
+            if(!childNode)
+                childNode = makeNode(level - 1, (node.allAvailable & bit) != 0);
+            assign(*childNode, level - 1, from, to, available);
+
+            // ) Free the child once it is uniform again
+            const auto count = childNode->count;
+            node.anyAvailable = count ? node.anyAvailable | bit : node.anyAvailable & ~bit;
+            node.allAvailable = count == span ? node.allAvailable | bit : node.allAvailable & ~bit;
+            if(count == 0 || count == span)
+            {
+                childNode.reset();
+                --_countOfNodes;
+            }
+        }
+
+        if(level == 1)
+        {
+            const auto word = node.words[child];
+            node.anyAvailable = word ? node.anyAvailable | bit : node.anyAvailable & ~bit;
+            node.allAvailable = word == ~Word(0) ? node.allAvailable | bit : node.allAvailable & ~bit;
+        }
+
+        const auto after = countOf(node, level, child);
+        node.count = node.count + after - before;
+    }
+}
+
+template<typename T>
+bool PagedIdStorage<T>::findNext(const Node& node, const unsigned level, const std::uint64_t from,
+    const bool available, std::uint64_t& offset) const
+{
+    const auto shift = 6 * level;
+    auto candidates = available ? node.anyAvailable : ~node.allAvailable;
+    if(level == ROOT_LEVEL)
+        candidates &= ROOT_CHILDREN;
+
+    // ) The child holding from, where only offsets from from count
+    const auto first = unsigned(from >> shift);
+    const auto firstBit = Word(1) << first;
+    if(candidates & firstBit)
+    {
+        const auto childFirst = std::uint64_t(first) << shift;
+        if(level == 1)
+        {
+            const auto word = available ? node.words[first] : ~node.words[first];
+            const auto rest = word & (~Word(0) << (from % WORD_BITS));
+            if(rest)
+            {
+                offset = childFirst + detail::countTrailingZeros(rest);
+                return true;
+            }
+        }
+        else if(available ? (node.allAvailable & firstBit) : !(node.anyAvailable & firstBit))
+        {
+            offset = from;
+            return true;
+        }
+        else if(findNext(*node.children[first], level - 1, from - childFirst, available, offset))
+        {
+            offset += childFirst;
+            return true;
+        }
+    }
+
+    // ) Any following candidate child hold a matching offset
+    if(first + 1 == WORD_BITS)
+        return false;
+    candidates &= ~Word(0) << (first + 1);
+    if(!candidates)
+        return false;
+    const auto child = detail::countTrailingZeros(candidates);
+    const auto bit = Word(1) << child;
+    const auto childFirst = std::uint64_t(child) << shift;
+    if(level == 1)
+    {
+        const auto word = available ? node.words[child] : ~node.words[child];
+        offset = childFirst + detail::countTrailingZeros(word);
+        return true;
+    }
+    if(available ? (node.allAvailable & bit) : !(node.anyAvailable & bit))
+    {
+        offset = childFirst;
+        return true;
+    }
+    const auto found = findNext(*node.children[child], level - 1, 0, available, offset);
+    assert(found);
+    (void)found;
+    offset += childFirst;
+    return true;
+}
+
+template<typename T>
+bool PagedIdStorage<T>::findPrevious(const Node& node, const unsigned level, const std::uint64_t from,
+    const bool available, std::uint64_t& offset) const
+{
+    const auto shift = 6 * level;
+    const auto span = childSpan(level);
+    auto candidates = available ? node.anyAvailable : ~node.allAvailable;
+
+    // ) The child holding from, where only offsets up to from count
+    const auto last = unsigned(from >> shift);
+    const auto lastBit = Word(1) << last;
+    if(candidates & lastBit)
+    {
+        const auto childFirst = std::uint64_t(last) << shift;
+        if(level == 1)
+        {
+            const auto word = available ? node.words[last] : ~node.words[last];
+            const auto rest = word & detail::bitRangeMask(0, unsigned(from % WORD_BITS) + 1);
+            if(rest)
+            {
+                offset = childFirst + detail::highestBit(rest);
+                return true;
+            }
+        }
+        else if(available ? (node.allAvailable & lastBit) : !(node.anyAvailable & lastBit))
+        {
+            offset = from;
+            return true;
+        }
+        else if(findPrevious(*node.children[last], level - 1, from - childFirst, available, offset))
+        {
+            offset += childFirst;
+            return true;
+        }
+    }
+
+    // ) Any preceding candidate child hold a matching offset
+    candidates &= lastBit - 1;
+    if(!candidates)
+        return false;
+    const auto child = detail::highestBit(candidates);
+    const auto bit = Word(1) << child;
+    const auto childFirst = std::uint64_t(child) << shift;
+    if(level == 1)
+    {
+        const auto word = available ? node.words[child] : ~node.words[child];
+        offset = childFirst + detail::highestBit(word);
+        return true;
+    }
+    if(available ? (node.allAvailable & bit) : !(node.anyAvailable & bit))
+    {
+        offset = childFirst + span - 1;
+        return true;
+    }
+    const auto found = findPrevious(*node.children[child], level - 1, span - 1, available, offset);
+    assert(found);
+    (void)found;
+    offset += childFirst;
+    return true;
+}
+
+template<typename T>
+std::uint64_t PagedIdStorage<T>::runEnd(const std::uint64_t offset) const
+{
+    // ) Ids are below the provider MAX, a taken id always follow a run
+    std::uint64_t end = 0;
+    const auto found = findNext(*_root, ROOT_LEVEL, offset, false, end);
+    assert(found);
+    (void)found;
+    return end;
+}
+
+template<typename T>
+bool PagedIdStorage<T>::contains(const T id) const
+{
+    if(id < _base)
+        return false;
+    const auto offset = offsetOf(id);
+    const Node* node = _root.get();
+    for(auto level = ROOT_LEVEL;; --level)
+    {
+        const auto child = unsigned((offset >> (6 * level)) % WORD_BITS);
+        const auto bit = Word(1) << child;
+        if(level == 1)
+            return (node->words[child] >> (offset % WORD_BITS)) & 1;
+        if(node->allAvailable & bit)
+            return true;
+        if(!(node->anyAvailable & bit))
+            return false;
+        node = node->children[child].get();
+    }
+}
+
+template<typename T>
+void PagedIdStorage<T>::insert(const T id)
+{
+    assert(!contains(id));
+    const auto offset = offsetOf(id);
+    assign(*_root, ROOT_LEVEL, offset, offset + 1, true);
+}
+
+template<typename T>
+void PagedIdStorage<T>::insertRange(const T first, const T last)
+{
+    if(first >= last)
+        return;
+    assign(*_root, ROOT_LEVEL, offsetOf(first), offsetOf(last), true);
+}
+
+template<typename T>
+bool PagedIdStorage<T>::erase(const T id)
+{
+    if(!contains(id))
+        return false;
+    const auto offset = offsetOf(id);
+    assign(*_root, ROOT_LEVEL, offset, offset + 1, false);
+    return true;
+}
+
+template<typename T>
+T PagedIdStorage<T>::eraseRunEndingAt(const T end)
+{
+    if(end <= _base || !contains(end - 1))
+        return end;
+
+    // ) The run start right after the highest taken id below end
+    const auto last = offsetOf(end);
+    std::uint64_t taken = 0;
+    const auto first = findPrevious(*_root, ROOT_LEVEL, last - 1, false, taken) ? taken + 1 : 0;
+    assign(*_root, ROOT_LEVEL, first, last, false);
+    return idOf(first);
+}
+
+template<typename T>
+T PagedIdStorage<T>::front() const
+{
+    assert(!empty());
+    std::uint64_t offset = 0;
+    const auto found = findNext(*_root, ROOT_LEVEL, 0, true, offset);
+    assert(found);
+    (void)found;
+    return idOf(offset);
+}
+
+template<typename T>
+T PagedIdStorage<T>::popFront()
+{
+    const auto id = front();
+    const auto offset = offsetOf(id);
+    assign(*_root, ROOT_LEVEL, offset, offset + 1, false);
+    return id;
+}
+
+template<typename T>
+std::size_t PagedIdStorage<T>::popFrontRun(const std::size_t maxCount, T& first)
+{
+    assert(maxCount);
+    first = front();
+    const auto from = offsetOf(first);
+    const auto count = std::min<std::uint64_t>(runEnd(from) - from, maxCount);
+    assign(*_root, ROOT_LEVEL, from, from + count, false);
+    return static_cast<std::size_t>(count);
+}
+
+template<typename T>
+bool PagedIdStorage<T>::popContiguous(const std::size_t count, T& first)
+{
+    assert(count);
+    std::uint64_t from = 0;
+    std::uint64_t runFirst = 0;
+    while(findNext(*_root, ROOT_LEVEL, from, true, runFirst))
+    {
+        const auto end = runEnd(runFirst);
+        if(end - runFirst >= count)
+        {
+            assign(*_root, ROOT_LEVEL, runFirst, runFirst + count, false);
+            first = idOf(runFirst);
+            return true;
+        }
+        from = end;
+    }
+    return false;
+}
+
+template<typename T>
+bool PagedIdStorage<T>::findNear(const T hint, T& id) const
+{
+    if(empty())
+        return false;
+
+    const auto offset = offsetOf(hint);
+    std::uint64_t next = 0;
+    std::uint64_t previous = 0;
+    const auto hasNext = findNext(*_root, ROOT_LEVEL, offset, true, next);
+    const auto hasPrevious = findPrevious(*_root, ROOT_LEVEL, offset, true, previous);
+    if(!hasNext || (hasPrevious && offset - previous <= next - offset))
+        id = idOf(previous);
+    else
+        id = idOf(next);
+    return true;
+}
+
+template<typename T>
+template<class Function>
+void PagedIdStorage<T>::forEachRun(Function function) const
+{
+    std::uint64_t from = 0;
+    std::uint64_t first = 0;
+    while(findNext(*_root, ROOT_LEVEL, from, true, first))
+    {
+        from = runEnd(first);
+        function(idOf(first), idOf(from));
+    }
+}
+
+template<typename T>
+void PagedIdStorage<T>::clear()
+{
+    _countOfNodes = 0;
+    _root = makeNode(ROOT_LEVEL, false);
+}
+
+}
+
+#endif
@@ -0,0 +1,183 @@
+#ifndef __UNIQUE_SET_ID_STORAGE_HPP__
+#define __UNIQUE_SET_ID_STORAGE_HPP__
+
+// ─────────────────────────────────────────────────────────────
+//                  INCLUDE
+// ─────────────────────────────────────────────────────────────
+
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <set>
+
+// ─────────────────────────────────────────────────────────────
+//                  DECLARATION
+// ─────────────────────────────────────────────────────────────
+
+namespace unique {
+
+// ─────────────────────────────────────────────────────────────
+//                  CLASS
+// ─────────────────────────────────────────────────────────────
+
+/**
+ * Storage of the available ids of an IdProvider backed by a std::set.
+ * Every available id is a tree node, ids are handed back lowest first.
+ */
+template<typename T>
+class SetIdStorage
+{
+public:
+    /** Ids are handed out lowest first, the provider can shrink its counter */
+    static constexpr bool LOWEST_FIRST = true;
+
+    explicit SetIdStorage(const T /*base*/ = T()) {}
+
+private:
+    std::set<T> _ids;
+
+public:
+    /** Get if there is no available id */
+    bool empty() const { return _ids.empty(); }
+
+    /** Count of available ids */
+    std::size_t size() const { return _ids.size(); }
+
+    /** Get if id is available */
+    bool contains(const T id) const { return _ids.find(id) != _ids.end(); }
+
+    /** Make id available. id must not already be available */
+    void insert(const T id)
+    {
+        assert(!contains(id));
+        _ids.insert(id);
+    }
+
+    /** Make every id in [first, last) available. None of them must already be available */
+    void insertRange(const T first, const T last)
+    {
+        for(auto id = first; id < last; ++id)
+        {
+            assert(!contains(id));
+            _ids.insert(_ids.end(), id);
+        }
+    }
+
+    /**
+     * \brief Remove id from the available ids
+     * \return false if id wasn't available
+     */
+    bool erase(const T id) { return _ids.erase(id) != 0; }
+
+    /**
+     * \brief Remove the run of available ids that end right before end.
+     * \return First id of the removed run, or end if end - 1 isn't available
+     */
+    T eraseRunEndingAt(const T end)
+    {
+        auto first = end;
+        while(first > std::numeric_limits<T>::lowest() && erase(first - 1)) --first;
+        return first;
+    }
+
+    /** Next id to hand out, the lowest one. Storage must not be empty */
+    T front() const
+    {
+        assert(!empty());
+        return *_ids.begin();
+    }
+
+    /** Remove and return front(). Storage must not be empty */
+    T popFront()
+    {
+        assert(!empty());
+        const auto it = _ids.begin();
+        const auto id = *it;
+        _ids.erase(it);
+        return id;
+    }
+
+    /**
+     * \brief Remove the lowest available ids as long as they are consecutive, up to maxCount ids
+     * \param first Receive the first removed id
+     * \return Count of removed ids, [first, first + count) were removed
+     */
+    std::size_t popFrontRun(const std::size_t maxCount, T& first)
+    {
+        assert(!empty() && maxCount);
+        auto it = _ids.begin();
+        first = *it;
+        std::size_t count = 0;
+        for(auto expected = first; it != _ids.end() && *it == expected && count < maxCount; ++expected, ++it)
+            ++count;
+        _ids.erase(_ids.begin(), it);
+        return count;
+    }
+
+    /**
+     * \brief Remove the lowest run of at least count consecutive available ids
+     * \param first Receive the first removed id, [first, first + count) were removed
+     * \return false if there is no such run
+     */
+    bool popContiguous(const std::size_t count, T& first)
+    {
+        assert(count);
+        std::size_t length = 0;
+        for(auto it = _ids.begin(); it != _ids.end(); ++it)
+        {
+            length = (length && *it == first + T(length)) ? length + 1 : 1;
+            if(length == 1)
+                first = *it;
+            if(length == count)
+            {
+                _ids.erase(_ids.find(first), std::next(it));
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * \brief Find the available id closest to hint, the lowest one on a tie. O(log n)
+     * \return false if the storage is empty
+     */
+    bool findNear(const T hint, T& id) const
+    {
+        if(_ids.empty())
+            return false;
+        const auto next = _ids.lower_bound(hint);
+        if(next == _ids.begin())
+        {
+            id = *next;
+            return true;
+        }
+        const auto below = *std::prev(next);
+        id = (next == _ids.end() || hint - below <= *next - hint) ? below : *next;
+        return true;
+    }
+
+    /** Call function(first, last) for each run of consecutive available ids, lowest first */
+    template<class Function>
+    void forEachRun(Function function) const
+    {
+        auto it = _ids.begin();
+        while(it != _ids.end())
+        {
+            const auto first = *it;
+            auto last = first;
+            for(; it != _ids.end() && *it == last; ++it) ++last;
+            function(first, last);
+        }
+    }
+
+    /** Remove every available id */
+    void clear() { _ids.clear(); }
+};
+
+template<typename T>
+constexpr bool SetIdStorage<T>::LOWEST_FIRST;
+
+}
+
+#endif
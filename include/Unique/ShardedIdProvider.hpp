@@ -0,0 +1,283 @@
+#ifndef __UNIQUE_SHARDED_ID_PROVIDER_HPP__
+#define __UNIQUE_SHARDED_ID_PROVIDER_HPP__
+
+// ─────────────────────────────────────────────────────────────
+//                  INCLUDE
+// ─────────────────────────────────────────────────────────────
+
+#include <Unique/DynamicIdProvider.hpp>
+#include <Unique/IntervalIdStorage.hpp>
+
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+
+// ─────────────────────────────────────────────────────────────
+//                  DECLARATION
+// ─────────────────────────────────────────────────────────────
+
+namespace unique {
+
+// ─────────────────────────────────────────────────────────────
+//                  CLASS
+// ─────────────────────────────────────────────────────────────
+
+/**
+ * Split [MIN, MAX) in shardCount sub-ranges of the same width, each owned by a DynamicIdProvider
+ * behind its own mutex. The last shard also own the remainder of the range.
+ * Each thread (or node) take ids from its own shard, so shards don't contend with each other.
+ * An id is always released to the shard owning it, found with a subtraction and a division.
+ * When a shard run dry, takeNextId steal the next id from the following shards.
+ */
+template<typename T, template<typename> class Storage = IntervalIdStorage>
+class ShardedIdProvider
+{
+    // ──────── DEFAULTS ──────────
+public:
+    const T MIN;
+    const T MAX;
+
+    using Type = T;
+    using ShardType = DynamicIdProvider<T, Storage>;
+
+    /**
+     * \param min First id given. \param max Exclusive upper bound
+     * \param shardCount Count of shards, [min, max) should hold at least one id per shard
+     */
+    ShardedIdProvider(const T min, const T max, const std::size_t shardCount);
+
+    ShardedIdProvider(const ShardedIdProvider&) = delete;
+    ShardedIdProvider& operator=(const ShardedIdProvider&) = delete;
+
+private:
+    using Unsigned = typename std::make_unsigned<T>::type;
+
+    struct Shard
+    {
+        Shard(const T min, const T max) : provider(min, max) {}
+
+        mutable std::mutex mutex;
+        ShardType provider;
+        /** Keep shards of consecutive allocations on different cache lines */
+        char padding[64];
+    };
+
+    /** Count of ids owned by every shard but the last one */
+    const Unsigned _shardWidth;
+    std::vector<std::unique_ptr<Shard>> _shards;
+
+    // ──────── C++ API ──────────
+public:
+    /** \brief Count of shards */
+    std::size_t shardCount() const { return _shards.size(); }
+
+    /** \brief Index of the shard owning id */
+    std::size_t shardOf(const T id) const;
+
+    /** \brief First id owned by shard */
+    T shardBegin(const std::size_t shard) const;
+
+    /** \brief Exclusive upper bound of ids owned by shard */
+    T shardEnd(const std::size_t shard) const;
+
+    /** \brief Take a specific id from the shard owning it. \return false if id is already taken */
+    bool takeId(const T id);
+
+    /**
+     * \brief Take the lowest available id of shard, or steal one from the following shards if shard
+     * is dry. The function assert if every shard is dry, and return MAX
+     * \param shard Shard of the caller, typically the thread index
+     */
+    T takeNextId(const std::size_t shard);
+
+    /**
+     * \brief Take count ids from shard, stealing the missing ids from the following shards.
+     * Each shard is locked once
+     * \return Output iterator past the last written id. Less than count ids are written if every shard is dry
+     */
+    template<class OutputIt>
+    OutputIt takeNextIds(const std::size_t shard, std::size_t count, OutputIt out);
+
+    /** \brief Release id to the shard owning it, whoever took it */
+    void releaseId(const T id);
+
+    /** \brief Get if an id can be taken */
+    bool isIdAvailable(const T id) const;
+
+    /** \brief Get if an id is taken */
+    bool isIdTaken(const T id) const;
+
+    /** \brief Get if takeNextId can be called from any shard without reaching MAX */
+    bool areIdsAvailables() const;
+
+    /** \brief Count of available ids before the counter of each shard */
+    std::size_t countOfAvailableIds() const;
+
+    /** \brief Count of taken ids in every shard */
+    std::size_t countOfTakenIds() const;
+
+    /** \brief Release every id of every shard */
+    void clear();
+};
+
+template<typename T, template<typename> class Storage>
+ShardedIdProvider<T, Storage>::ShardedIdProvider(const T min, const T max,
+    const std::size_t shardCount) :
+    MIN(min),
+    MAX(max),
+    _shardWidth(static_cast<Unsigned>(
+        (static_cast<Unsigned>(max) - static_cast<Unsigned>(min)) / (shardCount ? shardCount : 1)))
+{
+    assert(min < max);
+    assert(shardCount > 0);
+    assert(_shardWidth > 0);
+
+    _shards.reserve(shardCount);
+    for(std::size_t i = 0; i < shardCount; ++i)
+        _shards.emplace_back(new Shard(shardBegin(i), i + 1 == shardCount ? max : shardBegin(i + 1)));
+}
+
+template<typename T, template<typename> class Storage>
+std::size_t ShardedIdProvider<T, Storage>::shardOf(const T id) const
+{
+    assert(id >= MIN);
+    assert(id < MAX);
+
+    // ) Ids of the remainder are past the last shard width, clamp them to the last shard
+    const auto shard = static_cast<std::size_t>(
+        static_cast<Unsigned>(static_cast<Unsigned>(id) - static_cast<Unsigned>(MIN)) / _shardWidth);
+    return shard < _shards.size() ? shard : _shards.size() - 1;
+}
+
+template<typename T, template<typename> class Storage>
+T ShardedIdProvider<T, Storage>::shardBegin(const std::size_t shard) const
+{
+    return static_cast<T>(static_cast<Unsigned>(MIN) + static_cast<Unsigned>(shard) * _shardWidth);
+}
+
+template<typename T, template<typename> class Storage>
+T ShardedIdProvider<T, Storage>::shardEnd(const std::size_t shard) const
+{
+    assert(shard < _shards.size());
+    return shard + 1 == _shards.size() ? MAX : shardBegin(shard + 1);
+}
+
+template<typename T, template<typename> class Storage>
+bool ShardedIdProvider<T, Storage>::takeId(const T id)
+{
+    auto& shard = *_shards[shardOf(id)];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    return shard.provider.takeId(id);
+}
+
+template<typename T, template<typename> class Storage>
+T ShardedIdProvider<T, Storage>::takeNextId(const std::size_t shard)
+{
+    assert(shard < _shards.size());
+
+    // ) Own shard first, then steal from the following ones. Only one lock is held at a time
+    for(std::size_t i = 0; i < _shards.size(); ++i)
+    {
+        auto& victim = *_shards[(shard + i) % _shards.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if(victim.provider.areIdsAvailables())
+            return victim.provider.takeNextId();
+    }
+
+    // ) Every shard ran dry, as IdProvider we assert. MAX isn't owned by any shard
+    assert(false && "Every shard ran out of ids");
+    return MAX;
+}
+
+template<typename T, template<typename> class Storage>
+template<class OutputIt>
+OutputIt ShardedIdProvider<T, Storage>::takeNextIds(const std::size_t shard, std::size_t count,
+    OutputIt out)
+{
+    assert(shard < _shards.size());
+
+    for(std::size_t i = 0; count && i < _shards.size(); ++i)
+    {
+        auto& victim = *_shards[(shard + i) % _shards.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        const auto taken = victim.provider.countOfTakenIds();
+        out = victim.provider.takeNextIds(count, out);
+        count -= victim.provider.countOfTakenIds() - taken;
+    }
+    return out;
+}
+
+template<typename T, template<typename> class Storage>
+void ShardedIdProvider<T, Storage>::releaseId(const T id)
+{
+    auto& shard = *_shards[shardOf(id)];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.provider.releaseId(id);
+}
+
+template<typename T, template<typename> class Storage>
+bool ShardedIdProvider<T, Storage>::isIdAvailable(const T id) const
+{
+    const auto& shard = *_shards[shardOf(id)];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    return shard.provider.isIdAvailable(id);
+}
+
+template<typename T, template<typename> class Storage>
+bool ShardedIdProvider<T, Storage>::isIdTaken(const T id) const
+{
+    return !isIdAvailable(id);
+}
+
+template<typename T, template<typename> class Storage>
+bool ShardedIdProvider<T, Storage>::areIdsAvailables() const
+{
+    for(const auto& shard: _shards)
+    {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        if(shard->provider.areIdsAvailables())
+            return true;
+    }
+    return false;
+}
+
+template<typename T, template<typename> class Storage>
+std::size_t ShardedIdProvider<T, Storage>::countOfAvailableIds() const
+{
+    std::size_t count = 0;
+    for(const auto& shard: _shards)
+    {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        count += shard->provider.countOfAvailableIds();
+    }
+    return count;
+}
+
+template<typename T, template<typename> class Storage>
+std::size_t ShardedIdProvider<T, Storage>::countOfTakenIds() const
+{
+    std::size_t count = 0;
+    for(const auto& shard: _shards)
+    {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        count += shard->provider.countOfTakenIds();
+    }
+    return count;
+}
+
+template<typename T, template<typename> class Storage>
+void ShardedIdProvider<T, Storage>::clear()
+{
+    for(auto& shard: _shards)
+    {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        shard->provider.clear();
+    }
+}
+
+}
+
+#endif
@@ -0,0 +1,145 @@
+#ifndef __UNIQUE_SHARED_ID_PROVIDER_HPP__
+#define __UNIQUE_SHARED_ID_PROVIDER_HPP__
+
+// ─────────────────────────────────────────────────────────────
+//                  INCLUDE
+// ─────────────────────────────────────────────────────────────
+
+#include <cstddef>
+#include <mutex>
+
+// ─────────────────────────────────────────────────────────────
+//                  DECLARATION
+// ─────────────────────────────────────────────────────────────
+
+namespace unique {
+
+// ─────────────────────────────────────────────────────────────
+//                  CLASS
+// ─────────────────────────────────────────────────────────────
+
+/**
+ * Wrap an IdProvider behind a mutex so it can be shared between threads.
+ * Batch functions take the lock only once, they are meant to be used by IdCache.
+ */
+template<class Provider>
+class SharedIdProvider
+{
+public:
+    using ProviderType = Provider;
+    using Type = typename Provider::Type;
+
+private:
+    Provider _provider;
+    mutable std::mutex _mutex;
+
+    // ──────── C++ API ──────────
+public:
+    /** \brief Take a specific id. \return false if id is already taken */
+    bool takeId(const Type id)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _provider.takeId(id);
+    }
+
+    /** \brief Take the next available id */
+    Type takeNextId()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _provider.takeNextId();
+    }
+
+    /**
+     * \brief Take up to count ids under a single lock
+     * \param out Output iterator receiving the ids
+     * \return Output iterator past the last written id. Less than count ids are written if the provider run out
+     */
+    template<class OutputIt>
+    OutputIt takeNextIds(std::size_t count, OutputIt out)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _provider.takeNextIds(count, out);
+    }
+
+    /** \brief Take the available id closest to hint */
+    Type takeIdNear(const Type hint)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _provider.takeIdNear(hint);
+    }
+
+    /** \brief Take count consecutive ids. \return First id of the range */
+    Type takeContiguousRange(const std::size_t count)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _provider.takeContiguousRange(count);
+    }
+
+    /** \brief Release a taken id */
+    void releaseId(const Type id)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _provider.releaseId(id);
+    }
+
+    /** \brief Release every id in the iterator range [first, last) under a single lock */
+    template<class InputIt>
+    void releaseIds(InputIt first, InputIt last)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _provider.releaseIds(first, last);
+    }
+
+    /** \brief Release every id in [first, last) */
+    void releaseIdRange(const Type first, const Type last)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _provider.releaseIdRange(first, last);
+    }
+
+    /** \brief Get if an id can be taken */
+    bool isIdAvailable(const Type id) const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _provider.isIdAvailable(id);
+    }
+
+    /** \brief Get if an id is taken. Ids held in an IdCache are taken */
+    bool isIdTaken(const Type id) const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _provider.isIdTaken(id);
+    }
+
+    /** \brief Get if takeNextId can be safely called */
+    bool areIdsAvailables() const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _provider.areIdsAvailables();
+    }
+
+    /** \brief Count of available ids before the id counter */
+    std::size_t countOfAvailableIds() const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _provider.countOfAvailableIds();
+    }
+
+    /** \brief Count of taken ids, ids held in an IdCache included */
+    std::size_t countOfTakenIds() const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _provider.countOfTakenIds();
+    }
+
+    /** \brief Release every id. IdCache using this provider must be drained first */
+    void clear()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _provider.clear();
+    }
+};
+
+}
+
+#endif
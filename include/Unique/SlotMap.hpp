@@ -0,0 +1,198 @@
+#ifndef __UNIQUE_SLOT_MAP_HPP__
+#define __UNIQUE_SLOT_MAP_HPP__
+
+// ─────────────────────────────────────────────────────────────
+//                  INCLUDE
+// ─────────────────────────────────────────────────────────────
+
+#include <Unique/GenerationalIdProvider.hpp>
+#include <Unique/IdProvider.hpp>
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// ─────────────────────────────────────────────────────────────
+//                  DECLARATION
+// ─────────────────────────────────────────────────────────────
+
+namespace unique {
+
+// ─────────────────────────────────────────────────────────────
+//                  CLASS
+// ─────────────────────────────────────────────────────────────
+
+/**
+ * Container giving a generational handle for each inserted value.
+ * Values live in a dense array indexed by slot, next to the slot generation: a lookup is one
+ * array access and one compare, and a stale handle (erased value, reused slot) is always rejected.
+ * Slots are given by an IdProvider, so the lowest free slot is reused and the array stay dense.
+ */
+template<typename T, typename Handle = std::uint64_t, unsigned IndexBits = 32,
+    template<typename> class Storage = IntervalIdStorage>
+class SlotMap
+{
+public:
+    using Handles = GenerationalHandle<Handle, IndexBits>;
+    using ValueType = T;
+    using HandleType = Handle;
+
+private:
+    /** Value of a slot, only constructed while the generation is odd */
+    struct Slot
+    {
+        Handle generation = 0;
+        union
+        {
+            T value;
+        };
+
+        Slot() {}
+        Slot(Slot&& other) noexcept(std::is_nothrow_move_constructible<T>::value) :
+            generation(other.generation)
+        {
+            if(generation & 1)
+                new(&value) T(std::move(other.value));
+        }
+        Slot& operator=(Slot&&) = delete;
+        ~Slot()
+        {
+            if(generation & 1)
+                value.~T();
+        }
+    };
+
+    IdProvider<Handle, 0, Handles::MAX_INDEX, Storage> _indexes;
+    std::vector<Slot> _slots;
+
+private:
+    const Slot* findSlot(const Handle handle) const
+    {
+        const auto index = Handles::indexOf(handle);
+        const auto generation = Handles::generationOf(handle);
+        if(index >= _slots.size())
+            return nullptr;
+        const auto& slot = _slots[index];
+        return ((generation & 1) && slot.generation == generation) ? &slot : nullptr;
+    }
+
+public:
+    SlotMap() = default;
+    SlotMap(const SlotMap&) = delete;
+    SlotMap& operator=(const SlotMap&) = delete;
+    SlotMap(SlotMap&&) = default;
+
+    // ──────── C++ API ──────────
+public:
+    /** \brief Construct a value in the lowest free slot. \return Handle of the value */
+    template<class... Args>
+    Handle emplace(Args&&... args);
+
+    /** \brief Insert a copy of value. \return Handle of the value */
+    Handle insert(const T& value) { return emplace(value); }
+
+    /** \brief Insert value. \return Handle of the value */
+    Handle insert(T&& value) { return emplace(std::move(value)); }
+
+    /**
+     * \brief Destroy the value of handle. Every copy of handle become invalid
+     * \return false if handle was already invalid
+     */
+    bool erase(const Handle handle);
+
+    /** \brief Get the value of handle, or nullptr if the handle is stale */
+    T* find(const Handle handle)
+    {
+        const auto* slot = findSlot(handle);
+        return slot ? const_cast<T*>(&slot->value) : nullptr;
+    }
+
+    /** \brief Get the value of handle, or nullptr if the handle is stale */
+    const T* find(const Handle handle) const
+    {
+        const auto* slot = findSlot(handle);
+        return slot ? &slot->value : nullptr;
+    }
+
+    /** \brief Get if handle refer to a value */
+    bool contains(const Handle handle) const { return findSlot(handle) != nullptr; }
+
+    /** \brief Count of values */
+    std::size_t size() const { return _indexes.countOfTakenIds(); }
+
+    /** \brief Check if container is empty */
+    bool empty() const { return size() == 0; }
+
+    /** \brief Destroy every value. Handles given before stay invalid after the slots are reused */
+    void clear();
+};
+
+template<typename T, typename Handle, unsigned IndexBits, template<typename> class Storage>
+template<class... Args>
+Handle SlotMap<T, Handle, IndexBits, Storage>::emplace(Args&&... args)
+{
+    // ) Slots are taken lowest first, so a slot is missing only when every slot is used.
+    // ) It is added before the index is taken, so that a throwing allocation take nothing
+    if(_indexes.countOfTakenIds() == _slots.size())
+        _slots.emplace_back();
+
+    // ) Give the index back if the constructor of T throw, so that the slot isn't lost
+    struct IndexGuard
+    {
+        IdProvider<Handle, 0, Handles::MAX_INDEX, Storage>& indexes;
+        Handle index;
+        bool committed = false;
+        ~IndexGuard()
+        {
+            if(!committed)
+                indexes.releaseId(index);
+        }
+    };
+    IndexGuard guard {_indexes, _indexes.takeNextId()};
+    const auto index = guard.index;
+    assert(index < _slots.size());
+
+    auto& slot = _slots[index];
+    assert(!(slot.generation & 1));
+    new(&slot.value) T(std::forward<Args>(args)...);
+    guard.committed = true;
+    slot.generation = Handles::nextGeneration(slot.generation);
+    return Handles::make(index, slot.generation);
+}
+
+template<typename T, typename Handle, unsigned IndexBits, template<typename> class Storage>
+bool SlotMap<T, Handle, IndexBits, Storage>::erase(const Handle handle)
+{
+    if(!findSlot(handle))
+        return false;
+
+    const auto index = Handles::indexOf(handle);
+    auto& slot = _slots[index];
+    slot.value.~T();
+    slot.generation = Handles::nextGeneration(slot.generation);
+    _indexes.releaseId(index);
+    return true;
+}
+
+template<typename T, typename Handle, unsigned IndexBits, template<typename> class Storage>
+void SlotMap<T, Handle, IndexBits, Storage>::clear()
+{
+    // ) Generations are kept so that old handles never become valid again
+    for(auto& slot: _slots)
+    {
+        if(slot.generation & 1)
+        {
+            slot.value.~T();
+            slot.generation = Handles::nextGeneration(slot.generation);
+        }
+    }
+    _indexes.clear();
+}
+
+}
+
+#endif
@@ -0,0 +1,244 @@
+#ifndef __UNIQUE_SORTED_VECTOR_MAP_HPP__
+#define __UNIQUE_SORTED_VECTOR_MAP_HPP__
+
+// ─────────────────────────────────────────────────────────────
+//                  INCLUDE
+// ─────────────────────────────────────────────────────────────
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+// ─────────────────────────────────────────────────────────────
+//                  DECLARATION
+// ─────────────────────────────────────────────────────────────
+
+namespace unique {
+
+// ─────────────────────────────────────────────────────────────
+//                  CLASS
+// ─────────────────────────────────────────────────────────────
+
+/**
+ * Ordered map stored as a vector of pairs sorted by key, usable as Map1 or Map2 of TMap.
+ * Lookups are a branchless binary search: the loop has a fixed count of iterations for a given size,
+ * and the compare select the next half with a conditional move instead of a mispredicted jump.
+ * Iteration is a linear sweep of contiguous memory.
+ *
+ * A single insert or erase shift the pairs after it, O(n). Build the map from sorted runs with
+ * mergeSortedUnique, that append the run then merge it in place in O(n + count) instead.
+ * Like boost flat_map, value_type is std::pair<Key, Value> so that pairs can be shifted: keys must
+ * not be changed through iterators. Iterators are invalidated by every insert and erase.
+ */
+template<class Key, class Value, class Compare = std::less<Key>>
+class SortedVectorMap
+{
+    // ──────── TYPES ──────────
+public:
+    using key_type = Key;
+    using mapped_type = Value;
+    using value_type = std::pair<Key, Value>;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using key_compare = Compare;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+
+    using iterator = typename std::vector<value_type>::iterator;
+    using const_iterator = typename std::vector<value_type>::const_iterator;
+
+private:
+    std::vector<value_type> _values;
+    Compare _compare {};
+
+private:
+    bool equivalent(const Key& a, const Key& b) const { return !_compare(a, b) && !_compare(b, a); }
+
+    /** Index of the first pair whose key isn't less than key */
+    std::size_t lowerIndex(const Key& key) const;
+
+    /** Insert at the position given by lower bound, if key isn't there yet */
+    template<class K, class... Args>
+    std::pair<iterator, bool> T_emplace(const std::size_t index, K&& key, Args&&... args);
+
+    // ──────── C++ API ──────────
+public:
+    iterator begin() noexcept { return _values.begin(); }
+    iterator end() noexcept { return _values.end(); }
+    const_iterator begin() const noexcept { return _values.cbegin(); }
+    const_iterator end() const noexcept { return _values.cend(); }
+    const_iterator cbegin() const noexcept { return _values.cbegin(); }
+    const_iterator cend() const noexcept { return _values.cend(); }
+
+    bool empty() const noexcept { return _values.empty(); }
+    std::size_t size() const noexcept { return _values.size(); }
+    std::size_t max_size() const noexcept { return _values.max_size(); }
+    std::size_t capacity() const noexcept { return _values.capacity(); }
+
+    /** \brief Allocate room for count pairs */
+    void reserve(const std::size_t count) { _values.reserve(count); }
+
+    key_compare key_comp() const { return _compare; }
+
+    void clear() noexcept { _values.clear(); }
+
+    void swap(SortedVectorMap& other) noexcept
+    {
+        using std::swap;
+        swap(_values, other._values);
+        swap(_compare, other._compare);
+    }
+
+    iterator lower_bound(const Key& key) { return begin() + static_cast<difference_type>(lowerIndex(key)); }
+    const_iterator lower_bound(const Key& key) const { return begin() + static_cast<difference_type>(lowerIndex(key)); }
+
+    iterator find(const Key& key);
+    const_iterator find(const Key& key) const;
+
+    bool contains(const Key& key) const { return find(key) != end(); }
+    std::size_t count(const Key& key) const { return contains(key) ? 1 : 0; }
+
+    /** \brief Insert value if its key isn't in the map. O(n) shift */
+    std::pair<iterator, bool> insert(const value_type& value) { return try_emplace(value.first, value.second); }
+    std::pair<iterator, bool> insert(value_type&& value) { return try_emplace(std::move(value.first), std::move(value.second)); }
+
+    /** \brief Insert value, at hint without search if it is the right position */
+    iterator insert(const_iterator hint, const value_type& value) { return try_emplace(hint, value.first, value.second); }
+    iterator insert(const_iterator hint, value_type&& value)
+    {
+        return try_emplace(hint, std::move(value.first), std::move(value.second));
+    }
+
+    /** \brief Construct the pair from args, kept only if its key isn't in the map */
+    template<class... Args>
+    std::pair<iterator, bool> emplace(Args&&... args);
+
+    /** \brief Construct Value from args only if key isn't in the map */
+    template<class K, class... Args>
+    std::pair<iterator, bool> try_emplace(K&& key, Args&&... args);
+
+    /** \brief Construct Value from args only if key isn't in the map, at hint without search if it is the right position */
+    template<class K, class... Args>
+    iterator try_emplace(const_iterator hint, K&& key, Args&&... args);
+
+    /**
+     * \brief Insert the pairs of [first, last), sorted by key, without duplicates, and with keys not in the map yet.
+     * The run is appended then merged in place: O(n + count) compares and moves
+     */
+    template<class InputIt>
+    void mergeSortedUnique(InputIt first, InputIt last);
+
+    /** \brief Erase the pair at pos. \return Iterator following pos */
+    iterator erase(const_iterator pos) { return _values.erase(pos); }
+
+    /** \brief Erase the pair of key. \return Count of erased pairs, 0 or 1 */
+    std::size_t erase(const Key& key);
+};
+
+template<class Key, class Value, class Compare>
+std::size_t SortedVectorMap<Key, Value, Compare>::lowerIndex(const Key& key) const
+{
+    auto count = _values.size();
+    if(!count)
+        return 0;
+
+    // ) Halve the range without branching on the compare, base stay the last pair less than key
+    const value_type* base = _values.data();
+    while(count > 1)
+    {
+        const auto half = count / 2;
+        base = _compare(base[half].first, key) ? base + half : base;
+        count -= half;
+    }
+    return static_cast<std::size_t>(base - _values.data()) + (_compare(base->first, key) ? 1 : 0);
+}
+
+template<class Key, class Value, class Compare>
+template<class K, class... Args>
+std::pair<typename SortedVectorMap<Key, Value, Compare>::iterator, bool> SortedVectorMap<Key, Value, Compare>::T_emplace(
+    const std::size_t index, K&& key, Args&&... args)
+{
+    const auto position = begin() + static_cast<difference_type>(index);
+    if(position != end() && equivalent(position->first, key))
+        return {position, false};
+    return {_values.emplace(position, std::piecewise_construct, std::forward_as_tuple(std::forward<K>(key)),
+                std::forward_as_tuple(std::forward<Args>(args)...)),
+        true};
+}
+
+template<class Key, class Value, class Compare>
+typename SortedVectorMap<Key, Value, Compare>::iterator SortedVectorMap<Key, Value, Compare>::find(const Key& key)
+{
+    const auto it = lower_bound(key);
+    return it != end() && !_compare(key, it->first) ? it : end();
+}
+
+template<class Key, class Value, class Compare>
+typename SortedVectorMap<Key, Value, Compare>::const_iterator SortedVectorMap<Key, Value, Compare>::find(
+    const Key& key) const
+{
+    const auto it = lower_bound(key);
+    return it != end() && !_compare(key, it->first) ? it : end();
+}
+
+template<class Key, class Value, class Compare>
+template<class K, class... Args>
+typename SortedVectorMap<Key, Value, Compare>::iterator SortedVectorMap<Key, Value, Compare>::try_emplace(
+    const_iterator hint, K&& key, Args&&... args)
+{
+    // ) The hint is right if key sort between the pair before it and the pair at it
+    const auto index = static_cast<std::size_t>(hint - cbegin());
+    const bool afterPrevious = hint == cbegin() || _compare(std::prev(hint)->first, key);
+    const bool beforeHint = hint == cend() || _compare(key, hint->first);
+    if(afterPrevious && beforeHint)
+        return T_emplace(index, std::forward<K>(key), std::forward<Args>(args)...).first;
+    return try_emplace(std::forward<K>(key), std::forward<Args>(args)...).first;
+}
+
+template<class Key, class Value, class Compare>
+template<class... Args>
+std::pair<typename SortedVectorMap<Key, Value, Compare>::iterator, bool> SortedVectorMap<Key, Value, Compare>::emplace(
+    Args&&... args)
+{
+    value_type value(std::forward<Args>(args)...);
+    return insert(std::move(value));
+}
+
+template<class Key, class Value, class Compare>
+template<class K, class... Args>
+std::pair<typename SortedVectorMap<Key, Value, Compare>::iterator, bool> SortedVectorMap<Key, Value, Compare>::try_emplace(
+    K&& key, Args&&... args)
+{
+    const auto index = lowerIndex(key);
+    return T_emplace(index, std::forward<K>(key), std::forward<Args>(args)...);
+}
+
+template<class Key, class Value, class Compare>
+template<class InputIt>
+void SortedVectorMap<Key, Value, Compare>::mergeSortedUnique(InputIt first, InputIt last)
+{
+    const auto middle = static_cast<difference_type>(_values.size());
+    _values.insert(_values.end(), first, last);
+    const auto byKey = [this](const value_type& a, const value_type& b) { return _compare(a.first, b.first); };
+    assert(std::is_sorted(_values.begin() + middle, _values.end(), byKey));
+    std::inplace_merge(_values.begin(), _values.begin() + middle, _values.end(), byKey);
+}
+
+template<class Key, class Value, class Compare>
+std::size_t SortedVectorMap<Key, Value, Compare>::erase(const Key& key)
+{
+    const auto it = find(key);
+    if(it == end())
+        return 0;
+    _values.erase(it);
+    return 1;
+}
+
+}
+
+#endif
@@ -5,14 +5,32 @@
 //                  INCLUDE
 // ─────────────────────────────────────────────────────────────
 
+#include <Unique/TransparentKey.hpp>
+
 #include <cstddef>  // std::size_t
-#include <utility>  // std::pair
+#include <type_traits>  // std::enable_if, std::true_type
+#include <utility>  // std::pair, std::declval, std::swap
 
 // ─────────────────────────────────────────────────────────────
 //                  DECLARATION
 // ─────────────────────────────────────────────────────────────
 
 namespace unique {
+namespace detail {
+
+/** True for node based maps, like std::map and std::unordered_map, that can extract a node and insert it back */
+template<typename Map, typename = void>
+struct HasExtract : std::false_type
+{
+};
+
+template<typename Map>
+struct HasExtract<Map, decltype(void(std::declval<Map&>().extract(std::declval<typename Map::const_iterator>())))>
+    : std::true_type
+{
+};
+
+}
 
 // ─────────────────────────────────────────────────────────────
 //                  CLASS
@@ -52,6 +70,11 @@ public:
     const Key1Map& key1Map() const { return _key1Map; }
     const Key2Map& key2Map() const { return _key2Map; }
 
+protected:
+    /** Maps for derived classes that expose map specific functions, like reserve */
+    Key1Map& mutableKey1Map() { return _key1Map; }
+    Key2Map& mutableKey2Map() { return _key2Map; }
+
     // ──────── ITERATORS ──────────
 public:
     /**
@@ -205,46 +228,65 @@ public:
     }
 
 private:
-    template<typename KeyMap, typename KeyOtherMap>
+    /**
+     * Keys are copied once in keyMap, then forwarded to keyOtherMap, so that rvalue keys are moved.
+     * Nothing is constructed if one of the key is already present
+     */
+    template<typename Key, typename OtherKey, typename KeyMap, typename KeyOtherMap>
     static std::pair<typename KeyMap::iterator, bool> T_insert(
-        typename KeyMap::value_type value, KeyMap& keyMap, KeyOtherMap& keyOtherMap)
+        Key&& key, OtherKey&& otherKey, KeyMap& keyMap, KeyOtherMap& keyOtherMap)
     {
         // ) Check that the second key isn't already present in other map
-        const auto keyOtherIt = keyOtherMap.find(value.second);
+        const auto keyOtherIt = keyOtherMap.find(otherKey);
         if(keyOtherIt != keyOtherMap.end())
             return std::make_pair(keyMap.find(keyOtherIt->second), false);
 
         // ) Insert in both map, only insert in other map if first map insert succeed
-        const auto res = keyMap.insert(value);
+        const auto res = keyMap.try_emplace(key, otherKey);
         if(res.second)
-            keyOtherMap.insert({value.second, value.first});
+            keyOtherMap.try_emplace(std::forward<OtherKey>(otherKey), std::forward<Key>(key));
 
         // ) Return the res
         return res;
     }
 
-    template<typename KeyMap, typename KeyOtherMap>
-    static typename KeyMap::iterator T_insert(typename KeyMap::const_iterator hint,
-        typename KeyMap::value_type value, KeyMap& keyMap, KeyOtherMap& keyOtherMap)
+    template<typename Key, typename OtherKey, typename KeyMap, typename KeyOtherMap>
+    static typename KeyMap::iterator T_insert(typename KeyMap::const_iterator hint, Key&& key,
+        OtherKey&& otherKey, KeyMap& keyMap, KeyOtherMap& keyOtherMap)
     {
         // ) Check that the second key isn't already present in other map
-        const auto keyOtherIt = keyOtherMap.find(value.second);
+        const auto keyOtherIt = keyOtherMap.find(otherKey);
         if(keyOtherIt != keyOtherMap.end())
             return keyMap.find(keyOtherIt->second);
 
-        // ) We need to check if there not already an element, in order not to insert in the second map if the first insert succeed
-        auto res = keyMap.find(value.first);
-        if(res == keyMap.end())
-        {
-            res = keyMap.insert(hint, value);
-            if(res != keyMap.end())
-                keyOtherMap.insert({value.second, value.first});
-        }
+        // ) The size tell if the first insert succeed, in order to only insert in the second map in that case
+        const auto size = keyMap.size();
+        const auto res = keyMap.try_emplace(hint, key, otherKey);
+        if(keyMap.size() != size)
+            keyOtherMap.try_emplace(std::forward<OtherKey>(otherKey), std::forward<Key>(key));
 
         // ) Return the res
         return res;
     }
 
+    template<typename Key, typename KeyMap, typename KeyOtherMap, typename... Args>
+    static std::pair<typename KeyMap::iterator, bool> T_tryEmplace(
+        Key&& key, KeyMap& keyMap, KeyOtherMap& keyOtherMap, Args&&... args)
+    {
+        // ) The other key is only constructed if key isn't present
+        const auto it = keyMap.find(key);
+        if(it != keyMap.end())
+            return std::make_pair(it, false);
+
+        typename KeyOtherMap::key_type otherKey(std::forward<Args>(args)...);
+        return T_insert(std::forward<Key>(key), std::move(otherKey), keyMap, keyOtherMap);
+    }
+
+    /** Pair of keys that can be moved from, std::pair<Key1, Key2> for example when Key1ValueType is std::pair<const Key1, Key2> */
+    template<typename Pair, typename First, typename Second>
+    using EnableIfPairOf = typename std::enable_if<
+        std::is_same<typename std::decay<Pair>::type, std::pair<First, Second>>::value, int>::type;
+
 public:
     /**
      * \brief Inserts value.
@@ -253,7 +295,7 @@ public:
      */
     std::pair<Key1Iterator, bool> insert(Key1ValueType&& value)
     {
-        return T_insert(value, _key1Map, _key2Map);
+        return T_insert(std::move(value.first), std::move(value.second), _key1Map, _key2Map);
     }
 
     /**
@@ -263,7 +305,7 @@ public:
      */
     std::pair<Key1Iterator, bool> insert(const Key1ValueType& value)
     {
-        return T_insert(value, _key1Map, _key2Map);
+        return T_insert(value.first, value.second, _key1Map, _key2Map);
     }
 
     /**
@@ -274,7 +316,7 @@ public:
      */
     Key1Iterator insert(Key1ConstIterator hint, const Key1ValueType& value)
     {
-        return T_insert(hint, value, _key1Map, _key2Map);
+        return T_insert(hint, value.first, value.second, _key1Map, _key2Map);
     }
 
     /**
@@ -285,7 +327,7 @@ public:
      */
     Key1Iterator insert(Key1ConstIterator hint, Key1ValueType&& value)
     {
-        return T_insert(hint, value, _key1Map, _key2Map);
+        return T_insert(hint, std::move(value.first), std::move(value.second), _key1Map, _key2Map);
     }
 
 public:
@@ -296,7 +338,7 @@ public:
      */
     std::pair<Key2Iterator, bool> insert(Key2ValueType&& value)
     {
-        return T_insert(value, _key2Map, _key1Map);
+        return T_insert(std::move(value.first), std::move(value.second), _key2Map, _key1Map);
     }
 
     /**
@@ -306,7 +348,7 @@ public:
      */
     std::pair<Key2Iterator, bool> insert(const Key2ValueType& value)
     {
-        return T_insert(value, _key2Map, _key1Map);
+        return T_insert(value.first, value.second, _key2Map, _key1Map);
     }
 
     /**
@@ -317,7 +359,7 @@ public:
      */
     Key2Iterator insert(Key2ConstIterator hint, const Key2ValueType& value)
     {
-        return T_insert(hint, value, _key2Map, _key1Map);
+        return T_insert(hint, value.first, value.second, _key2Map, _key1Map);
     }
 
     /**
@@ -328,7 +370,81 @@ public:
      */
     Key2Iterator insert(Key2ConstIterator hint, Key2ValueType&& value)
     {
-        return T_insert(hint, value, _key2Map, _key1Map);
+        return T_insert(hint, std::move(value.first), std::move(value.second), _key2Map, _key1Map);
+    }
+
+public:
+    /**
+     * \brief Inserts a std::pair<Key1, Key2>. Keys of an rvalue pair are moved in the second map,
+     * while the keys of Key1ValueType&& can't be moved when Key1ValueType is std::pair<const Key1, Key2>.
+     * \return Returns a pair consisting of an iterator to the inserted element (or to the element that prevented the insertion) and a bool denoting whether the insertion took place.
+     */
+    template<typename Pair, EnableIfPairOf<Pair, Key1, Key2> = 0>
+    std::pair<Key1Iterator, bool> insert(Pair&& value)
+    {
+        return T_insert(std::forward<Pair>(value).first, std::forward<Pair>(value).second, _key1Map, _key2Map);
+    }
+
+    /**
+     * \brief Inserts a std::pair<Key2, Key1>. Keys of an rvalue pair are moved in the first map.
+     * \return Returns a pair consisting of an iterator to the inserted element (or to the element that prevented the insertion) and a bool denoting whether the insertion took place.
+     */
+    template<typename Pair, EnableIfPairOf<Pair, Key2, Key1> = 0>
+    std::pair<Key2Iterator, bool> insert(Pair&& value)
+    {
+        return T_insert(std::forward<Pair>(value).first, std::forward<Pair>(value).second, _key2Map, _key1Map);
+    }
+
+    /**
+     * \brief Inserts a std::pair<Key1, Key2> constructed from args. Each key is constructed once,
+     * copied in the first map and moved in the second map.
+     * \return Returns a pair consisting of an iterator to the inserted element (or to the element that prevented the insertion) and a bool denoting whether the insertion took place.
+     */
+    template<typename... Args>
+    std::pair<Key1Iterator, bool> emplace(Args&&... args)
+    {
+        std::pair<Key1, Key2> value(std::forward<Args>(args)...);
+        return T_insert(std::move(value.first), std::move(value.second), _key1Map, _key2Map);
+    }
+
+    /**
+     * \brief Inserts key with a Key2 constructed from args. Nothing is constructed if key is already present.
+     * \return Returns a pair consisting of an iterator to the inserted element (or to the element that prevented the insertion) and a bool denoting whether the insertion took place.
+     */
+    template<typename... Args>
+    std::pair<Key1Iterator, bool> try_emplace(const Key1& key, Args&&... args)
+    {
+        return T_tryEmplace(key, _key1Map, _key2Map, std::forward<Args>(args)...);
+    }
+
+    /**
+     * \brief Inserts key with a Key2 constructed from args. Nothing is constructed if key is already present.
+     * \return Returns a pair consisting of an iterator to the inserted element (or to the element that prevented the insertion) and a bool denoting whether the insertion took place.
+     */
+    template<typename... Args>
+    std::pair<Key1Iterator, bool> try_emplace(Key1&& key, Args&&... args)
+    {
+        return T_tryEmplace(std::move(key), _key1Map, _key2Map, std::forward<Args>(args)...);
+    }
+
+    /**
+     * \brief Inserts key with a Key1 constructed from args. Nothing is constructed if key is already present.
+     * \return Returns a pair consisting of an iterator to the inserted element (or to the element that prevented the insertion) and a bool denoting whether the insertion took place.
+     */
+    template<typename... Args>
+    std::pair<Key2Iterator, bool> try_emplace(const Key2& key, Args&&... args)
+    {
+        return T_tryEmplace(key, _key2Map, _key1Map, std::forward<Args>(args)...);
+    }
+
+    /**
+     * \brief Inserts key with a Key1 constructed from args. Nothing is constructed if key is already present.
+     * \return Returns a pair consisting of an iterator to the inserted element (or to the element that prevented the insertion) and a bool denoting whether the insertion took place.
+     */
+    template<typename... Args>
+    std::pair<Key2Iterator, bool> try_emplace(Key2&& key, Args&&... args)
+    {
+        return T_tryEmplace(std::move(key), _key2Map, _key1Map, std::forward<Args>(args)...);
     }
 
 private:
@@ -343,19 +459,23 @@ private:
         }
         return keyMap.end();
     }
-    template<typename KeyMap, typename KeyOtherMap>
-    std::size_t T_erase(
-        const typename KeyMap::key_type& key, KeyMap& keyMap, KeyOtherMap& keyOtherMap)
+    template<typename Key, typename KeyMap, typename KeyOtherMap>
+    static std::size_t T_eraseKey(const Key& key, KeyMap& keyMap, KeyOtherMap& keyOtherMap)
     {
-        const auto it = keyMap.find(key);
+        const auto it = T_find(key, keyMap);
         if(it != keyMap.end())
         {
             keyOtherMap.erase(it->second);
-            return keyMap.erase(key);
+            keyMap.erase(it);
+            return 1;
         }
         return 0;
     }
 
+    /** Lookup keys of a map, like std::string_view for std::string keys. See KeyLookup */
+    template<typename Key, typename KeyMap>
+    using EnableIfLookupKey = typename std::enable_if<detail::IsLookupKey<KeyMap, Key>::value, int>::type;
+
 public:
     /**
      * \brief Removes the element at pos.
@@ -369,7 +489,7 @@ public:
      * \param key value of the elements to remove
      * \return Number of elements removed.
      */
-    std::size_t erase(const Key1Type& key) { return T_erase(key, _key1Map, _key2Map); }
+    std::size_t erase(const Key1Type& key) { return T_eraseKey(key, _key1Map, _key2Map); }
 
 public:
     /**
@@ -384,44 +504,80 @@ public:
      * \param key value of the elements to remove
      * \return Number of elements removed.
      */
-    std::size_t erase(const Key2Type& key) { return T_erase(key, _key2Map, _key1Map); }
+    std::size_t erase(const Key2Type& key) { return T_eraseKey(key, _key2Map, _key1Map); }
 
-private:
-    template<typename Key, typename OtherKey, typename KeyMap, typename KeyOtherMap>
-    bool T_move(const Key& key, const OtherKey& newKey, KeyMap& keyMap, KeyOtherMap& keyOtherMap)
+public:
+    /**
+     * \brief Removes the element with the first key equivalent to key, without building a Key1.
+     * \param key lookup key, std::string_view for a std::string for example
+     * \return Number of elements removed.
+     */
+    template<typename Key, EnableIfLookupKey<Key, Key1Map> = 0>
+    std::size_t erase(const Key& key)
     {
-        // ) Iterator at index key. Used to get it's current key
-        auto it = keyMap.find(key);
+        return T_eraseKey(key, _key1Map, _key2Map);
+    }
 
-        // ) If the current other key is the same as the new one we want to move to, then we don't need to do anything
-        const auto currentOtherKey = it->second;
-        if(newKey == currentOtherKey)
-            return true;
+    /**
+     * \brief Removes the element with the second key equivalent to key, without building a Key2.
+     * \param key lookup key, raw pointer for a std::unique_ptr for example
+     * \return Number of elements removed.
+     */
+    template<typename Key, EnableIfLookupKey<Key, Key2Map> = 0>
+    std::size_t erase(const Key& key)
+    {
+        return T_eraseKey(key, _key2Map, _key1Map);
+    }
 
-        // ) The current other iterator, the one we need to erase and reinsert
-        const auto currentOtherIt = keyOtherMap.find(currentOtherKey);
+private:
+    /**
+     * Change the key of the pair at it to newKey, newKey must not be in keyMap.
+     * Node based maps extract the node and insert it back, so the node and its value are reused without allocation.
+     * Other maps erase the pair and insert the moved value.
+     */
+    template<typename KeyMap>
+    static void T_rekey(typename KeyMap::iterator it, const typename KeyMap::key_type& newKey, KeyMap& keyMap)
+    {
+        if constexpr(detail::HasExtract<KeyMap>::value)
+        {
+            auto node = keyMap.extract(it);
+            node.key() = newKey;
+            keyMap.insert(std::move(node));
+        }
+        else
+        {
+            auto value = std::move(it->second);
+            keyMap.erase(it);
+            keyMap.try_emplace(newKey, std::move(value));
+        }
+    }
 
+    template<typename Key, typename OtherKey, typename KeyMap, typename KeyOtherMap>
+    static bool T_move(const Key& key, const OtherKey& newKey, KeyMap& keyMap, KeyOtherMap& keyOtherMap)
+    {
         // ) Check that key is present
+        const auto it = keyMap.find(key);
         if(it == keyMap.end())
             return false;
-        if(currentOtherIt == keyOtherMap.end())
-            return false;
+
+        // ) If the current other key is the same as the new one we want to move to, then we don't need to do anything
+        if(newKey == it->second)
+            return true;
 
         // ) Check that the new key is available in the container
-        const auto newOtherIt = keyOtherMap.find(newKey);
-        if(newOtherIt != keyOtherMap.end())
+        if(keyOtherMap.find(newKey) != keyOtherMap.end())
             return false;
 
-        // ) For keyMap we just new to change second member but for other key, the map key change so we need to erase and insert
+        // ) For keyMap we just need to change second member, but in other map the key change
+        const auto currentOtherIt = keyOtherMap.find(it->second);
+        T_rekey(currentOtherIt, newKey, keyOtherMap);
         it->second = newKey;
-        keyOtherMap.erase(currentOtherIt);
-        keyOtherMap.insert({newKey, key});
 
         return true;
     }
 
     template<typename Key, typename KeyMap, typename KeyOtherMap>
-    bool T_move(const Key& currentKey, const Key& newKey, KeyMap& keyMap, KeyOtherMap& keyOtherMap)
+    static bool T_move(const Key& currentKey, const Key& newKey, KeyMap& keyMap, KeyOtherMap& keyOtherMap)
     {
         const auto currentIt = keyMap.find(currentKey);
 
@@ -429,19 +585,14 @@ private:
         if(currentIt == keyMap.end())
             return false;
 
-        const auto newIt = keyMap.find(newKey);
-
         // ) Function fail if there is already something at the new id
-        if(newIt != keyMap.end())
+        if(keyMap.find(newKey) != keyMap.end())
             return false;
 
-        const auto otherCurrentKey = currentIt->second;
         // ) currentOtherIt should always be valid because currentIt exist
-        const auto currentOtherIt = keyOtherMap.find(otherCurrentKey);
-
+        const auto currentOtherIt = keyOtherMap.find(currentIt->second);
         currentOtherIt->second = newKey;
-        keyMap.erase(currentIt);
-        keyMap.insert({newKey, otherCurrentKey});
+        T_rekey(currentIt, newKey, keyMap);
 
         return true;
     }
@@ -499,33 +650,59 @@ public:
         return T_move(currentKey, newKey, _key2Map, _key1Map);
     }
 
+    /**
+     * \brief Apply move(from, to) for each pair of [first, last), in order.
+     * A pair can move to a key released by an earlier pair of the range.
+     * \return Count of successful moves
+     */
+    template<typename InputIt>
+    std::size_t moveMany(InputIt first, InputIt last)
+    {
+        std::size_t count = 0;
+        for(; first != last; ++first)
+        {
+            if(move(first->first, first->second))
+                ++count;
+        }
+        return count;
+    }
+
 private:
     template<typename Key, typename KeyMap, typename KeyOtherMap>
-    bool T_swap(const Key& key1, const Key& key2, KeyMap& keyMap, KeyOtherMap& keyOtherMap)
+    static bool T_swap(const Key& key1, const Key& key2, KeyMap& keyMap, KeyOtherMap& keyOtherMap)
     {
         const auto it1 = keyMap.find(key1);
         const auto it2 = keyMap.find(key2);
+        if(it1 == keyMap.end() || it2 == keyMap.end())
+            return false;
+        if(it1 == it2)
+            return true;
 
-        const auto tempOtherKey1 = it1->second;
-        const auto tempOtherKey2 = it2->second;
-
+        // ) No key change in any map, so values are swapped in place without copy
         const auto otherIt1 = keyOtherMap.find(it1->second);
         const auto otherIt2 = keyOtherMap.find(it2->second);
 
-        it1->second = tempOtherKey2;
-        it2->second = tempOtherKey1;
-
-        otherIt1->second = key2;
-        otherIt2->second = key1;
+        using std::swap;
+        swap(it1->second, it2->second);
+        swap(otherIt1->second, otherIt2->second);
 
         return true;
     }
 
 public:
+    /**
+     * \brief Exchange the second keys of key and otherKey
+     * \return false if key or otherKey isn't present
+     */
     bool swap(const Key1& key, const Key1& otherKey)
     {
         return T_swap(key, otherKey, _key1Map, _key2Map);
     }
+
+    /**
+     * \brief Exchange the first keys of key and otherKey
+     * \return false if key or otherKey isn't present
+     */
     bool swap(const Key2& key, const Key2& otherKey)
     {
         return T_swap(key, otherKey, _key2Map, _key1Map);
@@ -534,16 +711,17 @@ public:
     // ──────── LOOKUP ──────────
 
 private:
+    /**
+     * Maps with heterogeneous lookup find key as is. Other maps find a key_type built from key,
+     * that only exist for lookup keys that have KeyLookup::keyFromView
+     */
     template<class Key, typename KeyMap>
-    typename KeyMap::iterator T_find(const Key key, KeyMap& keyMap)
-    {
-        return keyMap.find(key);
-    }
-
-    template<class Key, typename KeyMap>
-    typename KeyMap::const_iterator T_find(const Key key, KeyMap& keyMap) const
+    static auto T_find(const Key& key, KeyMap& keyMap) -> decltype(keyMap.find(std::declval<const typename KeyMap::key_type&>()))
     {
-        return keyMap.find(key);
+        if constexpr(std::is_same<Key, typename KeyMap::key_type>::value || detail::HasTransparentFind<KeyMap, Key>::value)
+            return keyMap.find(key);
+        else
+            return keyMap.find(typename KeyMap::key_type(key));
     }
 
 public:
@@ -576,9 +754,66 @@ public:
      */
     Key2ConstIterator find(const Key2& key) const { return T_find(key, _key2Map); }
 
+public:
+    /**
+     * \brief Finds an element with first key equivalent to key, without building a Key1.
+     * \param key lookup key, std::string_view for a std::string for example
+     * \return Iterator to an element with key equivalent to key. If no such element is found, past-the-end (see end()) iterator is returned.
+     */
+    template<typename Key, EnableIfLookupKey<Key, Key1Map> = 0>
+    Key1Iterator find(const Key& key)
+    {
+        return T_find(key, _key1Map);
+    }
+
+    /**
+     * \brief Finds an element with first key equivalent to key, without building a Key1.
+     * \param key lookup key, std::string_view for a std::string for example
+     * \return Iterator to an element with key equivalent to key. If no such element is found, past-the-end (see end()) iterator is returned.
+     */
+    template<typename Key, EnableIfLookupKey<Key, Key1Map> = 0>
+    Key1ConstIterator find(const Key& key) const
+    {
+        return T_find(key, _key1Map);
+    }
+
+    /**
+     * \brief Finds an element with second key equivalent to key, without building a Key2.
+     * \param key lookup key, raw pointer for a std::unique_ptr for example
+     * \return Iterator to an element with key equivalent to key. If no such element is found, past-the-end (see end2()) iterator is returned.
+     */
+    template<typename Key, EnableIfLookupKey<Key, Key2Map> = 0>
+    Key2Iterator find(const Key& key)
+    {
+        return T_find(key, _key2Map);
+    }
+
+    /**
+     * \brief Finds an element with second key equivalent to key, without building a Key2.
+     * \param key lookup key, raw pointer for a std::unique_ptr for example
+     * \return Iterator to an element with key equivalent to key. If no such element is found, past-the-end (see end2()) iterator is returned.
+     */
+    template<typename Key, EnableIfLookupKey<Key, Key2Map> = 0>
+    Key2ConstIterator find(const Key& key) const
+    {
+        return T_find(key, _key2Map);
+    }
+
 public:
     bool contains(const Key1& value) const { return find(value) != end1(); }
     bool contains(const Key2& value) const { return find(value) != end2(); }
+
+    template<typename Key, EnableIfLookupKey<Key, Key1Map> = 0>
+    bool contains(const Key& value) const
+    {
+        return T_find(value, _key1Map) != end1();
+    }
+
+    template<typename Key, EnableIfLookupKey<Key, Key2Map> = 0>
+    bool contains(const Key& value) const
+    {
+        return T_find(value, _key2Map) != end2();
+    }
 };
 
 }
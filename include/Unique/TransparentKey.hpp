@@ -0,0 +1,182 @@
+#ifndef __UNIQUE_TRANSPARENT_KEY_HPP__
+#define __UNIQUE_TRANSPARENT_KEY_HPP__
+
+// ─────────────────────────────────────────────────────────────
+//                  INCLUDE
+// ─────────────────────────────────────────────────────────────
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+// ─────────────────────────────────────────────────────────────
+//                  DECLARATION
+// ─────────────────────────────────────────────────────────────
+
+namespace unique {
+
+// ─────────────────────────────────────────────────────────────
+//                  LOOKUP VIEW
+// ─────────────────────────────────────────────────────────────
+
+/**
+ * View used to compare and hash a key, so that a key can be looked up without building a Key:
+ * std::basic_string by std::basic_string_view, std::unique_ptr and std::shared_ptr by raw pointer.
+ * Other keys are their own view.
+ * keyFromView tell if a key built from a view is equal to the keys of that view, so that it can stand
+ * for the view in maps without heterogeneous lookup. It isn't the case for smart pointers, that would own the pointer.
+ */
+template<class Key>
+struct KeyLookup
+{
+    using type = Key;
+    static constexpr bool keyFromView = false;
+    static const Key& view(const Key& key) noexcept { return key; }
+};
+
+template<class Char, class Traits, class Allocator>
+struct KeyLookup<std::basic_string<Char, Traits, Allocator>>
+{
+    using type = std::basic_string_view<Char, Traits>;
+    static constexpr bool keyFromView = true;
+    static type view(const std::basic_string<Char, Traits, Allocator>& key) noexcept { return key; }
+};
+
+template<class Char, class Traits>
+struct KeyLookup<std::basic_string_view<Char, Traits>>
+{
+    using type = std::basic_string_view<Char, Traits>;
+    static constexpr bool keyFromView = true;
+    static type view(const std::basic_string_view<Char, Traits> key) noexcept { return key; }
+};
+
+template<class T, class Deleter>
+struct KeyLookup<std::unique_ptr<T, Deleter>>
+{
+    using type = typename std::unique_ptr<T, Deleter>::pointer;
+    static constexpr bool keyFromView = false;
+    static type view(const std::unique_ptr<T, Deleter>& key) noexcept { return key.get(); }
+};
+
+template<class T>
+struct KeyLookup<std::shared_ptr<T>>
+{
+    using type = typename std::shared_ptr<T>::element_type*;
+    static constexpr bool keyFromView = false;
+    static type view(const std::shared_ptr<T>& key) noexcept { return key.get(); }
+};
+
+template<class Key>
+using KeyLookupType = typename KeyLookup<Key>::type;
+
+/** \brief View of key to compare and hash it. See KeyLookup */
+template<class Key>
+decltype(auto) lookupView(const Key& key) noexcept
+{
+    return KeyLookup<Key>::view(key);
+}
+
+// ─────────────────────────────────────────────────────────────
+//                  FUNCTORS
+// ─────────────────────────────────────────────────────────────
+
+/** Transparent std::less on lookup views, std::string compared with std::string_view for example */
+struct TransparentLess
+{
+    using is_transparent = void;
+
+    template<class A, class B>
+    bool operator()(const A& a, const B& b) const
+    {
+        return std::less<>()(lookupView(a), lookupView(b));
+    }
+};
+
+/** Transparent std::hash on lookup views. The views hash like their keys: std::hash<std::string_view> is the hash of std::string */
+struct TransparentHash
+{
+    using is_transparent = void;
+
+    template<class Key>
+    std::size_t operator()(const Key& key) const
+    {
+        return std::hash<KeyLookupType<Key>>()(lookupView(key));
+    }
+};
+
+/** Transparent std::equal_to on lookup views */
+struct TransparentEqual
+{
+    using is_transparent = void;
+
+    template<class A, class B>
+    bool operator()(const A& a, const B& b) const
+    {
+        return std::equal_to<>()(lookupView(a), lookupView(b));
+    }
+};
+
+// ─────────────────────────────────────────────────────────────
+//                  TRAITS
+// ─────────────────────────────────────────────────────────────
+
+namespace detail {
+
+template<class Map, class = void>
+struct HasTransparentCompare : std::false_type
+{
+};
+
+template<class Map>
+struct HasTransparentCompare<Map, std::void_t<typename Map::key_compare::is_transparent>> : std::true_type
+{
+};
+
+template<class Map, class = void>
+struct HasTransparentHash : std::false_type
+{
+};
+
+template<class Map>
+struct HasTransparentHash<Map, std::void_t<typename Map::hasher::is_transparent, typename Map::key_equal::is_transparent>>
+    : std::true_type
+{
+};
+
+/**
+ * True when map.find(key) compile with transparent functors, so that no key_type is built.
+ * std::map has heterogeneous find since C++14, std::unordered_map since C++20
+ */
+template<class Map, class Key, class = void>
+struct HasTransparentFind : std::false_type
+{
+};
+
+template<class Map, class Key>
+struct HasTransparentFind<Map, Key, std::void_t<decltype(std::declval<const Map&>().find(std::declval<const Key&>()))>>
+    : std::integral_constant<bool, HasTransparentCompare<Map>::value || HasTransparentHash<Map>::value>
+{
+};
+
+/**
+ * True when Key can be looked up in Map instead of its key_type: Key isn't key_type but has the same lookup view,
+ * and the map either has heterogeneous lookup or accept a key_type built from the view
+ */
+template<class Map, class Key>
+struct IsLookupKey
+    : std::integral_constant<bool,
+          !std::is_same<Key, typename Map::key_type>::value &&
+              std::is_same<KeyLookupType<Key>, KeyLookupType<typename Map::key_type>>::value &&
+              (HasTransparentFind<Map, Key>::value || KeyLookup<typename Map::key_type>::keyFromView)>
+{
+};
+
+}
+
+}
+
+#endif
@@ -7,8 +7,36 @@
 
 // Library code
 #include <Unique/IdProvider.hpp>
+#include <Unique/DynamicIdProvider.hpp>
+#include <Unique/ShardedIdProvider.hpp>
+#include <Unique/IdSnapshot.hpp>
+#include <Unique/JournaledIdProvider.hpp>
+#include <Unique/IdCompactionPlan.hpp>
+#include <Unique/FixedIdProvider.hpp>
+#include <Unique/ConcurrentIdProvider.hpp>
+#include <Unique/SharedIdProvider.hpp>
+#include <Unique/BlockingIdProvider.hpp>
+#include <Unique/LeasedIdProvider.hpp>
+#include <Unique/HiLoIdProvider.hpp>
+#include <Unique/IdCache.hpp>
+#include <Unique/GenerationalIdProvider.hpp>
+#include <Unique/SlotMap.hpp>
+#include <Unique/IntervalIdStorage.hpp>
+#include <Unique/SetIdStorage.hpp>
+#include <Unique/BitmapIdStorage.hpp>
+#include <Unique/LinkedIdStorage.hpp>
+#include <Unique/PagedIdStorage.hpp>
 #include <Unique/TMap.hpp>
+#include <Unique/TransparentKey.hpp>
 #include <Unique/Map.hpp>
 #include <Unique/UnorderedMap.hpp>
+#include <Unique/DenseMap.hpp>
+#include <Unique/FlatHashMap.hpp>
+#include <Unique/FlatUnorderedMap.hpp>
+#include <Unique/SortedVectorMap.hpp>
+#include <Unique/FlatMap.hpp>
+#include <Unique/BPlusTree.hpp>
+#include <Unique/BTreeMap.hpp>
+#include <Unique/FixedMap.hpp>
 
 #endif
@@ -18,6 +18,11 @@ namespace unique {
 //                  CLASS
 // ─────────────────────────────────────────────────────────────
 
+/**
+ * Map on two std::unordered_map. find, contains and erase also accept lookup keys that build a key,
+ * like std::string_view for std::string keys: the key is built for each lookup. See KeyLookup.
+ * TransparentUnorderedMap look them up without building a key
+ */
 template <class Key1, class Key2>
 class UnorderedMap : public TMap<std::unordered_map, std::unordered_map, Key1, Key2>
 {
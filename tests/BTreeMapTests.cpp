@@ -0,0 +1,143 @@
+// C++ Header
+
+// gtest framework
+#include <gtest/gtest.h>
+
+// Unique
+#include <Unique/BTreeMap.hpp>
+#include <Unique/Map.hpp>
+
+// Std
+#include <array>
+#include <iterator>
+#include <map>
+#include <random>
+#include <string>
+
+using namespace unique;
+
+namespace {
+
+/** Pairs of 150 bytes, so that leaves hold 4 pairs and the tree is deep with a few thousands pairs */
+using Payload = std::array<char, 120>;
+
+Payload payloadOf(const std::string& key)
+{
+    Payload payload {};
+    std::copy(key.begin(), key.end(), payload.begin());
+    return payload;
+}
+
+}
+
+TEST(UniqueBPlusTreeTests, matchMap)
+{
+    using Tree = BPlusTree<std::string, Payload>;
+    static_assert(Tree::LEAF_CAPACITY == 4, "Leaves should be small to test rebalancing");
+
+    Tree tree;
+    std::map<std::string, Payload> reference;
+    std::mt19937 rng(13);
+    std::uniform_int_distribution<uint32_t> key(0, 5000);
+
+    for(int i = 0; i < 100000; ++i)
+    {
+        const auto k = std::to_string(key(rng));
+        switch(rng() % 5)
+        {
+        case 0:
+            ASSERT_EQ(tree.erase(k), reference.erase(k));
+            break;
+        case 1:
+        {
+            // ) erase by iterator return the same next pair
+            const auto it = tree.lower_bound(k);
+            const auto expected = reference.lower_bound(k);
+            ASSERT_EQ(it == tree.end(), expected == reference.end());
+            if(it != tree.end())
+            {
+                const auto next = tree.erase(it);
+                const auto expectedNext = reference.erase(expected);
+                ASSERT_EQ(next == tree.end(), expectedNext == reference.end());
+                if(next != tree.end())
+                {
+                    ASSERT_EQ(next->first, expectedNext->first);
+                }
+            }
+            break;
+        }
+        case 2:
+        {
+            // ) Right and wrong hints give the same tree
+            const auto hint = rng() % 2 ? tree.lower_bound(k) : tree.begin();
+            const auto it = tree.insert(hint, {k, payloadOf(k)});
+            reference.insert({k, payloadOf(k)});
+            ASSERT_EQ(it->first, k);
+            break;
+        }
+        default:
+            ASSERT_EQ(tree.try_emplace(k, payloadOf(k)).second, reference.try_emplace(k, payloadOf(k)).second);
+            break;
+        }
+        ASSERT_EQ(tree.size(), reference.size());
+    }
+
+    ASSERT_EQ(std::distance(tree.begin(), tree.end()), static_cast<std::ptrdiff_t>(reference.size()));
+    auto expected = reference.rbegin();
+    for(auto it = tree.end(); it != tree.begin(); ++expected)
+    {
+        --it;
+        ASSERT_EQ(it->first, expected->first);
+        ASSERT_EQ(it->second, expected->second);
+    }
+
+    // ) Copies are deep, erasing every pair free the root
+    const Tree copy = tree;
+    for(const auto& pair: reference) ASSERT_EQ(tree.erase(pair.first), 1);
+    EXPECT_TRUE(tree.empty());
+    EXPECT_EQ(tree.begin(), tree.end());
+    EXPECT_EQ(copy.size(), reference.size());
+    EXPECT_TRUE(std::equal(copy.begin(), copy.end(), reference.begin(), reference.end(),
+        [](const auto& a, const auto& b) { return a.first == b.first && a.second == b.second; }));
+}
+
+TEST(UniqueBTreeMapTests, matchMap)
+{
+    BTreeMap<uint32_t, std::string> tree;
+    Map<uint32_t, std::string> reference;
+    std::mt19937 rng(17);
+    std::uniform_int_distribution<uint32_t> key(0, 20000);
+
+    for(int i = 0; i < 100000; ++i)
+    {
+        const auto key1 = key(rng);
+        const auto key2 = std::to_string(key(rng));
+        switch(rng() % 5)
+        {
+        case 0:
+            ASSERT_EQ(tree.erase(key1), reference.erase(key1));
+            break;
+        case 1:
+            ASSERT_EQ(tree.erase(key2), reference.erase(key2));
+            break;
+        case 2:
+        {
+            const auto newKey1 = key(rng);
+            if(reference.contains(key2))
+            {
+                ASSERT_EQ(tree.move(key2, newKey1), reference.move(key2, newKey1));
+            }
+            break;
+        }
+        default:
+            ASSERT_EQ(tree.insert({key1, key2}).second, reference.insert({key1, key2}).second);
+            break;
+        }
+        ASSERT_EQ(tree.size(), reference.size());
+    }
+
+    EXPECT_TRUE(std::equal(tree.begin1(), tree.end1(), reference.begin1(), reference.end1(),
+        [](const auto& a, const auto& b) { return a.first == b.first && a.second == b.second; }));
+    EXPECT_TRUE(std::equal(tree.begin2(), tree.end2(), reference.begin2(), reference.end2(),
+        [](const auto& a, const auto& b) { return a.first == b.first && a.second == b.second; }));
+}
@@ -0,0 +1,86 @@
+// C++ Header
+
+// gtest framework
+#include <gtest/gtest.h>
+
+// Unique
+#include <Unique/BlockingIdProvider.hpp>
+#include <Unique/IdProvider.hpp>
+
+// Std
+#include <chrono>
+#include <set>
+#include <thread>
+#include <vector>
+
+using namespace unique;
+
+using BoundedIdProvider = BlockingIdProvider<IdProvider<uint32_t, 0, 4>>;
+
+namespace {
+
+/** Wait until count threads are parked in the provider */
+void waitForWaiters(const BoundedIdProvider& idProvider, const std::size_t count)
+{
+    while(idProvider.countOfWaiters() < count) std::this_thread::yield();
+}
+
+}
+
+TEST(UniqueBlockingIdProviderTests, tryTake)
+{
+    BoundedIdProvider idProvider;
+    for(uint32_t id = 0; id < 4; ++id) ASSERT_EQ(id, *idProvider.tryTakeNextId());
+
+    // ) The pool is exhausted, nothing is handed out instead of MAX
+    ASSERT_FALSE(idProvider.areIdsAvailables());
+    ASSERT_FALSE(idProvider.tryTakeNextId().has_value());
+    ASSERT_FALSE(idProvider.tryTakeNextIdFor(std::chrono::milliseconds(10)).has_value());
+    EXPECT_EQ(idProvider.countOfWaiters(), 0);
+
+    idProvider.releaseId(2);
+    ASSERT_EQ(2u, *idProvider.tryTakeNextIdFor(std::chrono::milliseconds(10)));
+    EXPECT_EQ(idProvider.countOfTakenIds(), 4);
+}
+
+TEST(UniqueBlockingIdProviderTests, wakeOnRelease)
+{
+    BoundedIdProvider idProvider;
+    for(int i = 0; i < 4; ++i) idProvider.takeNextIdWait();
+
+    uint32_t waitedId = 4;
+    std::thread waiter([&] { waitedId = idProvider.takeNextIdWait(); });
+    waitForWaiters(idProvider, 1);
+    idProvider.releaseId(1);
+    waiter.join();
+    EXPECT_EQ(waitedId, 1u);
+    EXPECT_EQ(idProvider.countOfWaiters(), 0);
+}
+
+TEST(UniqueBlockingIdProviderTests, wakeInBatch)
+{
+    BoundedIdProvider idProvider;
+    for(int i = 0; i < 4; ++i) idProvider.takeNextIdWait();
+
+    // ) Each released id serve exactly one of the parked threads
+    const std::size_t threadCount = 6;
+    std::vector<std::optional<uint32_t>> ids(threadCount);
+    std::vector<std::thread> threads;
+    for(std::size_t i = 0; i < threadCount; ++i)
+        threads.emplace_back([&, i] { ids[i] = idProvider.tryTakeNextIdFor(std::chrono::milliseconds(500)); });
+    waitForWaiters(idProvider, threadCount);
+
+    idProvider.releaseIdRange(0, 3);
+    for(auto& thread: threads) thread.join();
+
+    std::set<uint32_t> served;
+    for(const auto& id: ids)
+    {
+        if(id)
+        {
+            ASSERT_TRUE(served.insert(*id).second);
+        }
+    }
+    EXPECT_EQ(served, std::set<uint32_t>({0, 1, 2}));
+    EXPECT_EQ(idProvider.countOfTakenIds(), 4);
+}
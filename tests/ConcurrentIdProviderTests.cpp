@@ -0,0 +1,143 @@
+// C++ Header
+
+// gtest framework
+#include <gtest/gtest.h>
+
+// Unique
+#include <Unique/ConcurrentIdProvider.hpp>
+
+// Std
+#include <atomic>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace unique;
+
+TEST(UniqueConcurrentIdProviderTests, singleThread)
+{
+    ConcurrentIdProvider<uint32_t, 1, 0xFFFFFFFF> idProvider;
+
+    ASSERT_EQ(1u, idProvider.takeNextId());
+    ASSERT_EQ(2u, idProvider.takeNextId());
+    ASSERT_TRUE(idProvider.takeId(4));
+    ASSERT_FALSE(idProvider.takeId(2));
+    ASSERT_EQ(3u, idProvider.takeNextId());
+    ASSERT_EQ(5u, idProvider.takeNextId());
+    EXPECT_EQ(idProvider.countOfTakenIds(), 5);
+    EXPECT_EQ(idProvider.getNextEndId(), 6u);
+
+    // ) Released ids are recycled last in first out
+    idProvider.releaseId(2);
+    idProvider.releaseId(4);
+    ASSERT_TRUE(idProvider.isIdAvailable(2));
+    ASSERT_TRUE(idProvider.isIdTaken(3));
+    EXPECT_EQ(idProvider.countOfAvailableIds(), 2);
+    ASSERT_EQ(4u, idProvider.takeNextId());
+
+    // ) 2 is taken while it is still linked in the free stack, it must not be handed out again
+    ASSERT_TRUE(idProvider.takeId(2));
+    ASSERT_EQ(6u, idProvider.takeNextId());
+    idProvider.releaseId(2);
+    ASSERT_EQ(2u, idProvider.takeNextId());
+    ASSERT_EQ(7u, idProvider.takeNextId());
+
+    // ) Ids far above the counter don't allocate the pages in between
+    ASSERT_TRUE(idProvider.takeId(4000000000u));
+    ASSERT_TRUE(idProvider.isIdAvailable(3999999999u));
+    EXPECT_EQ(idProvider.getNextEndId(), 4000000001u);
+    EXPECT_EQ(idProvider.countOfTakenIds(), 8);
+
+    idProvider.clear();
+    EXPECT_EQ(idProvider.countOfTakenIds(), 0);
+    ASSERT_EQ(1u, idProvider.takeNextId());
+}
+
+TEST(UniqueConcurrentIdProviderTests, exhaustion)
+{
+    ConcurrentIdProvider<uint8_t, 0, 4> idProvider;
+    ASSERT_EQ(0, idProvider.takeNextId());
+    ASSERT_EQ(1, idProvider.takeNextId());
+    ASSERT_EQ(2, idProvider.takeNextId());
+    ASSERT_EQ(3, idProvider.takeNextId());
+    ASSERT_FALSE(idProvider.areIdsAvailables());
+    idProvider.releaseId(1);
+    ASSERT_TRUE(idProvider.areIdsAvailables());
+    ASSERT_EQ(1, idProvider.takeNextId());
+}
+
+TEST(UniqueConcurrentIdProviderTests, uniquenessUnderContention)
+{
+    using Provider = ConcurrentIdProvider<uint32_t, 1, 0xFFFFFFFF>;
+    Provider idProvider;
+
+    const auto threadCount = std::max(8u, 2 * std::thread::hardware_concurrency());
+    constexpr int iterations = 20000;
+    constexpr uint32_t idSpace = 1 << 16;
+
+    // ) Each id own a flag, set by the thread that got it. Setting an already set flag mean the id was handed out twice
+    std::unique_ptr<std::atomic<uint8_t>[]> owned(new std::atomic<uint8_t>[idSpace + 1]);
+    for(uint32_t i = 0; i <= idSpace; ++i) owned[i].store(0);
+    std::atomic<int> duplicates {0};
+    std::atomic<bool> start {false};
+
+    std::vector<std::thread> threads;
+    for(unsigned t = 0; t < threadCount; ++t)
+    {
+        threads.emplace_back([&, t]()
+        {
+            std::mt19937 rng(t);
+            std::vector<uint32_t> ids;
+            while(!start.load()) std::this_thread::yield();
+
+            for(int i = 0; i < iterations; ++i)
+            {
+                const auto action = rng() % 8;
+                if(action < 4 || ids.empty())
+                {
+                    const auto id = idProvider.takeNextId();
+                    ASSERT_LE(id, idSpace);
+                    if(owned[id].exchange(1))
+                        ++duplicates;
+                    ids.push_back(id);
+                }
+                else if(action < 5)
+                {
+                    // ) Compete with takeNextId on ids that may be linked in the free stack
+                    const auto id = 1 + rng() % 1024;
+                    if(idProvider.takeId(id))
+                    {
+                        if(owned[id].exchange(1))
+                            ++duplicates;
+                        ids.push_back(id);
+                    }
+                }
+                else
+                {
+                    const auto index = rng() % ids.size();
+                    const auto id = ids[index];
+                    ids[index] = ids.back();
+                    ids.pop_back();
+                    if(!owned[id].exchange(0))
+                        ++duplicates;
+                    idProvider.releaseId(id);
+                }
+            }
+
+            for(const auto id: ids)
+            {
+                owned[id].store(0);
+                idProvider.releaseId(id);
+            }
+        });
+    }
+
+    start.store(true);
+    for(auto& thread: threads) thread.join();
+
+    EXPECT_EQ(duplicates.load(), 0);
+    EXPECT_EQ(idProvider.countOfTakenIds(), 0);
+    EXPECT_EQ(idProvider.countOfAvailableIds(), idProvider.getNextEndId() - idProvider.MIN);
+    for(uint32_t id = 1; id < idProvider.getNextEndId(); ++id) ASSERT_TRUE(idProvider.isIdAvailable(id));
+}
@@ -0,0 +1,98 @@
+// C++ Header
+
+// gtest framework
+#include <gtest/gtest.h>
+
+// Unique
+#include <Unique/DenseMap.hpp>
+#include <Unique/Map.hpp>
+
+// Std
+#include <random>
+#include <string>
+
+using namespace unique;
+
+TEST(UniqueDenseMapTests, insertFind)
+{
+    DenseMap<uint32_t, std::string> map;
+    ASSERT_TRUE(map.insert({1, "one"}).second);
+    ASSERT_TRUE(map.insert(std::pair<std::string, uint32_t>("two", 2)).second);
+    ASSERT_FALSE(map.insert({1, "three"}).second);
+    ASSERT_FALSE(map.insert({3, "two"}).second);
+    EXPECT_EQ(map.size(), 2);
+
+    EXPECT_EQ(map.find(1u)->second, "one");
+    EXPECT_EQ(map.find(std::string("two"))->second, 2u);
+    EXPECT_EQ(map.find(3u), map.end());
+    EXPECT_EQ(map.find(std::string("three")), map.end2());
+
+    // ) Both sides iterate the same pairs
+    std::size_t count = 0;
+    for(auto it = map.begin2(); it != map.end2(); ++it, ++count)
+        EXPECT_EQ(map.find(it->second)->second, it->first);
+    EXPECT_EQ(count, 2);
+
+    EXPECT_TRUE(map.move(1u, 4u));
+    EXPECT_FALSE(map.move(1u, 4u));
+    EXPECT_TRUE(map.move(4u, std::string("four")));
+    EXPECT_FALSE(map.move(4u, std::string("two")));
+    EXPECT_TRUE(map.swap(4u, 2u));
+    EXPECT_EQ(map.find(4u)->second, "two");
+    EXPECT_EQ(map.find(std::string("four"))->second, 2u);
+
+    EXPECT_EQ(map.erase(std::string("two")), 1);
+    EXPECT_EQ(map.erase(std::string("two")), 0);
+    EXPECT_FALSE(map.contains(4u));
+    EXPECT_TRUE(map.contains(2u));
+}
+
+TEST(UniqueDenseMapTests, matchMap)
+{
+    // ) Same random operations on a DenseMap and a Map, small key ranges to get collisions
+    DenseMap<uint32_t, std::string> dense;
+    Map<uint32_t, std::string> reference;
+    std::mt19937 rng(5);
+    std::uniform_int_distribution<uint32_t> key(0, 2000);
+    std::uniform_int_distribution<int> operation(0, 9);
+
+    for(int i = 0; i < 100000; ++i)
+    {
+        const auto key1 = key(rng);
+        const auto key2 = std::to_string(key(rng));
+        switch(operation(rng))
+        {
+        case 0:
+            ASSERT_EQ(dense.erase(key1), reference.erase(key1));
+            break;
+        case 1:
+            ASSERT_EQ(dense.erase(key2), reference.erase(key2));
+            break;
+        case 2:
+        {
+            const auto newKey1 = key(rng);
+            ASSERT_EQ(dense.move(key1, newKey1), reference.move(key1, newKey1));
+            break;
+        }
+        case 3:
+            ASSERT_EQ(dense.move(key1, key2), reference.move(key1, key2));
+            break;
+        case 4:
+        {
+            const auto otherKey1 = key(rng);
+            ASSERT_EQ(dense.swap(key1, otherKey1), reference.swap(key1, otherKey1));
+            break;
+        }
+        default:
+            ASSERT_EQ(dense.insert({key1, key2}).second, reference.insert({key1, key2}).second);
+            break;
+        }
+        ASSERT_EQ(dense.size(), reference.size());
+    }
+
+    for(const auto& pair: reference)
+    {
+        ASSERT_EQ(dense.find(pair.first)->second, pair.second);
+        ASSERT_EQ(dense.find(pair.second)->second, pair.first);
+    }
+}
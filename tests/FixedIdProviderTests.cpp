@@ -0,0 +1,132 @@
+// C++ Header
+
+// gtest framework
+#include <gtest/gtest.h>
+
+// Unique
+#include <Unique/FixedIdProvider.hpp>
+#include <Unique/FixedMap.hpp>
+
+// Std
+#include <cstdint>
+#include <map>
+#include <random>
+
+using namespace unique;
+
+namespace {
+
+constexpr uint32_t nextIdAfterRelease()
+{
+    FixedIdProvider<uint32_t, 1, 200> idProvider;
+    for(int i = 0; i < 150; ++i) idProvider.takeNextId();
+    idProvider.releaseId(70);
+    idProvider.releaseId(3);
+    return idProvider.takeNextId();
+}
+
+constexpr FixedMap<uint32_t, int, 16> makeFixedMap()
+{
+    FixedMap<uint32_t, int, 16> map;
+    for(uint32_t i = 0; i < 10; ++i) map.insert(i, -static_cast<int>(i));
+    map.erase(3u);
+    map.move(4u, 40u);
+    return map;
+}
+
+}
+
+// ) Both are usable in constant expressions
+static_assert(nextIdAfterRelease() == 3, "FixedIdProvider should be constexpr");
+static_assert(makeFixedMap().size() == 9, "FixedMap should be constexpr");
+static_assert(makeFixedMap().find(-4)->first == 40, "FixedMap should be constexpr");
+
+// ) The whole range of T can be used, a negative min included.
+// FixedIdProvider<uint8_t, 0, 300> or FixedIdProvider<int8_t, -128, 256> don't compile: MAX wouldn't fit in T
+static_assert(FixedIdProvider<uint8_t, 0, 255>::MAX == 255, "Capacity should reach the max of T");
+static_assert(FixedIdProvider<uint8_t, 200, 55>::MAX == 255, "Capacity should reach the max of T");
+static_assert(FixedIdProvider<int8_t, -128, 255>::MAX == 127, "Capacity should reach the max of T");
+
+TEST(UniqueFixedIdProviderTests, takeRelease)
+{
+    // ) Capacity isn't a multiple of 64 words, the bits after MAX never show up
+    FixedIdProvider<uint32_t, 10, 64 * 64 + 70> idProvider;
+    using Provider = decltype(idProvider);
+    for(uint32_t id = Provider::MIN; id < Provider::MAX; ++id) ASSERT_EQ(id, idProvider.takeNextId());
+    ASSERT_FALSE(idProvider.areIdsAvailables());
+    EXPECT_EQ(idProvider.getNextId(), Provider::MAX);
+
+    idProvider.releaseId(4100);
+    idProvider.releaseId(20);
+    EXPECT_EQ(idProvider.countOfAvailableIds(), 2);
+    ASSERT_FALSE(idProvider.takeId(21));
+    ASSERT_TRUE(idProvider.takeId(4100));
+    ASSERT_EQ(20u, idProvider.takeNextId());
+
+    idProvider.clear();
+    EXPECT_EQ(idProvider.countOfTakenIds(), 0);
+    ASSERT_TRUE(idProvider.isIdAvailable(Provider::MAX - 1));
+    ASSERT_EQ(10u, idProvider.takeNextId());
+}
+
+TEST(UniqueFixedMapTests, matchStdMap)
+{
+    // ) Random operations on a full table, against two std::map
+    FixedMap<uint32_t, uint64_t, 100> map;
+    std::map<uint32_t, uint64_t> reference;
+    std::map<uint64_t, uint32_t> otherReference;
+    std::mt19937 random(42);
+    for(int i = 0; i < 20000; ++i)
+    {
+        const uint32_t key1 = random() % 150;
+        const uint64_t key2 = random() % 150 + 1000;
+        switch(random() % 4)
+        {
+            case 0:
+            case 1:
+            {
+                const bool inserted = !map.full() && !reference.count(key1) && !otherReference.count(key2);
+                ASSERT_EQ(map.insert(key1, key2), inserted);
+                if(inserted)
+                {
+                    reference[key1] = key2;
+                    otherReference[key2] = key1;
+                }
+                break;
+            }
+            case 2:
+            {
+                const auto it = reference.find(key1);
+                ASSERT_EQ(map.erase(key1), it != reference.end());
+                if(it != reference.end())
+                {
+                    otherReference.erase(it->second);
+                    reference.erase(it);
+                }
+                break;
+            }
+            default:
+            {
+                const auto it = otherReference.find(key2);
+                const auto newKey = key2 + 200;
+                const bool moved = it != otherReference.end() && !otherReference.count(newKey);
+                ASSERT_EQ(map.move(key2, newKey), moved);
+                if(moved)
+                {
+                    reference[it->second] = newKey;
+                    otherReference[newKey] = it->second;
+                    otherReference.erase(it);
+                }
+                break;
+            }
+        }
+        ASSERT_EQ(map.size(), reference.size());
+    }
+
+    for(const auto& entry: map)
+    {
+        ASSERT_EQ(reference.at(entry.first), entry.second);
+        ASSERT_EQ(map.find(entry.second)->first, entry.first);
+    }
+    for(uint32_t key = 0; key < 150; ++key) ASSERT_EQ(map.contains(key), reference.count(key) != 0);
+}
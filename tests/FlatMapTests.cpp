@@ -0,0 +1,126 @@
+// C++ Header
+
+// gtest framework
+#include <gtest/gtest.h>
+
+// Unique
+#include <Unique/FlatMap.hpp>
+#include <Unique/Map.hpp>
+
+// Std
+#include <map>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace unique;
+
+TEST(UniqueSortedVectorMapTests, matchMap)
+{
+    SortedVectorMap<uint32_t, std::string> map;
+    std::map<uint32_t, std::string> reference;
+    std::mt19937 rng(5);
+    std::uniform_int_distribution<uint32_t> key(0, 2000);
+
+    for(int i = 0; i < 50000; ++i)
+    {
+        const auto k = key(rng);
+        switch(rng() % 4)
+        {
+        case 0:
+            ASSERT_EQ(map.erase(k), reference.erase(k));
+            break;
+        case 1:
+        {
+            // ) Right and wrong hints give the same map
+            const auto hint = rng() % 2 ? map.lower_bound(k) : map.begin();
+            map.insert(hint, {k, std::to_string(k)});
+            reference.insert({k, std::to_string(k)});
+            break;
+        }
+        default:
+            ASSERT_EQ(map.try_emplace(k, std::to_string(k)).second, reference.try_emplace(k, std::to_string(k)).second);
+            break;
+        }
+        ASSERT_EQ(map.size(), reference.size());
+        ASSERT_EQ(map.contains(k), reference.count(k) == 1);
+    }
+    EXPECT_TRUE(std::equal(map.begin(), map.end(), reference.begin(), reference.end(),
+        [](const auto& a, const auto& b) { return a.first == b.first && a.second == b.second; }));
+}
+
+TEST(UniqueFlatMapTests, bulkBuild)
+{
+    // ) (3, "b") reuse the Key2 of (1, "b"), and (1, "z") the Key1 of (1, "b"): the first pair wins
+    const std::vector<std::pair<int, std::string>> pairs = {{2, "c"}, {1, "b"}, {3, "b"}, {1, "z"}, {0, "a"}};
+    FlatMap<int, std::string> map(pairs.begin(), pairs.end());
+
+    ASSERT_EQ(map.size(), 3);
+    EXPECT_EQ(map.find(1)->second, "b");
+    EXPECT_FALSE(map.contains(3));
+    EXPECT_FALSE(map.contains("z"));
+    EXPECT_EQ(map.begin1()->first, 0);
+    EXPECT_EQ(map.begin2()->first, "a");
+
+    // ) A batch skip pairs that conflict with the map
+    const std::vector<std::pair<int, std::string>> batch = {{4, "d"}, {2, "e"}, {5, "a"}, {-1, "0"}};
+    EXPECT_EQ(map.insert(batch.begin(), batch.end()), 2);
+    EXPECT_EQ(map.size(), 5);
+    EXPECT_EQ(map.find("0")->second, -1);
+    EXPECT_EQ(map.find(4)->second, "d");
+    EXPECT_EQ(map.find(2)->second, "c");
+
+    // ) Only pairs kept before a pair make it skipped: (11, "y") clash with (10, "y") that was skipped
+    const std::vector<std::pair<int, std::string>> clashes = {{10, "x"}, {10, "y"}, {11, "y"}};
+    EXPECT_EQ(map.insert(clashes.begin(), clashes.end()), 2);
+    EXPECT_EQ(map.find("y")->second, 11);
+}
+
+TEST(UniqueFlatMapTests, matchMap)
+{
+    FlatMap<uint32_t, std::string> flat;
+    Map<uint32_t, std::string> reference;
+    std::mt19937 rng(9);
+    std::uniform_int_distribution<uint32_t> key(0, 3000);
+    std::uniform_int_distribution<uint32_t> batchKey(0, 100);
+
+    for(int round = 0; round < 200; ++round)
+    {
+        // ) Batches on a narrow range, so that their pairs clash. Reference insert them one pair at a time
+        std::vector<std::pair<uint32_t, std::string>> batch;
+        for(int i = 0; i < 40; ++i) batch.emplace_back(batchKey(rng), std::to_string(batchKey(rng)));
+        std::size_t inserted = 0;
+        for(const auto& pair: batch) inserted += reference.insert(pair).second ? 1 : 0;
+        ASSERT_EQ(flat.insert(batch.begin(), batch.end()), inserted);
+
+        for(int i = 0; i < 20; ++i)
+        {
+            const auto key1 = key(rng);
+            const auto key2 = std::to_string(key(rng));
+            switch(rng() % 3)
+            {
+            case 0:
+                ASSERT_EQ(flat.erase(key1), reference.erase(key1));
+                break;
+            case 1:
+                ASSERT_EQ(flat.erase(key2), reference.erase(key2));
+                break;
+            default:
+                ASSERT_EQ(flat.insert({key1, key2}).second, reference.insert({key1, key2}).second);
+                break;
+            }
+        }
+        ASSERT_EQ(flat.size(), reference.size());
+    }
+
+    auto it = flat.begin1();
+    for(auto expected = reference.begin1(); expected != reference.end1(); ++expected, ++it)
+    {
+        ASSERT_EQ(it->first, expected->first);
+        ASSERT_EQ(flat.find(expected->second)->second, expected->first);
+    }
+    auto it2 = flat.begin2();
+    for(auto expected = reference.begin2(); expected != reference.end2(); ++expected, ++it2)
+        ASSERT_EQ(it2->first, expected->first);
+}
@@ -0,0 +1,108 @@
+// C++ Header
+
+// gtest framework
+#include <gtest/gtest.h>
+
+// Unique
+#include <Unique/FlatUnorderedMap.hpp>
+#include <Unique/UnorderedMap.hpp>
+
+// Std
+#include <random>
+#include <string>
+#include <unordered_map>
+
+using namespace unique;
+
+namespace {
+
+/** Every key in a few probe groups, to test long probes and tombstones */
+struct CollidingHash
+{
+    std::size_t operator()(const uint32_t key) const { return key % 4; }
+};
+
+}
+
+TEST(UniqueFlatHashMapTests, matchUnorderedMap)
+{
+    FlatHashMap<uint32_t, std::string> map;
+    FlatHashMap<uint32_t, int, CollidingHash> colliding;
+    std::unordered_map<uint32_t, std::string> reference;
+    std::mt19937 rng(11);
+    std::uniform_int_distribution<uint32_t> key(0, 3000);
+
+    for(int i = 0; i < 100000; ++i)
+    {
+        const auto k = key(rng);
+        if(rng() % 3 == 0)
+        {
+            ASSERT_EQ(map.erase(k), reference.erase(k));
+            colliding.erase(k % 200);
+        }
+        else
+        {
+            const auto value = std::to_string(k * 7);
+            ASSERT_EQ(map.insert({k, value}).second, reference.insert({k, value}).second);
+            colliding.try_emplace(k % 200, int(k % 200));
+        }
+        ASSERT_EQ(map.size(), reference.size());
+    }
+
+    std::size_t count = 0;
+    for(const auto& pair: map)
+    {
+        ASSERT_EQ(reference.at(pair.first), pair.second);
+        ++count;
+    }
+    EXPECT_EQ(count, reference.size());
+    for(const auto& pair: colliding) EXPECT_EQ(colliding.find(pair.first)->second, int(pair.first));
+
+    // ) reserve keep every pair and make room for the next inserts
+    map.reserve(10000);
+    const auto capacity = map.capacity();
+    for(uint32_t k = 5000; map.size() < 10000; ++k) map.try_emplace(k, "value");
+    EXPECT_EQ(map.capacity(), capacity);
+    for(const auto& pair: reference) EXPECT_EQ(map.find(pair.first)->second, pair.second);
+}
+
+TEST(UniqueFlatUnorderedMapTests, matchUnorderedMap)
+{
+    FlatUnorderedMap<uint32_t, std::string> flat;
+    UnorderedMap<uint32_t, std::string> reference;
+    flat.reserve(1000);
+    EXPECT_GE(flat.capacity(), 1000);
+
+    std::mt19937 rng(3);
+    std::uniform_int_distribution<uint32_t> key(0, 2000);
+    for(int i = 0; i < 50000; ++i)
+    {
+        const auto key1 = key(rng);
+        const auto key2 = std::to_string(key(rng));
+        switch(rng() % 6)
+        {
+        case 0:
+            ASSERT_EQ(flat.erase(key1), reference.erase(key1));
+            break;
+        case 1:
+            ASSERT_EQ(flat.erase(key2), reference.erase(key2));
+            break;
+        case 2:
+        {
+            const auto newKey1 = key(rng);
+            ASSERT_EQ(flat.move(key1, newKey1), reference.move(key1, newKey1));
+            break;
+        }
+        default:
+            ASSERT_EQ(flat.insert({key1, key2}).second, reference.insert({key1, key2}).second);
+            break;
+        }
+        ASSERT_EQ(flat.size(), reference.size());
+    }
+
+    for(auto it = reference.begin1(); it != reference.end1(); ++it)
+    {
+        ASSERT_EQ(flat.find(it->first)->second, it->second);
+        ASSERT_EQ(flat.find(it->second)->second, it->first);
+    }
+}
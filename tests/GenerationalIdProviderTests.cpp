@@ -0,0 +1,138 @@
+// C++ Header
+
+// gtest framework
+#include <gtest/gtest.h>
+
+// Unique
+#include <Unique/GenerationalIdProvider.hpp>
+#include <Unique/SlotMap.hpp>
+
+// Std
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+using namespace unique;
+
+TEST(UniqueGenerationalIdProviderTests, staleHandles)
+{
+    GenerationalIdProvider<uint32_t, 16> idProvider;
+
+    const auto a = idProvider.takeNextId();
+    const auto b = idProvider.takeNextId();
+    ASSERT_EQ(idProvider.indexOf(a), 0u);
+    ASSERT_EQ(idProvider.indexOf(b), 1u);
+    ASSERT_TRUE(idProvider.isValid(a));
+    ASSERT_TRUE(idProvider.isValid(b));
+    ASSERT_FALSE(idProvider.isValid(0));
+
+    // ) Slot 0 is reused immediately, but with another generation
+    ASSERT_TRUE(idProvider.releaseId(a));
+    ASSERT_FALSE(idProvider.releaseId(a));
+    const auto c = idProvider.takeNextId();
+    ASSERT_EQ(idProvider.indexOf(c), 0u);
+    ASSERT_NE(a, c);
+    ASSERT_FALSE(idProvider.isValid(a));
+    ASSERT_TRUE(idProvider.isValid(c));
+    EXPECT_EQ(idProvider.countOfTakenIds(), 2);
+    EXPECT_EQ(idProvider.slotCount(), 2);
+
+    idProvider.clear();
+    ASSERT_FALSE(idProvider.isValid(b));
+    ASSERT_FALSE(idProvider.isValid(c));
+    const auto d = idProvider.takeNextId();
+    ASSERT_EQ(idProvider.indexOf(d), 0u);
+    ASSERT_FALSE(idProvider.isValid(c));
+    ASSERT_TRUE(idProvider.isValid(d));
+}
+
+TEST(UniqueGenerationalIdProviderTests, generationWrap)
+{
+    // ) 2 bits of generation: 1 and 3 are the live generations of a slot
+    GenerationalIdProvider<uint8_t, 6> idProvider;
+    const auto a = idProvider.takeNextId();
+    idProvider.releaseId(a);
+    const auto b = idProvider.takeNextId();
+    idProvider.releaseId(b);
+    const auto c = idProvider.takeNextId();
+    ASSERT_EQ(a, c);
+    ASSERT_TRUE(idProvider.isValid(a));
+}
+
+TEST(UniqueSlotMapTests, insertFindErase)
+{
+    SlotMap<std::string> slotMap;
+
+    const auto hello = slotMap.insert("hello");
+    const auto world = slotMap.emplace(3, 'w');
+    ASSERT_EQ(slotMap.size(), 2);
+    ASSERT_EQ(*slotMap.find(hello), "hello");
+    ASSERT_EQ(*slotMap.find(world), "www");
+
+    ASSERT_TRUE(slotMap.erase(hello));
+    ASSERT_FALSE(slotMap.erase(hello));
+    ASSERT_EQ(slotMap.find(hello), nullptr);
+
+    // ) Value reuse the slot of hello, old handle still doesn't resolve
+    const auto reused = slotMap.insert("reused");
+    ASSERT_EQ(decltype(slotMap)::Handles::indexOf(reused), decltype(slotMap)::Handles::indexOf(hello));
+    ASSERT_FALSE(slotMap.contains(hello));
+    ASSERT_EQ(*slotMap.find(reused), "reused");
+
+    slotMap.clear();
+    ASSERT_TRUE(slotMap.empty());
+    ASSERT_FALSE(slotMap.contains(world));
+    ASSERT_FALSE(slotMap.contains(reused));
+}
+
+TEST(UniqueSlotMapTests, valuesSurviveGrowth)
+{
+    SlotMap<std::unique_ptr<int>> slotMap;
+    std::vector<uint64_t> handles;
+    for(int i = 0; i < 1000; ++i) handles.push_back(slotMap.emplace(new int(i)));
+
+    for(int i = 0; i < 1000; i += 2) ASSERT_TRUE(slotMap.erase(handles[i]));
+    for(int i = 0; i < 1000; ++i)
+    {
+        const auto* value = slotMap.find(handles[i]);
+        if(i % 2)
+        {
+            ASSERT_NE(value, nullptr);
+            ASSERT_EQ(**value, i);
+        }
+        else
+            ASSERT_EQ(value, nullptr);
+    }
+    ASSERT_EQ(slotMap.size(), 500);
+}
+
+TEST(UniqueSlotMapTests, throwingConstructor)
+{
+    struct Throwing
+    {
+        explicit Throwing(const int value) : value(value)
+        {
+            if(value < 0)
+                throw std::runtime_error("negative");
+        }
+        int value;
+    };
+
+    // ) A throwing constructor give the index back, in a new slot or a reused one
+    SlotMap<Throwing> slotMap;
+    ASSERT_THROW(slotMap.emplace(-1), std::runtime_error);
+    EXPECT_TRUE(slotMap.empty());
+    const auto first = slotMap.emplace(1);
+    const auto second = slotMap.emplace(2);
+    ASSERT_TRUE(slotMap.erase(first));
+    ASSERT_THROW(slotMap.emplace(-2), std::runtime_error);
+    EXPECT_EQ(slotMap.size(), 1);
+
+    // ) Both slots are still usable
+    const auto third = slotMap.emplace(3);
+    const auto fourth = slotMap.emplace(4);
+    EXPECT_EQ(slotMap.find(second)->value, 2);
+    EXPECT_EQ(slotMap.find(third)->value, 3);
+    EXPECT_EQ(slotMap.find(fourth)->value, 4);
+    EXPECT_EQ(slotMap.size(), 3);
+}
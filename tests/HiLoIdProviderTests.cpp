@@ -0,0 +1,87 @@
+// C++ Header
+
+// gtest framework
+#include <gtest/gtest.h>
+
+// Unique
+#include <Unique/HiLoIdProvider.hpp>
+#include <Unique/IdProvider.hpp>
+
+// Std
+#include <set>
+#include <thread>
+#include <vector>
+
+using namespace unique;
+
+using Coordinator = LocalBlockCoordinator<IdProvider<uint32_t, 0, 1000000>>;
+
+TEST(UniqueHiLoIdProviderTests, roundTripPerBlock)
+{
+    Coordinator coordinator;
+    {
+        HiLoIdProvider<Coordinator> node(coordinator, 100);
+        for(uint32_t id = 0; id < 1000; ++id) ASSERT_EQ(node.takeNextId(), id);
+        EXPECT_EQ(node.countOfTakenIds(), 1000);
+
+        // ) One lease per block, plus the prefetch of the next one
+        EXPECT_LE(coordinator.countOfLeases(), 11);
+        EXPECT_GE(coordinator.countOfLeases(), 10);
+
+        node.releaseId(10);
+        ASSERT_EQ(node.takeNextId(), 10u);
+        node.releaseId(20);
+    }
+
+    // ) Unused tails and released ids went back to the coordinator
+    EXPECT_EQ(coordinator.countOfLeasedIds(), 999);
+
+    // ) Blocks are leased where they fit whole, single holes are left for the end
+    HiLoIdProvider<Coordinator> other(coordinator, 100);
+    EXPECT_EQ(other.takeNextId(), 1000u);
+}
+
+TEST(UniqueHiLoIdProviderTests, exhaustion)
+{
+    LocalBlockCoordinator<IdProvider<uint16_t, 0, 250>> coordinator;
+    HiLoIdProvider<LocalBlockCoordinator<IdProvider<uint16_t, 0, 250>>> node(coordinator, 100);
+
+    std::set<uint16_t> ids;
+    while(const auto id = node.tryTakeNextId()) ASSERT_TRUE(ids.insert(*id).second);
+    EXPECT_EQ(ids.size(), 250);
+    EXPECT_FALSE(node.tryTakeNextId().has_value());
+
+    node.releaseId(42);
+    EXPECT_EQ(*node.tryTakeNextId(), 42);
+}
+
+TEST(UniqueHiLoIdProviderTests, concurrentNodes)
+{
+    Coordinator coordinator;
+    const std::size_t nodeCount = 4;
+    std::vector<std::vector<uint32_t>> ids(nodeCount);
+    std::vector<std::thread> threads;
+    for(std::size_t i = 0; i < nodeCount; ++i)
+    {
+        threads.emplace_back([&, i] {
+            HiLoIdProvider<Coordinator> node(coordinator, 64, 32);
+            for(int j = 0; j < 5000; ++j)
+            {
+                ids[i].push_back(node.takeNextId());
+                if(j % 7 == 0)
+                {
+                    node.releaseId(ids[i].back());
+                    ids[i].pop_back();
+                }
+            }
+        });
+    }
+    for(auto& thread: threads) thread.join();
+
+    std::set<uint32_t> all;
+    for(const auto& nodeIds: ids)
+    {
+        for(const auto id: nodeIds) ASSERT_TRUE(all.insert(id).second);
+    }
+    EXPECT_EQ(coordinator.countOfLeasedIds(), all.size());
+}
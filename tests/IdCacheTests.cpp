@@ -0,0 +1,107 @@
+// C++ Header
+
+// gtest framework
+#include <gtest/gtest.h>
+
+// Unique
+#include <Unique/IdCache.hpp>
+#include <Unique/IdProvider.hpp>
+#include <Unique/SharedIdProvider.hpp>
+
+// Std
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace unique;
+
+using UniqueSharedIdProvider = SharedIdProvider<IdProvider<uint32_t, 1, 0xFFFFFFFF>>;
+
+TEST(UniqueIdCacheTests, batchRefillAndFlush)
+{
+    UniqueSharedIdProvider idProvider;
+    {
+        IdCache<UniqueSharedIdProvider> cache(idProvider, 4, 8);
+
+        // ) First take refill a whole batch, lowest first
+        ASSERT_EQ(1u, cache.takeNextId());
+        EXPECT_EQ(cache.countOfCachedIds(), 3);
+        EXPECT_EQ(idProvider.countOfTakenIds(), 4);
+        ASSERT_EQ(2u, cache.takeNextId());
+        ASSERT_EQ(3u, cache.takeNextId());
+        ASSERT_EQ(4u, cache.takeNextId());
+        EXPECT_EQ(cache.countOfCachedIds(), 0);
+        ASSERT_EQ(5u, cache.takeNextId());
+        EXPECT_EQ(idProvider.countOfTakenIds(), 8);
+
+        // ) Released id are reused from the cache without touching the provider
+        cache.releaseId(2);
+        ASSERT_EQ(2u, cache.takeNextId());
+
+        std::vector<uint32_t> ids;
+        for(int i = 0; i < 12; ++i) ids.push_back(cache.takeNextId());
+        EXPECT_EQ(idProvider.countOfTakenIds(), 20);
+
+        // ) 3 ids were cached, capacity is exceeded twice and 4 oldest ids are flushed each time
+        for(const auto id: ids) cache.releaseId(id);
+        EXPECT_EQ(cache.countOfCachedIds(), 3 + 12 - 2 * 4);
+        EXPECT_EQ(idProvider.countOfTakenIds(), 20 - 8);
+    }
+
+    // ) Destruction drain the cache
+    EXPECT_EQ(idProvider.countOfTakenIds(), 5);
+    ASSERT_TRUE(idProvider.isIdTaken(5));
+    ASSERT_TRUE(idProvider.isIdAvailable(6));
+}
+
+TEST(UniqueIdCacheTests, drainOnThreadExit)
+{
+    UniqueSharedIdProvider idProvider;
+    constexpr int threadCount = 8;
+    constexpr int iterations = 10000;
+    // ) Each thread hold up to iterations / 3 ids, plus the ids in its cache
+    constexpr uint32_t idSpace = threadCount * 4096;
+
+    std::unique_ptr<std::atomic<uint8_t>[]> owned(new std::atomic<uint8_t>[idSpace + 1]);
+    for(uint32_t i = 0; i <= idSpace; ++i) owned[i].store(0);
+    std::atomic<int> duplicates {0};
+
+    std::vector<std::thread> threads;
+    for(int t = 0; t < threadCount; ++t)
+    {
+        threads.emplace_back([&]()
+        {
+            IdCache<UniqueSharedIdProvider> cache(idProvider, 32);
+            std::vector<uint32_t> ids;
+            for(int i = 0; i < iterations; ++i)
+            {
+                if(i % 3 != 2 || ids.empty())
+                {
+                    const auto id = cache.takeNextId();
+                    ASSERT_LE(id, idSpace);
+                    if(owned[id].exchange(1))
+                        ++duplicates;
+                    ids.push_back(id);
+                }
+                else
+                {
+                    const auto id = ids[ids.size() / 2];
+                    ids[ids.size() / 2] = ids.back();
+                    ids.pop_back();
+                    owned[id].store(0);
+                    cache.releaseId(id);
+                }
+            }
+            for(const auto id: ids)
+            {
+                owned[id].store(0);
+                cache.releaseId(id);
+            }
+        });
+    }
+    for(auto& thread: threads) thread.join();
+
+    EXPECT_EQ(duplicates.load(), 0);
+    EXPECT_EQ(idProvider.countOfTakenIds(), 0);
+}
@@ -0,0 +1,99 @@
+// C++ Header
+
+// gtest framework
+#include <gtest/gtest.h>
+
+// Unique
+#include <Unique/IdCompactionPlan.hpp>
+#include <Unique/IdProvider.hpp>
+#include <Unique/Map.hpp>
+
+// Std
+#include <string>
+#include <vector>
+
+using namespace unique;
+
+using CompactionIdProvider = IdProvider<uint32_t, 1, 0xFFFFFFFF>;
+
+TEST(UniqueIdCompactionPlanTests, plan)
+{
+    CompactionIdProvider idProvider;
+    for(uint32_t i = 0; i < 10; ++i) idProvider.takeNextId();
+    idProvider.releaseId(2);
+    idProvider.releaseId(4);
+    idProvider.releaseId(5);
+    idProvider.releaseId(9);
+
+    // ) 6 taken ids: 7, 8 and 10 move into 2, 4 and 5
+    const IdCompactionPlan<uint32_t> plan(idProvider);
+    ASSERT_EQ(plan.size(), 3);
+    EXPECT_EQ(plan.end(), 7u);
+    const uint32_t from[] = {7, 8, 10};
+    const uint32_t to[] = {2, 4, 5};
+    for(std::size_t i = 0; i < plan.size(); ++i)
+    {
+        EXPECT_EQ(plan.remaps()[i].from, from[i]);
+        EXPECT_EQ(plan.remaps()[i].to, to[i]);
+    }
+    EXPECT_EQ(plan.remap(8), 4u);
+    EXPECT_EQ(plan.remap(3), 3u);
+
+    ASSERT_TRUE(plan.apply(idProvider));
+    EXPECT_EQ(idProvider.getNextEndId(), 7u);
+    EXPECT_EQ(idProvider.countOfTakenIds(), 6);
+    for(uint32_t id = 1; id < 7; ++id) ASSERT_TRUE(idProvider.isIdTaken(id));
+    EXPECT_TRUE(IdCompactionPlan<uint32_t>(idProvider).empty());
+
+    // ) A plan is rejected once the provider changed
+    idProvider.releaseId(3);
+    const IdCompactionPlan<uint32_t> stale(idProvider);
+    ASSERT_EQ(stale.size(), 1);
+    ASSERT_TRUE(idProvider.takeId(3));
+    ASSERT_FALSE(stale.apply(idProvider));
+    EXPECT_EQ(idProvider.countOfTakenIds(), 6);
+}
+
+TEST(UniqueIdCompactionPlanTests, applyToMap)
+{
+    CompactionIdProvider idProvider;
+    Map<uint32_t, std::string> names;
+    for(uint32_t i = 0; i < 100; ++i)
+    {
+        const auto id = idProvider.takeNextId();
+        names.insert({id, std::to_string(id)});
+    }
+    for(uint32_t id = 1; id <= 100; id += 3)
+    {
+        idProvider.releaseId(id);
+        names.erase(id);
+    }
+
+    const IdCompactionPlan<uint32_t> plan(idProvider);
+    ASSERT_FALSE(plan.empty());
+
+    // ) A destination used in the map reject the whole plan
+    names.insert({plan.remaps().front().to, "conflict"});
+    ASSERT_FALSE(plan.apply(idProvider, names));
+    ASSERT_TRUE(idProvider.isIdTaken(plan.remaps().front().from));
+    names.erase(plan.remaps().front().to);
+
+    // ) Arrays indexed by id are fixed in one sweep with the same plan
+    std::vector<std::string> array(101);
+    for(const auto& name: names) array[name.first] = name.second;
+
+    ASSERT_TRUE(plan.apply(idProvider, names));
+    for(const auto& remap: plan.remaps()) array[remap.to] = std::move(array[remap.from]);
+    array.resize(plan.end());
+
+    EXPECT_EQ(idProvider.getNextEndId(), plan.end());
+    EXPECT_EQ(names.size(), idProvider.countOfTakenIds());
+    for(const auto& name: names)
+    {
+        ASSERT_LT(name.first, plan.end());
+        ASSERT_TRUE(idProvider.isIdTaken(name.first));
+        ASSERT_EQ(array[name.first], name.second);
+    }
+    ASSERT_TRUE(names.contains(std::string("99")));
+    EXPECT_EQ(names.find(std::string("99"))->second, plan.remap(99));
+}
@@ -5,9 +5,24 @@
 
 // Unique
 #include <Unique/IdProvider.hpp>
+#include <Unique/DynamicIdProvider.hpp>
+#include <Unique/BitmapIdStorage.hpp>
+#include <Unique/SetIdStorage.hpp>
+#include <Unique/LinkedIdStorage.hpp>
+#include <Unique/PagedIdStorage.hpp>
+
+// Std
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <random>
+#include <utility>
+#include <vector>
 
 using namespace unique;
 
+template<class Provider>
 class UniqueIdProviderTests : public ::testing::Test
 {
 public:
@@ -22,110 +37,582 @@ protected:
     {
     }
 public:
-    IdProvider<uint32_t, 1, 0xFFFFFFFF> idProvider;
+    Provider idProvider;
     const uint32_t base;
 };
 
-TEST_F(UniqueIdProviderTests, takeNextId)
+/** Same bounds as the compile time providers, given at runtime */
+class UniqueDynamicIdProvider : public DynamicIdProvider<uint32_t>
 {
-    ASSERT_EQ(idProvider.countOfAvailableIds(), 0);
+public:
+    UniqueDynamicIdProvider() : DynamicIdProvider(1, 0xFFFFFFFF) {}
+};
 
-    ASSERT_EQ(base, idProvider.takeNextId());
-    ASSERT_EQ(base + 1, idProvider.takeNextId());
-    ASSERT_EQ(base + 2, idProvider.takeNextId());
-    ASSERT_EQ(base + 3, idProvider.takeNextId());
-    ASSERT_EQ(base + 4, idProvider.takeNextId());
-    ASSERT_EQ(base + 5, idProvider.takeNextId());
+using UniqueIdProviderTypes = ::testing::Types<IdProvider<uint32_t, 1, 0xFFFFFFFF>,
+    IdProvider<uint32_t, 1, 0xFFFFFFFF, SetIdStorage>,
+    IdProvider<uint32_t, 1, 0xFFFFFFFF, BitmapIdStorage>,
+    IdProvider<uint32_t, 1, 0xFFFFFFFF, PagedIdStorage>,
+    UniqueDynamicIdProvider>;
+TYPED_TEST_SUITE(UniqueIdProviderTests, UniqueIdProviderTypes);
 
-    EXPECT_EQ(idProvider.countOfTakenIds(), 6);
+TYPED_TEST(UniqueIdProviderTests, takeNextId)
+{
+    ASSERT_EQ(this->idProvider.countOfAvailableIds(), 0);
 
-    idProvider.clear();
-    ASSERT_EQ(idProvider.countOfAvailableIds(), 0);
-    EXPECT_EQ(idProvider.countOfTakenIds(), 0);
+    ASSERT_EQ(this->base, this->idProvider.takeNextId());
+    ASSERT_EQ(this->base + 1, this->idProvider.takeNextId());
+    ASSERT_EQ(this->base + 2, this->idProvider.takeNextId());
+    ASSERT_EQ(this->base + 3, this->idProvider.takeNextId());
+    ASSERT_EQ(this->base + 4, this->idProvider.takeNextId());
+    ASSERT_EQ(this->base + 5, this->idProvider.takeNextId());
 
-    ASSERT_EQ(base, idProvider.takeNextId());
-    ASSERT_EQ(base + 1, idProvider.takeNextId());
-    ASSERT_EQ(base + 2, idProvider.takeNextId());
-    ASSERT_EQ(base + 3, idProvider.takeNextId());
-    ASSERT_EQ(base + 4, idProvider.takeNextId());
-    ASSERT_EQ(base + 5, idProvider.takeNextId());
-    EXPECT_EQ(idProvider.countOfTakenIds(), 6);
+    EXPECT_EQ(this->idProvider.countOfTakenIds(), 6);
 
-    idProvider.releaseId(base + 1);
-    idProvider.releaseId(base + 4);
-    EXPECT_EQ(idProvider.countOfTakenIds(), 4);
+    this->idProvider.clear();
+    ASSERT_EQ(this->idProvider.countOfAvailableIds(), 0);
+    EXPECT_EQ(this->idProvider.countOfTakenIds(), 0);
 
-    ASSERT_EQ(idProvider.countOfAvailableIds(), 2);
+    ASSERT_EQ(this->base, this->idProvider.takeNextId());
+    ASSERT_EQ(this->base + 1, this->idProvider.takeNextId());
+    ASSERT_EQ(this->base + 2, this->idProvider.takeNextId());
+    ASSERT_EQ(this->base + 3, this->idProvider.takeNextId());
+    ASSERT_EQ(this->base + 4, this->idProvider.takeNextId());
+    ASSERT_EQ(this->base + 5, this->idProvider.takeNextId());
+    EXPECT_EQ(this->idProvider.countOfTakenIds(), 6);
 
-    ASSERT_EQ(base + 1, idProvider.takeNextId());
-    ASSERT_EQ(base + 4, idProvider.takeNextId());
-    ASSERT_EQ(base + 6, idProvider.takeNextId());
-    ASSERT_EQ(base + 7, idProvider.takeNextId());
-    EXPECT_EQ(idProvider.countOfTakenIds(), 8);
+    this->idProvider.releaseId(this->base + 1);
+    this->idProvider.releaseId(this->base + 4);
+    EXPECT_EQ(this->idProvider.countOfTakenIds(), 4);
 
-    idProvider.releaseId(base + 7);
-    idProvider.releaseId(base + 6);
-    EXPECT_EQ(idProvider.countOfTakenIds(), 6);
+    ASSERT_EQ(this->idProvider.countOfAvailableIds(), 2);
 
-    ASSERT_EQ(idProvider.countOfAvailableIds(), 0);
+    ASSERT_EQ(this->base + 1, this->idProvider.takeNextId());
+    ASSERT_EQ(this->base + 4, this->idProvider.takeNextId());
+    ASSERT_EQ(this->base + 6, this->idProvider.takeNextId());
+    ASSERT_EQ(this->base + 7, this->idProvider.takeNextId());
+    EXPECT_EQ(this->idProvider.countOfTakenIds(), 8);
 
-    ASSERT_EQ(base + 6, idProvider.takeNextId());
-    ASSERT_EQ(base + 7, idProvider.takeNextId());
-    EXPECT_EQ(idProvider.countOfTakenIds(), 8);
+    this->idProvider.releaseId(this->base + 7);
+    this->idProvider.releaseId(this->base + 6);
+    EXPECT_EQ(this->idProvider.countOfTakenIds(), 6);
 
-    idProvider.releaseId(base + 1);
-    idProvider.releaseId(base + 4);
-    idProvider.releaseId(base + 6);
-    EXPECT_EQ(idProvider.countOfTakenIds(), 5);
+    ASSERT_EQ(this->idProvider.countOfAvailableIds(), 0);
 
-    ASSERT_EQ(idProvider.countOfAvailableIds(), 3);
-    idProvider.clear();
-    ASSERT_EQ(idProvider.countOfAvailableIds(), 0);
-    EXPECT_EQ(idProvider.countOfTakenIds(), 0);
+    ASSERT_EQ(this->base + 6, this->idProvider.takeNextId());
+    ASSERT_EQ(this->base + 7, this->idProvider.takeNextId());
+    EXPECT_EQ(this->idProvider.countOfTakenIds(), 8);
+
+    this->idProvider.releaseId(this->base + 1);
+    this->idProvider.releaseId(this->base + 4);
+    this->idProvider.releaseId(this->base + 6);
+    EXPECT_EQ(this->idProvider.countOfTakenIds(), 5);
+
+    ASSERT_EQ(this->idProvider.countOfAvailableIds(), 3);
+    this->idProvider.clear();
+    ASSERT_EQ(this->idProvider.countOfAvailableIds(), 0);
+    EXPECT_EQ(this->idProvider.countOfTakenIds(), 0);
 }
 
-TEST_F(UniqueIdProviderTests, takeId)
+TYPED_TEST(UniqueIdProviderTests, takeId)
 {
-    ASSERT_TRUE(idProvider.takeId(base + 4));
-    EXPECT_EQ(idProvider.countOfTakenIds(), 1);
-    ASSERT_EQ(idProvider.countOfAvailableIds(), 4);
-    ASSERT_EQ(base, idProvider.takeNextId());
-    ASSERT_EQ(base + 1, idProvider.takeNextId());
-    ASSERT_EQ(base + 2, idProvider.takeNextId());
-    ASSERT_EQ(base + 3, idProvider.takeNextId());
-    ASSERT_EQ(idProvider.countOfAvailableIds(), 0);
-    ASSERT_EQ(base + 5, idProvider.takeNextId());
-    EXPECT_EQ(idProvider.countOfTakenIds(), 6);
-
-    idProvider.releaseId(base + 4);
-    idProvider.releaseId(base + 5);
-    idProvider.releaseId(base + 3);
-    EXPECT_EQ(idProvider.countOfTakenIds(), 3);
-
-    ASSERT_EQ(base + 3, idProvider.takeNextId());
-    EXPECT_EQ(idProvider.countOfTakenIds(), 4);
-
-    idProvider.clear();
-    ASSERT_TRUE(idProvider.takeId(base + 4));
-    EXPECT_EQ(idProvider.countOfTakenIds(), 1);
-    idProvider.releaseId(base + 4);
-    EXPECT_EQ(idProvider.countOfTakenIds(), 0);
+    ASSERT_TRUE(this->idProvider.takeId(this->base + 4));
+    EXPECT_EQ(this->idProvider.countOfTakenIds(), 1);
+    ASSERT_EQ(this->idProvider.countOfAvailableIds(), 4);
+    ASSERT_EQ(this->base, this->idProvider.takeNextId());
+    ASSERT_EQ(this->base + 1, this->idProvider.takeNextId());
+    ASSERT_EQ(this->base + 2, this->idProvider.takeNextId());
+    ASSERT_EQ(this->base + 3, this->idProvider.takeNextId());
+    ASSERT_EQ(this->idProvider.countOfAvailableIds(), 0);
+    ASSERT_EQ(this->base + 5, this->idProvider.takeNextId());
+    EXPECT_EQ(this->idProvider.countOfTakenIds(), 6);
+
+    this->idProvider.releaseId(this->base + 4);
+    this->idProvider.releaseId(this->base + 5);
+    this->idProvider.releaseId(this->base + 3);
+    EXPECT_EQ(this->idProvider.countOfTakenIds(), 3);
+
+    ASSERT_EQ(this->base + 3, this->idProvider.takeNextId());
+    EXPECT_EQ(this->idProvider.countOfTakenIds(), 4);
+
+    this->idProvider.clear();
+    ASSERT_TRUE(this->idProvider.takeId(this->base + 4));
+    EXPECT_EQ(this->idProvider.countOfTakenIds(), 1);
+    this->idProvider.releaseId(this->base + 4);
+    EXPECT_EQ(this->idProvider.countOfTakenIds(), 0);
+    ASSERT_EQ(this->idProvider.countOfAvailableIds(), 0);
+    ASSERT_EQ(this->base, this->idProvider.takeNextId());
+    EXPECT_EQ(this->idProvider.countOfTakenIds(), 1);
+
+    this->idProvider.clear();
+    ASSERT_TRUE(this->idProvider.takeId(this->base));
+    ASSERT_TRUE(this->idProvider.takeId(this->base + 10));
+    EXPECT_EQ(this->idProvider.countOfTakenIds(), 2);
+    ASSERT_EQ(this->idProvider.countOfAvailableIds(), 9);
+    this->idProvider.releaseId(this->base + 10);
+    ASSERT_EQ(this->base + 1, this->idProvider.takeNextId());
+    EXPECT_EQ(this->idProvider.countOfTakenIds(), 2);
+}
+
+TYPED_TEST(UniqueIdProviderTests, takeIdBenchmark)
+{
+    ASSERT_TRUE(this->idProvider.takeId(10000));
+    ASSERT_EQ(this->idProvider.countOfAvailableIds(), 10000 - 1);
+}
+
+TYPED_TEST(UniqueIdProviderTests, lowestFirst)
+{
+    ASSERT_TRUE(this->idProvider.takeId(this->base + 300000));
+
+    // ) Ids spread over several bitmap words and summary levels
+    this->idProvider.releaseId(this->base + 300000);
+    ASSERT_TRUE(this->idProvider.takeId(this->base + 300001));
+    ASSERT_TRUE(this->idProvider.isIdAvailable(this->base + 300000));
+    ASSERT_TRUE(this->idProvider.isIdTaken(this->base + 300001));
+
+    ASSERT_TRUE(this->idProvider.takeId(this->base + 4100));
+    ASSERT_TRUE(this->idProvider.takeId(this->base + 70));
+    ASSERT_TRUE(this->idProvider.takeId(this->base + 5));
+    ASSERT_FALSE(this->idProvider.takeId(this->base + 70));
+    ASSERT_EQ(this->idProvider.countOfAvailableIds(), 300001 - 3);
+
+    for(uint32_t i = 0; i <= 300000; ++i)
+    {
+        if(i == 5 || i == 70 || i == 4100)
+            continue;
+        ASSERT_EQ(this->base + i, this->idProvider.takeNextId());
+    }
+    ASSERT_TRUE(this->idProvider.availableIdsEmpty());
+    ASSERT_EQ(this->base + 300002, this->idProvider.takeNextId());
+
+    this->idProvider.releaseId(this->base + 4100);
+    this->idProvider.releaseId(this->base + 64);
+    this->idProvider.releaseId(this->base + 63);
+    ASSERT_EQ(this->base + 63, this->idProvider.getFirstIdAvailable());
+    ASSERT_EQ(this->base + 63, this->idProvider.takeNextId());
+    ASSERT_EQ(this->base + 64, this->idProvider.takeNextId());
+    ASSERT_EQ(this->base + 4100, this->idProvider.takeNextId());
+    ASSERT_EQ(this->idProvider.countOfTakenIds(), 300003);
+}
+
+TEST(UniqueIntervalIdProviderTests, takeFarId)
+{
+    IdProvider<uint32_t, 1, 0xFFFFFFFF> idProvider;
+
+    // ) Gap is stored as a single run instead of one node per id
+    ASSERT_TRUE(idProvider.takeId(4000000000));
+    ASSERT_EQ(idProvider.countOfAvailableIds(), 4000000000u - 1);
+    ASSERT_TRUE(idProvider.isIdAvailable(3999999999));
+    ASSERT_TRUE(idProvider.isIdTaken(4000000000));
+
+    ASSERT_TRUE(idProvider.takeId(2000000000));
+    ASSERT_FALSE(idProvider.takeId(2000000000));
+    ASSERT_EQ(1u, idProvider.takeNextId());
+    ASSERT_EQ(2u, idProvider.takeNextId());
+    ASSERT_EQ(idProvider.countOfAvailableIds(), 4000000000u - 4);
+    ASSERT_EQ(idProvider.countOfTakenIds(), 4);
+
+    // ) Releasing the top id coalesce the whole run below it at once
+    idProvider.releaseId(4000000000);
+    ASSERT_EQ(idProvider.getNextEndId(), 2000000001u);
+    idProvider.releaseId(2000000000);
+    ASSERT_EQ(idProvider.getNextEndId(), 3u);
     ASSERT_EQ(idProvider.countOfAvailableIds(), 0);
-    ASSERT_EQ(base, idProvider.takeNextId());
-    EXPECT_EQ(idProvider.countOfTakenIds(), 1);
+    ASSERT_EQ(idProvider.countOfTakenIds(), 2);
+}
+
+TEST(UniqueBitmapIdProviderTests, takeFarId)
+{
+    IdProvider<uint32_t, 1, 0xFFFFFFFF, BitmapIdStorage> idProvider;
+
+    // ) Releasing the top id clear the gap below it a word at a time
+    ASSERT_TRUE(idProvider.takeId(50000000));
+    ASSERT_EQ(idProvider.countOfAvailableIds(), 50000000u - 1);
+    ASSERT_TRUE(idProvider.takeId(20000000));
+    idProvider.releaseId(50000000);
+    ASSERT_EQ(idProvider.getNextEndId(), 20000001u);
+    ASSERT_EQ(idProvider.countOfAvailableIds(), 20000000u - 1);
+
+    // ) Contiguous ranges skip the runs that are too short
+    ASSERT_TRUE(idProvider.takeId(100));
+    ASSERT_TRUE(idProvider.takeId(300));
+    ASSERT_EQ(idProvider.takeContiguousRange(150), 101u);
+    ASSERT_EQ(idProvider.takeContiguousRange(1000), 301u);
+}
+
+TEST(UniqueBitmapIdStorageTests, matchIntervalStorage)
+{
+    BitmapIdStorage<uint32_t> bitmap(1);
+    IntervalIdStorage<uint32_t> reference(1);
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<uint32_t> id(1, 3000);
+    std::uniform_int_distribution<int> operation(0, 5);
+    std::uniform_int_distribution<std::size_t> count(1, 200);
+
+    const auto runs = [](const auto& storage)
+    {
+        std::vector<std::pair<uint32_t, uint32_t>> result;
+        storage.forEachRun([&](const uint32_t first, const uint32_t last) { result.emplace_back(first, last); });
+        return result;
+    };
+
+    for(int i = 0; i < 20000; ++i)
+    {
+        switch(operation(rng))
+        {
+        case 0:
+        {
+            const auto first = id(rng);
+            const auto last = first + static_cast<uint32_t>(count(rng));
+            bool free = true;
+            for(auto v = first; v < last && free; ++v) free = !reference.contains(v);
+            if(free)
+            {
+                bitmap.insertRange(first, last);
+                reference.insertRange(first, last);
+            }
+            break;
+        }
+        case 1:
+        {
+            const auto v = id(rng);
+            ASSERT_EQ(bitmap.erase(v), reference.erase(v));
+            break;
+        }
+        case 2:
+        {
+            // ) Like the provider counter, end itself isn't available
+            const auto end = id(rng);
+            if(!reference.contains(end))
+            {
+                ASSERT_EQ(bitmap.eraseRunEndingAt(end), reference.eraseRunEndingAt(end));
+            }
+            break;
+        }
+        case 3:
+            if(!reference.empty())
+            {
+                uint32_t first = 0;
+                uint32_t referenceFirst = 0;
+                const auto maxCount = count(rng);
+                ASSERT_EQ(bitmap.popFrontRun(maxCount, first), reference.popFrontRun(maxCount, referenceFirst));
+                ASSERT_EQ(first, referenceFirst);
+            }
+            break;
+        case 4:
+        {
+            uint32_t first = 0;
+            uint32_t referenceFirst = 0;
+            const auto wanted = count(rng);
+            const auto found = bitmap.popContiguous(wanted, first);
+            ASSERT_EQ(found, reference.popContiguous(wanted, referenceFirst));
+            if(found)
+            {
+                ASSERT_EQ(first, referenceFirst);
+            }
+            break;
+        }
+        default:
+        {
+            const auto v = id(rng);
+            if(!reference.contains(v))
+            {
+                bitmap.insert(v);
+                reference.insert(v);
+            }
+            break;
+        }
+        }
+        ASSERT_EQ(bitmap.size(), reference.size());
+    }
+    ASSERT_EQ(runs(bitmap), runs(reference));
+}
+
+TEST(UniquePagedIdProviderTests, scatteredIds)
+{
+    IdProvider<uint64_t, 1, UINT64_MAX, PagedIdStorage> idProvider;
+
+    // ) Gaps below scattered ids are fully available pages, they collapse to two bits
+    const uint64_t clusters[] = {1ull << 20, 1ull << 40, 3ull << 50, 1ull << 62, 0xFFFFFFFFFFFF0000ull};
+    for(const auto cluster: clusters)
+    {
+        for(uint64_t i = 0; i < 100; ++i) ASSERT_TRUE(idProvider.takeId(cluster + i * 3));
+    }
+    EXPECT_EQ(idProvider.countOfTakenIds(), 500);
+    ASSERT_TRUE(idProvider.isIdAvailable(1ull << 63));
+    ASSERT_TRUE(idProvider.isIdAvailable((1ull << 40) + 1));
+    ASSERT_TRUE(idProvider.isIdTaken((1ull << 40) + 3));
+    EXPECT_EQ(idProvider.countOfAvailableIds(), 0xFFFFFFFFFFFF0000ull + 297 - 500);
+
+    // ) At most two paths of nodes per cluster, when it straddle an aligned boundary
+    PagedIdStorage<uint64_t> storage(1);
+    idProvider.forEachAvailableRun([&](const uint64_t first, const uint64_t last) { storage.insertRange(first, last); });
+    EXPECT_EQ(storage.size(), idProvider.countOfAvailableIds());
+    EXPECT_LE(storage.countOfNodes(), 5 * 2 * 10);
+
+    ASSERT_EQ(1u, idProvider.takeNextId());
+    uint64_t id = 0;
+    ASSERT_TRUE(storage.findNear((1ull << 40) + 297, id));
+    EXPECT_EQ(id, (1ull << 40) + 296);
+    ASSERT_TRUE(storage.findNear((1ull << 40) + 3, id));
+    EXPECT_EQ(id, (1ull << 40) + 2);
+
+    // ) Releasing the top id give back every id down to the previous cluster
+    for(uint64_t i = 100; i-- > 0;) idProvider.releaseId(0xFFFFFFFFFFFF0000ull + i * 3);
+    EXPECT_EQ(idProvider.getNextEndId(), (1ull << 62) + 297 + 1);
+
+    storage.clear();
+    EXPECT_EQ(storage.countOfNodes(), 1);
+    EXPECT_TRUE(storage.empty());
+}
+
+TEST(UniqueLinkedIdProviderTests, lifo)
+{
+    IdProvider<uint32_t, 1, 0xFFFFFFFF, LifoIdStorage> idProvider;
+    for(uint32_t i = 1; i <= 10; ++i) ASSERT_EQ(i, idProvider.takeNextId());
+
+    // ) The last released id is the first reused, even the highest one
+    idProvider.releaseId(3);
+    idProvider.releaseId(10);
+    idProvider.releaseId(7);
+    EXPECT_EQ(idProvider.getNextEndId(), 11u);
+    ASSERT_EQ(7u, idProvider.takeNextId());
+    ASSERT_EQ(10u, idProvider.takeNextId());
+    ASSERT_EQ(3u, idProvider.takeNextId());
+    ASSERT_EQ(11u, idProvider.takeNextId());
+
+    // ) A gap left by takeId is handed out lowest first, then the release order apply again
+    ASSERT_TRUE(idProvider.takeId(15));
+    idProvider.releaseId(5);
+    ASSERT_EQ(5u, idProvider.takeNextId());
+    ASSERT_EQ(12u, idProvider.takeNextId());
+    ASSERT_TRUE(idProvider.takeId(14));
+    ASSERT_EQ(13u, idProvider.takeNextId());
+    EXPECT_EQ(idProvider.countOfTakenIds(), 15);
+
+    idProvider.releaseIdRange(2, 5);
+    ASSERT_EQ(2u, idProvider.takeContiguousRange(3));
+    ASSERT_TRUE(idProvider.availableIdsEmpty());
+}
+
+TEST(UniqueLinkedIdProviderTests, fifo)
+{
+    IdProvider<uint32_t, 1, 0xFFFFFFFF, FifoIdStorage> idProvider;
+    for(uint32_t i = 1; i <= 10; ++i) ASSERT_EQ(i, idProvider.takeNextId());
+
+    idProvider.releaseId(3);
+    idProvider.releaseId(10);
+    idProvider.releaseId(7);
+    ASSERT_TRUE(idProvider.isIdAvailable(10));
+    ASSERT_EQ(3u, idProvider.takeNextId());
+    idProvider.releaseId(3);
+    ASSERT_EQ(10u, idProvider.takeNextId());
+    ASSERT_EQ(7u, idProvider.takeNextId());
+    ASSERT_EQ(3u, idProvider.takeNextId());
+    ASSERT_EQ(11u, idProvider.takeNextId());
+}
+
+TEST(UniqueLinkedIdProviderTests, findNear)
+{
+    FifoIdStorage<uint32_t> storage;
+    uint32_t id = 0;
+    ASSERT_FALSE(storage.findNear(5, id));
+    storage.insert(10);
+    storage.insert(3);
+    ASSERT_TRUE(storage.findNear(6, id));
+    ASSERT_EQ(3u, id);
+    ASSERT_TRUE(storage.findNear(7, id));
+    ASSERT_EQ(10u, id);
+    ASSERT_TRUE(storage.findNear(1000000, id));
+    ASSERT_EQ(10u, id);
+}
+
+TEST(UniqueLinkedIdProviderTests, quarantine)
+{
+    IdProvider<uint8_t, 0, 8, QuarantineFifoIdStorage<2>::Storage> idProvider;
+    for(uint8_t i = 0; i < 4; ++i) ASSERT_EQ(i, idProvider.takeNextId());
+
+    // ) The 2 last released ids are never handed out, new ids are taken instead
+    idProvider.releaseId(1);
+    idProvider.releaseId(3);
+    ASSERT_EQ(0, idProvider.countOfAvailableIds());
+    ASSERT_TRUE(idProvider.availableIdsEmpty());
+    ASSERT_TRUE(idProvider.isIdAvailable(1));
+    ASSERT_TRUE(idProvider.isIdAvailable(3));
+    ASSERT_EQ(4, idProvider.takeNextId());
+    idProvider.releaseId(0);
+    ASSERT_EQ(1, idProvider.countOfAvailableIds());
+    ASSERT_EQ(1, idProvider.takeNextId());
+    ASSERT_EQ(5, idProvider.takeNextId());
+    ASSERT_EQ(6, idProvider.takeNextId());
+    ASSERT_EQ(7, idProvider.takeNextId());
+
+    // ) Quarantined ids can still be taken explicitly
+    ASSERT_FALSE(idProvider.areIdsAvailables());
+    ASSERT_TRUE(idProvider.takeId(3));
+    idProvider.releaseId(5);
+    idProvider.releaseId(6);
+    ASSERT_EQ(0, idProvider.takeNextId());
+
+    // ) size only count the ids that can be handed out
+    QuarantineFifoIdStorage<2>::Storage<uint32_t> storage;
+    storage.insert(1);
+    storage.insert(3);
+    EXPECT_EQ(storage.size(), 0);
+    EXPECT_EQ(storage.quarantinedCount(), 2);
+    ASSERT_TRUE(storage.empty());
+    storage.insert(5);
+    EXPECT_EQ(storage.size(), 1);
+    EXPECT_EQ(storage.quarantinedCount(), 2);
+    ASSERT_EQ(1u, storage.popFront());
+}
 
-    idProvider.clear();
-    ASSERT_TRUE(idProvider.takeId(base));
-    ASSERT_TRUE(idProvider.takeId(base + 10));
-    EXPECT_EQ(idProvider.countOfTakenIds(), 2);
-    ASSERT_EQ(idProvider.countOfAvailableIds(), 9);
-    idProvider.releaseId(base + 10);
-    ASSERT_EQ(base + 1, idProvider.takeNextId());
-    EXPECT_EQ(idProvider.countOfTakenIds(), 2);
+TYPED_TEST(UniqueIdProviderTests, takeNextIds)
+{
+    std::vector<uint32_t> ids;
+    this->idProvider.takeNextIds(10, std::back_inserter(ids));
+    ASSERT_EQ(ids.size(), 10);
+    for(uint32_t i = 0; i < 10; ++i) ASSERT_EQ(this->base + i, ids[i]);
+
+    // ) Holes are consumed lowest first before the counter
+    this->idProvider.releaseIdRange(this->base + 2, this->base + 5);
+    this->idProvider.releaseId(this->base + 7);
+    EXPECT_EQ(this->idProvider.countOfTakenIds(), 6);
+    ids.clear();
+    this->idProvider.takeNextIds(6, std::back_inserter(ids));
+    const std::vector<uint32_t> expected = {this->base + 2, this->base + 3, this->base + 4,
+        this->base + 7, this->base + 10, this->base + 11};
+    ASSERT_EQ(ids, expected);
+    EXPECT_EQ(this->idProvider.countOfTakenIds(), 12);
+    ASSERT_TRUE(this->idProvider.availableIdsEmpty());
+
+    // ) Releasing the whole block in any order shrink the counter back
+    std::vector<uint32_t> all;
+    for(uint32_t i = 0; i < 12; ++i) all.push_back(this->base + i);
+    this->idProvider.releaseIds(all.begin(), all.end());
+    EXPECT_EQ(this->idProvider.countOfTakenIds(), 0);
+    EXPECT_EQ(this->idProvider.getNextEndId(), this->base);
+    ASSERT_EQ(this->idProvider.countOfAvailableIds(), 0);
+}
+
+TYPED_TEST(UniqueIdProviderTests, takeContiguousRange)
+{
+    ASSERT_EQ(this->base, this->idProvider.takeContiguousRange(100));
+    ASSERT_EQ(this->base + 100, this->idProvider.takeContiguousRange(50));
+    EXPECT_EQ(this->idProvider.countOfTakenIds(), 150);
+
+    this->idProvider.releaseIdRange(this->base + 10, this->base + 20);
+    this->idProvider.releaseIdRange(this->base + 40, this->base + 100);
+
+    // ) Too big for the first hole, fit in the second one
+    ASSERT_EQ(this->base + 40, this->idProvider.takeContiguousRange(20));
+    ASSERT_EQ(this->base + 10, this->idProvider.takeContiguousRange(10));
+    ASSERT_EQ(this->base + 150, this->idProvider.takeContiguousRange(200));
+    ASSERT_EQ(this->base + 60, this->idProvider.takeContiguousRange(40));
+    EXPECT_EQ(this->idProvider.countOfTakenIds(), 350);
+    ASSERT_TRUE(this->idProvider.availableIdsEmpty());
+    for(uint32_t i = 0; i < 350; ++i) ASSERT_TRUE(this->idProvider.isIdTaken(this->base + i));
+    ASSERT_EQ(this->base + 350, this->idProvider.takeNextId());
+}
+
+TYPED_TEST(UniqueIdProviderTests, snapshot)
+{
+    ASSERT_EQ(this->base, this->idProvider.takeContiguousRange(1001));
+    this->idProvider.releaseIdRange(this->base + 100, this->base + 200);
+    ASSERT_TRUE(this->idProvider.takeId(this->base + 150));
+    this->idProvider.releaseId(this->base + 500);
+    this->idProvider.releaseId(this->base);
+
+    std::vector<unsigned char> buffer(this->idProvider.serializedSize());
+    ASSERT_EQ(buffer.size(), sizeof(IdSnapshotHeader) + 4 * sizeof(IdSnapshotRun));
+    ASSERT_EQ(0, this->idProvider.serialize(buffer.data(), buffer.size() - 1));
+    ASSERT_EQ(buffer.size(), this->idProvider.serialize(buffer.data(), buffer.size()));
+
+    // ) Restore in another storage, the format doesn't depend on it
+    IdProvider<uint32_t, 1, 0xFFFFFFFF, BitmapIdStorage> restored;
+    ASSERT_TRUE(restored.deserialize(buffer.data(), buffer.size()));
+    EXPECT_EQ(restored.countOfTakenIds(), this->idProvider.countOfTakenIds());
+    EXPECT_EQ(restored.countOfAvailableIds(), this->idProvider.countOfAvailableIds());
+    EXPECT_EQ(restored.getNextEndId(), this->base + 1001);
+    for(uint32_t i = 0; i < 1100; ++i)
+        ASSERT_EQ(restored.isIdTaken(this->base + i), this->idProvider.isIdTaken(this->base + i));
+    ASSERT_EQ(this->base, restored.takeNextId());
+
+    // ) Round trip through the provider itself
+    this->idProvider.clear();
+    ASSERT_TRUE(this->idProvider.deserialize(buffer.data(), buffer.size()));
+    ASSERT_EQ(this->base, this->idProvider.takeNextId());
+    ASSERT_EQ(this->base + 100, this->idProvider.takeNextId());
+
+    // ) Invalid snapshots leave the provider untouched
+    IdProvider<uint32_t, 0, 0xFFFFFFFF> otherBounds;
+    ASSERT_FALSE(otherBounds.deserialize(buffer.data(), buffer.size()));
+    ASSERT_FALSE(restored.deserialize(buffer.data(), buffer.size() - 1));
+    auto corrupted = buffer;
+    corrupted[sizeof(IdSnapshotHeader)] ^= 0xFF;
+    ASSERT_FALSE(restored.deserialize(corrupted.data(), corrupted.size()));
+
+    // ) 64 bits values that would wrap to valid 32 bits ids are rejected
+    const auto corruptHighBits = [&](const std::size_t offset)
+    {
+        auto wrapped = buffer;
+        std::uint64_t value = 0;
+        std::memcpy(&value, wrapped.data() + offset, sizeof(value));
+        value += std::uint64_t(1) << 32;
+        std::memcpy(wrapped.data() + offset, &value, sizeof(value));
+        return wrapped;
+    };
+    for(const auto offset: {offsetof(IdSnapshotHeader, counter), offsetof(IdSnapshotHeader, takenCount),
+            sizeof(IdSnapshotHeader) + offsetof(IdSnapshotRun, first), sizeof(IdSnapshotHeader) + offsetof(IdSnapshotRun, last)})
+    {
+        const auto wrapped = corruptHighBits(offset);
+        ASSERT_FALSE(restored.deserialize(wrapped.data(), wrapped.size()));
+    }
+    EXPECT_EQ(restored.getNextEndId(), this->base + 1001);
+    ASSERT_EQ(this->base + 100, restored.takeNextId());
 }
 
-TEST_F(UniqueIdProviderTests, takeIdBenchmark)
+TEST(UniqueIdProviderSnapshotTests, negativeMin)
 {
-    ASSERT_TRUE(idProvider.takeId(10000));
-    ASSERT_EQ(idProvider.countOfAvailableIds(), 10000 - 1);
+    // ) Signed ids are stored sign extended, the checks must hold across zero
+    IdProvider<int, -100, 100> idProvider;
+    for(int i = 0; i < 150; ++i) ASSERT_EQ(-100 + i, idProvider.takeNextId());
+    idProvider.releaseIdRange(-90, -80);
+    idProvider.releaseIdRange(-5, 5);
+    idProvider.releaseId(20);
+
+    std::vector<unsigned char> buffer(idProvider.serializedSize());
+    ASSERT_EQ(buffer.size(), idProvider.serialize(buffer.data(), buffer.size()));
+    IdProvider<int, -100, 100> restored;
+    ASSERT_TRUE(restored.deserialize(buffer.data(), buffer.size()));
+    EXPECT_EQ(restored.countOfTakenIds(), idProvider.countOfTakenIds());
+    EXPECT_EQ(restored.getNextEndId(), 50);
+    for(int id = -100; id < 100; ++id) ASSERT_EQ(restored.isIdTaken(id), idProvider.isIdTaken(id));
+    ASSERT_EQ(-90, restored.takeNextId());
+}
+
+TYPED_TEST(UniqueIdProviderTests, takeIdNear)
+{
+    ASSERT_EQ(this->base, this->idProvider.takeContiguousRange(1000));
+    for(uint32_t i = 0; i < 1000; i += 10) this->idProvider.releaseId(this->base + i);
+    this->idProvider.releaseIdRange(this->base + 501, this->base + 505);
+
+    // ) Hint available, closest above, closest below, lowest on a tie
+    ASSERT_EQ(this->base + 500, this->idProvider.takeIdNear(this->base + 500));
+    ASSERT_EQ(this->base + 501, this->idProvider.takeIdNear(this->base + 500));
+    ASSERT_EQ(this->base + 40, this->idProvider.takeIdNear(this->base + 42));
+    ASSERT_EQ(this->base + 50, this->idProvider.takeIdNear(this->base + 47));
+    ASSERT_EQ(this->base + 60, this->idProvider.takeIdNear(this->base + 65));
+    ASSERT_EQ(this->base + 0, this->idProvider.takeIdNear(this->base + 1));
+
+    // ) The counter is a candidate too, and any id past it is free
+    ASSERT_EQ(this->base + 1000, this->idProvider.takeIdNear(this->base + 996));
+    ASSERT_EQ(this->base + 2000, this->idProvider.takeIdNear(this->base + 2000));
+    ASSERT_TRUE(this->idProvider.isIdAvailable(this->base + 1999));
+
+    std::vector<uint32_t> ids;
+    this->idProvider.takeIdsNear(this->base + 503, 4, std::back_inserter(ids));
+    const std::vector<uint32_t> expected = {this->base + 503, this->base + 502, this->base + 504,
+        this->base + 510};
+    ASSERT_EQ(ids, expected);
+    EXPECT_EQ(this->idProvider.countOfTakenIds(), 1000 - 100 - 4 + 12);
 }
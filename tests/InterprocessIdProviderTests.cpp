@@ -0,0 +1,204 @@
+// C++ Header
+
+// gtest framework
+#include <gtest/gtest.h>
+
+// Unique
+#include <Unique/InterprocessIdProvider.hpp>
+
+#ifdef UNIQUE_HAS_INTERPROCESS_ID_PROVIDER
+
+// Std
+#include <set>
+#include <string>
+#include <vector>
+
+// Posix
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace unique;
+
+class UniqueInterprocessIdProviderTests : public ::testing::Test
+{
+protected:
+    const std::string name = "/unique-tests-" + std::to_string(getpid());
+
+    void SetUp() override { InterprocessIdProvider<uint32_t>::remove(name); }
+    void TearDown() override { InterprocessIdProvider<uint32_t>::remove(name); }
+
+    /** Every id below the first never taken one is either taken or reachable by takeNextId */
+    static void expectConsistent(InterprocessIdProvider<uint32_t>& idProvider)
+    {
+        std::size_t taken = 0;
+        for(uint32_t id = 0; id < 1000; ++id) taken += idProvider.isIdTaken(id) ? 1 : 0;
+        ASSERT_EQ(taken, idProvider.countOfTakenIds());
+
+        std::set<uint32_t> ids;
+        while(idProvider.areIdsAvailables())
+        {
+            const auto id = idProvider.takeNextId();
+            ASSERT_TRUE(ids.insert(id).second);
+        }
+        EXPECT_EQ(ids.size() + taken, 1000);
+        for(const auto id: ids) idProvider.releaseId(id);
+    }
+};
+
+TEST_F(UniqueInterprocessIdProviderTests, shareBetweenMappings)
+{
+    InterprocessIdProvider<uint32_t> first;
+    InterprocessIdProvider<uint32_t> second;
+    ASSERT_TRUE(first.open(name, 0, 1000));
+    ASSERT_TRUE(second.open(name, 0, 1000));
+
+    // ) Another id type or other bounds are refused
+    InterprocessIdProvider<uint32_t> mismatch;
+    EXPECT_FALSE(mismatch.open(name, 0, 500));
+    InterprocessIdProvider<uint64_t> mismatchType;
+    EXPECT_FALSE(mismatchType.open(name, 0, 1000));
+
+    ASSERT_EQ(first.takeNextId(), 0u);
+    ASSERT_EQ(second.takeNextId(), 1u);
+    ASSERT_TRUE(second.takeId(10));
+    ASSERT_FALSE(first.takeId(10));
+    EXPECT_TRUE(first.isIdTaken(1));
+    EXPECT_EQ(first.ownerOf(10), static_cast<uint32_t>(getpid()));
+    EXPECT_EQ(first.countOfTakenIds(), 3);
+
+    // ) Ids skipped by takeId are handed out lowest first
+    first.releaseId(1);
+    EXPECT_TRUE(second.isIdAvailable(1));
+    ASSERT_EQ(second.takeNextId(), 1u);
+    ASSERT_EQ(second.takeNextId(), 2u);
+    ASSERT_TRUE(first.takeId(5));
+    ASSERT_EQ(first.takeNextId(), 3u);
+    ASSERT_EQ(first.takeNextId(), 4u);
+    ASSERT_EQ(first.takeNextId(), 6u);
+
+    first.close();
+    EXPECT_EQ(second.countOfTakenIds(), 8);
+    expectConsistent(second);
+}
+
+TEST_F(UniqueInterprocessIdProviderTests, sweepOrphans)
+{
+    InterprocessIdProvider<uint32_t> idProvider;
+    ASSERT_TRUE(idProvider.open(name, 0, 1000));
+    ASSERT_EQ(idProvider.takeNextId(), 0u);
+
+    const auto child = fork();
+    ASSERT_GE(child, 0);
+    if(child == 0)
+    {
+        // ) The pid is read in open, a forked child open the segment again
+        InterprocessIdProvider<uint32_t> childProvider;
+        if(!childProvider.open(name, 0, 1000))
+            _exit(1);
+        for(int i = 0; i < 10; ++i) childProvider.takeNextId();
+        _exit(0);
+    }
+    int status = 0;
+    ASSERT_EQ(waitpid(child, &status, 0), child);
+    ASSERT_EQ(WEXITSTATUS(status), 0);
+    EXPECT_EQ(idProvider.countOfTakenIds(), 11);
+    EXPECT_EQ(idProvider.ownerOf(1), static_cast<uint32_t>(child));
+
+    std::vector<uint32_t> orphans;
+    idProvider.sweepOrphans(std::back_inserter(orphans));
+    EXPECT_EQ(orphans.size(), 10);
+    EXPECT_EQ(idProvider.countOfTakenIds(), 1);
+    EXPECT_TRUE(idProvider.isIdTaken(0));
+    expectConsistent(idProvider);
+}
+
+TEST_F(UniqueInterprocessIdProviderTests, creatorDied)
+{
+    // ) The creator died before sizing the segment
+    auto fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+    ASSERT_GE(fd, 0);
+    close(fd);
+    {
+        InterprocessIdProvider<uint32_t> idProvider;
+        ASSERT_TRUE(idProvider.open(name, 0, 1000));
+        ASSERT_EQ(idProvider.takeNextId(), 0u);
+    }
+    InterprocessIdProvider<uint32_t>::remove(name);
+
+    // ) The creator died after claiming the segment, before setting ready
+    const auto child = fork();
+    ASSERT_GE(child, 0);
+    if(child == 0)
+    {
+        fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+        const auto size = sizeof(InterprocessIdHeader) + 1000 * sizeof(InterprocessIdSlot) + 64;
+        if(fd < 0 || ftruncate(fd, static_cast<off_t>(size)) != 0)
+            _exit(1);
+        auto* segment = static_cast<InterprocessIdHeader*>(mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0));
+        if(segment == MAP_FAILED)
+            _exit(1);
+        segment->creator.store(static_cast<uint32_t>(getpid()));
+        segment->magic = InterprocessIdHeader::MAGIC;
+        _exit(0);
+    }
+    int status = 0;
+    ASSERT_EQ(waitpid(child, &status, 0), child);
+    ASSERT_EQ(WEXITSTATUS(status), 0);
+
+    InterprocessIdProvider<uint32_t> idProvider;
+    ASSERT_TRUE(idProvider.open(name, 0, 1000));
+    ASSERT_EQ(idProvider.takeNextId(), 0u);
+    expectConsistent(idProvider);
+
+    InterprocessIdProvider<uint32_t> other;
+    ASSERT_TRUE(other.open(name, 0, 1000));
+    EXPECT_EQ(other.countOfTakenIds(), 1);
+}
+
+TEST_F(UniqueInterprocessIdProviderTests, killedWhileTaking)
+{
+    InterprocessIdProvider<uint32_t> idProvider;
+    ASSERT_TRUE(idProvider.open(name, 0, 1000));
+
+    // ) Children are killed at random points, some while holding the mutex in the middle of a mutation
+    for(int round = 0; round < 20; ++round)
+    {
+        const auto child = fork();
+        ASSERT_GE(child, 0);
+        if(child == 0)
+        {
+            InterprocessIdProvider<uint32_t> childProvider;
+            if(!childProvider.open(name, 0, 1000))
+                _exit(1);
+            std::vector<uint32_t> ids;
+            for(uint32_t i = 0;; ++i)
+            {
+                if(ids.size() < 100 && (i % 3))
+                {
+                    ids.push_back(childProvider.takeNextId());
+                }
+                else if(!ids.empty())
+                {
+                    childProvider.releaseId(ids.back());
+                    ids.pop_back();
+                }
+                const auto fixed = 100 + i % 900;
+                if(childProvider.takeId(fixed))
+                    childProvider.releaseId(fixed);
+            }
+        }
+        usleep(1000 + 500 * round);
+        kill(child, SIGKILL);
+        ASSERT_EQ(waitpid(child, nullptr, 0), child);
+
+        std::vector<uint32_t> orphans;
+        idProvider.sweepOrphans(std::back_inserter(orphans));
+        ASSERT_EQ(idProvider.countOfTakenIds(), 0);
+        expectConsistent(idProvider);
+    }
+}
+
+#endif
@@ -0,0 +1,208 @@
+// C++ Header
+
+// gtest framework
+#include <gtest/gtest.h>
+
+// Unique
+#include <Unique/IdProvider.hpp>
+#include <Unique/JournaledIdProvider.hpp>
+
+// Std
+#include <csignal>
+#include <cstdio>
+#include <string>
+
+#if !defined(_WIN32)
+#include <sys/resource.h>
+#include <sys/stat.h>
+#endif
+
+using namespace unique;
+
+class UniqueJournaledIdProviderTests : public ::testing::Test
+{
+public:
+    using Provider = JournaledIdProvider<IdProvider<uint32_t, 1, 0xFFFFFFFF>>;
+
+protected:
+    void SetUp() override { removeFiles(); }
+    void TearDown() override { removeFiles(); }
+
+    void removeFiles()
+    {
+        std::remove(checkpointPath.c_str());
+        std::remove(journalPath.c_str());
+    }
+
+public:
+    const std::string checkpointPath = "UniqueJournaledIdProviderTests.checkpoint";
+    const std::string journalPath = "UniqueJournaledIdProviderTests.journal";
+};
+
+TEST_F(UniqueJournaledIdProviderTests, replay)
+{
+    {
+        Provider idProvider(4);
+        ASSERT_TRUE(idProvider.open(checkpointPath, journalPath));
+        ASSERT_EQ(1u, idProvider.takeNextId());
+        ASSERT_EQ(2u, idProvider.takeNextId());
+        ASSERT_TRUE(idProvider.takeId(100000));
+        ASSERT_EQ(3u, idProvider.takeNextId());
+
+        // ) The fourth record committed the group
+        EXPECT_EQ(idProvider.countOfPendingRecords(), 0);
+        idProvider.releaseId(2);
+        EXPECT_EQ(idProvider.countOfPendingRecords(), 1);
+        ASSERT_TRUE(idProvider.commit());
+    }
+
+    // ) State come back from the checkpoint written by open and the journal
+    Provider idProvider;
+    ASSERT_TRUE(idProvider.open(checkpointPath, journalPath));
+    EXPECT_EQ(idProvider.provider().countOfTakenIds(), 3);
+    ASSERT_TRUE(idProvider.provider().isIdTaken(100000));
+    ASSERT_TRUE(idProvider.provider().isIdAvailable(2));
+    ASSERT_EQ(2u, idProvider.takeNextId());
+    ASSERT_EQ(4u, idProvider.takeNextId());
+
+    idProvider.clear();
+    ASSERT_EQ(1u, idProvider.takeNextId());
+    idProvider.close();
+
+    ASSERT_TRUE(idProvider.open(checkpointPath, journalPath));
+    EXPECT_EQ(idProvider.provider().countOfTakenIds(), 1);
+    ASSERT_EQ(2u, idProvider.takeNextId());
+}
+
+TEST_F(UniqueJournaledIdProviderTests, tornTail)
+{
+    {
+        Provider idProvider(1);
+        ASSERT_TRUE(idProvider.open(checkpointPath, journalPath));
+        ASSERT_EQ(1u, idProvider.takeNextId());
+        ASSERT_EQ(2u, idProvider.takeNextId());
+    }
+
+    // ) A batch interrupted by a crash is ignored
+    auto* journal = std::fopen(journalPath.c_str(), "ab");
+    ASSERT_NE(journal, nullptr);
+    const unsigned char torn[] = {3, 0, 0, 0, 0x12, 0x34, 0x56, 0x78, 1};
+    std::fwrite(torn, 1, sizeof(torn), journal);
+    std::fclose(journal);
+
+    Provider idProvider;
+    ASSERT_TRUE(idProvider.open(checkpointPath, journalPath));
+    EXPECT_EQ(idProvider.provider().countOfTakenIds(), 2);
+    ASSERT_EQ(3u, idProvider.takeNextId());
+}
+
+TEST_F(UniqueJournaledIdProviderTests, exhausted)
+{
+    using SmallProvider = JournaledIdProvider<IdProvider<uint8_t, 0, 16>>;
+    {
+        SmallProvider idProvider(4);
+        ASSERT_TRUE(idProvider.open(checkpointPath, journalPath));
+        for(uint8_t i = 0; i < 16; ++i) ASSERT_EQ(i, idProvider.takeNextId());
+
+        // ) Nothing is handed out nor journaled once every id is taken
+        ASSERT_FALSE(idProvider.takeNextId().has_value());
+        EXPECT_EQ(idProvider.countOfPendingRecords(), 0);
+        ASSERT_TRUE(idProvider.releaseId(3));
+        ASSERT_TRUE(idProvider.commit());
+    }
+
+    SmallProvider idProvider;
+    ASSERT_TRUE(idProvider.open(checkpointPath, journalPath));
+    EXPECT_EQ(idProvider.provider().countOfTakenIds(), 15);
+    ASSERT_EQ(3u, idProvider.takeNextId());
+    ASSERT_FALSE(idProvider.takeNextId().has_value());
+}
+
+#if !defined(_WIN32)
+TEST_F(UniqueJournaledIdProviderTests, writeFailure)
+{
+    Provider idProvider(1);
+    ASSERT_TRUE(idProvider.open(checkpointPath, journalPath));
+    ASSERT_EQ(1u, idProvider.takeNextId());
+
+    // ) Let only half of the next batch header reach the file
+    struct stat journalStat;
+    ASSERT_EQ(stat(journalPath.c_str(), &journalStat), 0);
+    rlimit limit;
+    ASSERT_EQ(getrlimit(RLIMIT_FSIZE, &limit), 0);
+    const auto previousLimit = limit.rlim_cur;
+    const auto previousHandler = std::signal(SIGXFSZ, SIG_IGN);
+    limit.rlim_cur = static_cast<rlim_t>(journalStat.st_size) + 4;
+    ASSERT_EQ(setrlimit(RLIMIT_FSIZE, &limit), 0);
+
+    // ) Failed operations aren't applied
+    const auto id = idProvider.takeNextId();
+    const auto released = idProvider.releaseId(1);
+
+    limit.rlim_cur = previousLimit;
+    ASSERT_EQ(setrlimit(RLIMIT_FSIZE, &limit), 0);
+    std::signal(SIGXFSZ, previousHandler);
+
+    ASSERT_FALSE(id.has_value());
+    ASSERT_FALSE(released);
+    ASSERT_TRUE(idProvider.provider().isIdTaken(1));
+    ASSERT_TRUE(idProvider.provider().isIdAvailable(2));
+    EXPECT_EQ(idProvider.countOfPendingRecords(), 0);
+
+    // ) The torn batch was cut, so the next batches are recovered
+    ASSERT_EQ(2u, idProvider.takeNextId());
+    ASSERT_TRUE(idProvider.releaseId(1));
+    idProvider.close();
+
+    Provider recovered;
+    ASSERT_TRUE(recovered.open(checkpointPath, journalPath));
+    EXPECT_EQ(recovered.provider().countOfTakenIds(), 1);
+    ASSERT_TRUE(recovered.provider().isIdTaken(2));
+}
+
+TEST_F(UniqueJournaledIdProviderTests, checkpointFailure)
+{
+    Provider idProvider(16);
+    ASSERT_TRUE(idProvider.open(checkpointPath, journalPath));
+    ASSERT_EQ(1u, idProvider.takeNextId());
+    ASSERT_EQ(2u, idProvider.takeNextId());
+
+    // ) The snapshot can't be written, pending records are kept
+    const auto temporaryPath = checkpointPath + ".tmp";
+    ASSERT_EQ(mkdir(temporaryPath.c_str(), 0700), 0);
+    const auto checkpointed = idProvider.checkpoint();
+    rmdir(temporaryPath.c_str());
+    ASSERT_FALSE(checkpointed);
+    EXPECT_EQ(idProvider.countOfPendingRecords(), 2);
+    idProvider.close();
+
+    Provider recovered;
+    ASSERT_TRUE(recovered.open(checkpointPath, journalPath));
+    EXPECT_EQ(recovered.provider().countOfTakenIds(), 2);
+}
+#endif
+
+TEST_F(UniqueJournaledIdProviderTests, checkpoint)
+{
+    Provider idProvider;
+    ASSERT_TRUE(idProvider.open(checkpointPath, journalPath));
+    for(uint32_t i = 0; i < 1000; ++i) idProvider.takeNextId();
+    for(uint32_t i = 1; i <= 1000; i += 2) idProvider.releaseId(i);
+    ASSERT_TRUE(idProvider.checkpoint());
+    ASSERT_EQ(1u, idProvider.takeNextId());
+    idProvider.close();
+
+    // ) Only the records written after the checkpoint are replayed
+    Provider recovered;
+    ASSERT_TRUE(recovered.open(checkpointPath, journalPath));
+    EXPECT_EQ(recovered.provider().countOfTakenIds(), 501);
+    ASSERT_EQ(3u, recovered.takeNextId());
+
+    // ) A corrupted checkpoint isn't silently replaced by an empty provider
+    recovered.close();
+    auto* checkpoint = std::fopen(checkpointPath.c_str(), "r+b");
+    ASSERT_NE(checkpoint, nullptr);
+    std::fputc(0, checkpoint);
+    std::fclose(checkpoint);
+    ASSERT_FALSE(recovered.open(checkpointPath, journalPath));
+}
@@ -0,0 +1,120 @@
+// C++ Header
+
+// gtest framework
+#include <gtest/gtest.h>
+
+// Unique
+#include <Unique/IdProvider.hpp>
+#include <Unique/LeasedIdProvider.hpp>
+
+// Std
+#include <iterator>
+#include <map>
+#include <random>
+#include <vector>
+
+using namespace unique;
+
+using Leases = LeasedIdProvider<IdProvider<uint32_t, 1, 0xFFFFFFFF>>;
+
+TEST(UniqueLeasedIdProviderTests, expire)
+{
+    Leases leases;
+    const auto a = leases.takeNextId(10);
+    const auto b = leases.takeNextId(100);
+    const auto c = leases.takeNextId(5000);
+    ASSERT_TRUE(leases.takeId(50, 10));
+    EXPECT_EQ(leases.countOfLeases(), 4);
+
+    std::vector<uint32_t> expired;
+    leases.advance(9, std::back_inserter(expired));
+    ASSERT_TRUE(expired.empty());
+
+    // ) a expire on its deadline, b was renewed and 50 was released
+    ASSERT_TRUE(leases.renew(b, 200));
+    leases.releaseId(50);
+    leases.advance(10, std::back_inserter(expired));
+    ASSERT_EQ(expired, std::vector<uint32_t>({a}));
+    ASSERT_TRUE(leases.provider().isIdAvailable(a));
+    ASSERT_FALSE(leases.renew(a));
+
+    // ) A single advance cross levels of the wheel
+    expired.clear();
+    leases.advance(5000, std::back_inserter(expired));
+    ASSERT_EQ(expired, std::vector<uint32_t>({b, c}));
+    EXPECT_EQ(leases.countOfLeases(), 0);
+    EXPECT_EQ(leases.provider().countOfTakenIds(), 0);
+}
+
+TEST(UniqueLeasedIdProviderTests, overflow)
+{
+    // ) Leases beyond 2^24 ticks wait in the overflow list
+    Leases leases(1000);
+    const auto id = leases.takeNextId(100000000);
+    std::vector<uint32_t> expired;
+    leases.advance(100000999, std::back_inserter(expired));
+    ASSERT_TRUE(expired.empty());
+    ASSERT_TRUE(leases.isLeased(id));
+    leases.advance(100001000, std::back_inserter(expired));
+    ASSERT_EQ(expired, std::vector<uint32_t>({id}));
+}
+
+TEST(UniqueLeasedIdProviderTests, matchDeadlines)
+{
+    // ) Random leases, renewals and jumps, against a map of deadlines
+    Leases leases;
+    std::map<uint32_t, uint64_t> deadlines;
+    std::mt19937_64 random(7);
+    const uint64_t ttls[] = {1, 63, 64, 65, 4095, 4097, 300000, 20000000};
+    for(int i = 0; i < 20000; ++i)
+    {
+        const auto ttl = ttls[random() % 8] + random() % 3;
+        switch(random() % 4)
+        {
+            case 0:
+            {
+                const auto id = leases.takeNextId(ttl);
+                deadlines[id] = leases.now() + ttl;
+                break;
+            }
+            case 1:
+                if(!deadlines.empty())
+                {
+                    const auto it = std::next(deadlines.begin(), random() % deadlines.size());
+                    ASSERT_TRUE(leases.renew(it->first, ttl));
+                    it->second = leases.now() + ttl;
+                }
+                break;
+            case 2:
+                if(!deadlines.empty() && random() % 4 == 0)
+                {
+                    const auto it = std::next(deadlines.begin(), random() % deadlines.size());
+                    leases.releaseId(it->first);
+                    deadlines.erase(it);
+                }
+                break;
+            default:
+            {
+                const auto now = leases.now() + (random() % 2 ? random() % 100 : random() % 1000000);
+                std::vector<uint32_t> expired;
+                leases.advance(now, std::back_inserter(expired));
+                std::vector<uint32_t> expected;
+                for(auto it = deadlines.begin(); it != deadlines.end();)
+                {
+                    if(it->second <= now)
+                    {
+                        expected.push_back(it->first);
+                        it = deadlines.erase(it);
+                    }
+                    else
+                        ++it;
+                }
+                std::sort(expired.begin(), expired.end());
+                ASSERT_EQ(expired, expected);
+                break;
+            }
+        }
+        ASSERT_EQ(leases.countOfLeases(), deadlines.size());
+    }
+    for(const auto& deadline: deadlines) ASSERT_EQ(leases.deadlineOf(deadline.first), deadline.second);
+}
@@ -4,5 +4,400 @@
 #include <gtest/gtest.h>
 
 // Unique
+#include <Unique/BTreeMap.hpp>
+#include <Unique/FlatMap.hpp>
+#include <Unique/FlatUnorderedMap.hpp>
 #include <Unique/Map.hpp>
 #include <Unique/UnorderedMap.hpp>
+
+// Std
+#include <atomic>
+#include <cstdlib>
+#include <functional>
+#include <map>
+#include <memory>
+#include <new>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+using namespace unique;
+
+namespace {
+
+/** Count of calls to operator new of the whole test program */
+std::atomic<std::size_t> allocationCount {0};
+
+/** Key that count its constructions from a value and its copies. Moves aren't counted */
+template<int Tag>
+struct Tracked
+{
+    static inline int constructions = 0;
+    static inline int copies = 0;
+
+    static void reset()
+    {
+        constructions = 0;
+        copies = 0;
+    }
+
+    explicit Tracked(const int v) : value(v) { ++constructions; }
+    Tracked(const Tracked& other) : value(other.value) { ++copies; }
+    Tracked(Tracked&& other) noexcept = default;
+    Tracked& operator=(const Tracked& other)
+    {
+        value = other.value;
+        ++copies;
+        return *this;
+    }
+    Tracked& operator=(Tracked&& other) noexcept = default;
+
+    friend bool operator<(const Tracked& a, const Tracked& b) { return a.value < b.value; }
+    friend bool operator==(const Tracked& a, const Tracked& b) { return a.value == b.value; }
+
+    int value;
+};
+
+using Tracked1 = Tracked<1>;
+using Tracked2 = Tracked<2>;
+
+/** Longer than the small string buffer, so that each copy allocate */
+std::string longString(const int i) { return "a string too long for the small buffer #" + std::to_string(i); }
+std::wstring longWString(const int i) { return L"a string too long for the small buffer #" + std::to_wstring(i); }
+
+}
+
+namespace std {
+
+template<int Tag>
+struct hash<Tracked<Tag>>
+{
+    std::size_t operator()(const Tracked<Tag>& tracked) const { return std::hash<int>()(tracked.value); }
+};
+
+}
+
+void* operator new(std::size_t size)
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if(void* pointer = std::malloc(size ? size : 1))
+        return pointer;
+    throw std::bad_alloc();
+}
+
+// ) Every replaceable form is routed to malloc/free, so that no allocation mix our operators with the library ones
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    return std::malloc(size ? size : 1);
+}
+
+void* operator new[](std::size_t size) { return operator new(size); }
+
+void* operator new[](std::size_t size, const std::nothrow_t& tag) noexcept { return operator new(size, tag); }
+
+// ) GCC pair operator new with operator delete, and warn about the free of a pointer from operator new once inlined
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+    #pragma GCC diagnostic push
+    #pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+void operator delete(void* pointer) noexcept { std::free(pointer); }
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+    #pragma GCC diagnostic pop
+#endif
+
+void operator delete(void* pointer, std::size_t) noexcept { operator delete(pointer); }
+
+void operator delete(void* pointer, const std::nothrow_t&) noexcept { operator delete(pointer); }
+
+void operator delete[](void* pointer) noexcept { operator delete(pointer); }
+
+void operator delete[](void* pointer, std::size_t) noexcept { operator delete(pointer); }
+
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept { operator delete(pointer); }
+
+template<class Bimap>
+class UniqueMapInsertTests : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        Tracked1::reset();
+        Tracked2::reset();
+    }
+
+public:
+    Bimap map;
+};
+
+/** Few pairs per map, BPlusTree copy keys in its inner nodes when a leaf is split */
+using UniqueMapInsertTypes = ::testing::Types<Map<Tracked1, Tracked2>, UnorderedMap<Tracked1, Tracked2>,
+    FlatMap<Tracked1, Tracked2>, BTreeMap<Tracked1, Tracked2>>;
+TYPED_TEST_SUITE(UniqueMapInsertTests, UniqueMapInsertTypes);
+
+TYPED_TEST(UniqueMapInsertTests, insertMovePair)
+{
+    // ) Each key is copied in one map, and moved in the other
+    ASSERT_TRUE(this->map.insert(std::pair<Tracked1, Tracked2>(Tracked1(1), Tracked2(10))).second);
+    EXPECT_EQ(Tracked1::copies, 1);
+    EXPECT_EQ(Tracked2::copies, 1);
+
+    ASSERT_TRUE(this->map.insert(std::pair<Tracked2, Tracked1>(Tracked2(20), Tracked1(2))).second);
+    EXPECT_EQ(Tracked1::copies, 2);
+    EXPECT_EQ(Tracked2::copies, 2);
+
+    // ) A refused pair isn't copied
+    EXPECT_FALSE(this->map.insert(std::pair<Tracked1, Tracked2>(Tracked1(3), Tracked2(10))).second);
+    EXPECT_FALSE(this->map.insert(std::pair<Tracked1, Tracked2>(Tracked1(1), Tracked2(30))).second);
+    EXPECT_EQ(Tracked1::copies, 2);
+    EXPECT_EQ(Tracked2::copies, 2);
+    EXPECT_EQ(this->map.find(Tracked2(20))->second, Tracked1(2));
+}
+
+TYPED_TEST(UniqueMapInsertTests, insertCopy)
+{
+    // ) A const value is copied once per map
+    const typename TypeParam::Key1ValueType value(Tracked1(1), Tracked2(10));
+    Tracked1::reset();
+    Tracked2::reset();
+    ASSERT_TRUE(this->map.insert(value).second);
+    EXPECT_EQ(Tracked1::copies, 2);
+    EXPECT_EQ(Tracked2::copies, 2);
+
+    const auto hinted = this->map.insert(this->map.cend1(), typename TypeParam::Key1ValueType(Tracked1(2), Tracked2(20)));
+    EXPECT_EQ(hinted->first, Tracked1(2));
+    EXPECT_EQ(this->map.size(), 2);
+    EXPECT_EQ(this->map.find(Tracked2(20))->second, Tracked1(2));
+}
+
+TYPED_TEST(UniqueMapInsertTests, emplace)
+{
+    // ) Keys are constructed once from the arguments
+    ASSERT_TRUE(this->map.emplace(1, 10).second);
+    EXPECT_EQ(Tracked1::constructions, 1);
+    EXPECT_EQ(Tracked2::constructions, 1);
+    EXPECT_EQ(Tracked1::copies, 1);
+    EXPECT_EQ(Tracked2::copies, 1);
+    EXPECT_EQ(this->map.find(Tracked2(10))->second, Tracked1(1));
+}
+
+TYPED_TEST(UniqueMapInsertTests, tryEmplace)
+{
+    ASSERT_TRUE(this->map.try_emplace(Tracked1(1), 10).second);
+    EXPECT_EQ(Tracked2::constructions, 1);
+    EXPECT_EQ(Tracked1::copies, 1);
+    EXPECT_EQ(Tracked2::copies, 1);
+
+    // ) Key2 isn't constructed when Key1 is already present
+    const auto present = this->map.try_emplace(Tracked1(1), 20);
+    EXPECT_FALSE(present.second);
+    EXPECT_EQ(Tracked2::constructions, 1);
+    EXPECT_EQ(present.first->second.value, 10);
+
+    ASSERT_TRUE(this->map.try_emplace(Tracked2(30), 3).second);
+    EXPECT_EQ(Tracked1::copies, 2);
+    EXPECT_EQ(Tracked2::copies, 2);
+    EXPECT_EQ(this->map.find(Tracked1(3))->second, Tracked2(30));
+}
+
+TEST(UniqueMapTests, insertAllocations)
+{
+    Map<std::string, std::wstring> map;
+    auto key1 = longString(1);
+    auto key2 = longWString(2);
+
+    // ) A node per map, and a copy of each string. The moved strings are stolen
+    auto before = allocationCount.load();
+    ASSERT_TRUE(map.insert(std::make_pair(std::move(key1), std::move(key2))).second);
+    EXPECT_EQ(allocationCount.load() - before, 4);
+
+    // ) Nothing is allocated when a key is already present
+    auto present1 = longString(1);
+    auto present2 = longWString(2);
+    auto absent1 = longString(3);
+    auto absent2 = longWString(4);
+    before = allocationCount.load();
+    EXPECT_FALSE(map.insert(std::make_pair(std::move(absent1), std::move(present2))).second);
+    EXPECT_FALSE(map.insert(std::make_pair(std::move(present1), std::move(absent2))).second);
+    EXPECT_FALSE(map.try_emplace(map.begin()->first, L"a Key2 that would be allocated if it was constructed").second);
+    EXPECT_EQ(allocationCount.load() - before, 0);
+
+    // ) Same for keys constructed by emplace
+    auto emplaced1 = longString(5);
+    auto emplaced2 = longWString(6);
+    before = allocationCount.load();
+    ASSERT_TRUE(map.emplace(std::move(emplaced1), std::move(emplaced2)).second);
+    EXPECT_EQ(allocationCount.load() - before, 4);
+    EXPECT_EQ(map.find(longWString(6))->second, longString(5));
+}
+
+TYPED_TEST(UniqueMapInsertTests, moveAndSwap)
+{
+    for(int i = 1; i <= 3; ++i) ASSERT_TRUE(this->map.emplace(i, i * 10).second);
+
+    // ) Rekey in the first map
+    EXPECT_TRUE(this->map.move(Tracked1(1), Tracked1(4)));
+    EXPECT_FALSE(this->map.move(Tracked1(9), Tracked1(5)));
+    EXPECT_FALSE(this->map.move(Tracked1(4), Tracked1(2)));
+    EXPECT_FALSE(this->map.contains(Tracked1(1)));
+    EXPECT_EQ(this->map.find(Tracked2(10))->second, Tracked1(4));
+
+    // ) Rekey in the second map
+    EXPECT_FALSE(this->map.move(Tracked1(9), Tracked2(90)));
+    EXPECT_FALSE(this->map.move(Tracked1(4), Tracked2(20)));
+    EXPECT_TRUE(this->map.move(Tracked1(4), Tracked2(10)));
+    EXPECT_TRUE(this->map.move(Tracked1(4), Tracked2(40)));
+    EXPECT_FALSE(this->map.contains(Tracked2(10)));
+    EXPECT_EQ(this->map.find(Tracked2(40))->second, Tracked1(4));
+    EXPECT_EQ(this->map.find(Tracked1(4))->second, Tracked2(40));
+
+    // ) Swap no key is copied
+    Tracked1::reset();
+    Tracked2::reset();
+    EXPECT_TRUE(this->map.swap(Tracked1(2), Tracked1(3)));
+    EXPECT_TRUE(this->map.swap(Tracked1(2), Tracked1(2)));
+    EXPECT_EQ(Tracked1::copies, 0);
+    EXPECT_EQ(Tracked2::copies, 0);
+    EXPECT_FALSE(this->map.swap(Tracked1(2), Tracked1(9)));
+    EXPECT_FALSE(this->map.swap(Tracked2(90), Tracked2(20)));
+    EXPECT_EQ(this->map.find(Tracked1(2))->second, Tracked2(30));
+    EXPECT_EQ(this->map.find(Tracked2(30))->second, Tracked1(2));
+    EXPECT_EQ(this->map.find(Tracked2(20))->second, Tracked1(3));
+    EXPECT_EQ(this->map.size(), 3);
+}
+
+TYPED_TEST(UniqueMapInsertTests, moveMany)
+{
+    for(int i = 1; i <= 2; ++i) ASSERT_TRUE(this->map.emplace(i, i * 10).second);
+
+    // ) Moves are applied in order, so a move can take the key released by a previous one
+    const std::vector<std::pair<Tracked1, Tracked1>> moves {
+        {Tracked1(1), Tracked1(5)}, {Tracked1(2), Tracked1(1)}, {Tracked1(9), Tracked1(6)}, {Tracked1(5), Tracked1(2)}};
+    EXPECT_EQ(this->map.moveMany(moves.begin(), moves.end()), 3);
+    EXPECT_EQ(this->map.find(Tracked2(10))->second, Tracked1(2));
+    EXPECT_EQ(this->map.find(Tracked2(20))->second, Tracked1(1));
+    EXPECT_EQ(this->map.find(Tracked1(2))->second, Tracked2(10));
+    EXPECT_EQ(this->map.size(), 2);
+}
+
+namespace {
+
+/** Node based maps rekey and swap by reusing their nodes */
+template<class Bimap>
+void expectRekeyWithoutAllocation()
+{
+    Bimap map;
+    for(int i = 0; i < 100; ++i) ASSERT_TRUE(map.emplace(i, longString(i)).second);
+
+    const std::vector<std::pair<int, int>> moves {{2000, 3000}, {2001, 2000}};
+    const auto before = allocationCount.load();
+    for(int i = 0; i < 100; ++i) ASSERT_TRUE(map.move(i, i + 1000));
+    for(int i = 0; i < 100; ++i) ASSERT_TRUE(map.move(longString(i), i + 2000));
+    EXPECT_EQ(map.moveMany(moves.begin(), moves.end()), 2);
+    EXPECT_TRUE(map.swap(3000, 2002));
+    EXPECT_EQ(allocationCount.load() - before, 100);  // ) Only the longString temporaries
+
+    EXPECT_EQ(map.find(2002)->second, longString(0));
+    EXPECT_EQ(map.find(longString(2))->second, 3000);
+    EXPECT_EQ(map.find(longString(1))->second, 2000);
+    EXPECT_EQ(map.size(), 100);
+}
+
+}
+
+TEST(UniqueMapTests, rekeyAllocations)
+{
+    expectRekeyWithoutAllocation<Map<int, std::string>>();
+    expectRekeyWithoutAllocation<UnorderedMap<int, std::string>>();
+}
+
+// ) Map and UnorderedMap keep the std defaults, transparent lookup is opt in
+static_assert(std::is_same<Map<int, std::string>::Key1Map, std::map<int, std::string>>::value, "Map should use std::less");
+static_assert(std::is_same<UnorderedMap<int, std::string>::Key2Map, std::unordered_map<std::string, int>>::value,
+    "UnorderedMap should use std::hash");
+
+TEST(UniqueMapTests, transparentLookup)
+{
+    TransparentMap<std::string, std::shared_ptr<int>> map;
+    const auto object = std::make_shared<int>(1);
+    ASSERT_TRUE(map.insert({longString(1), object}).second);
+    ASSERT_TRUE(map.insert({longString(2), std::make_shared<int>(2)}).second);
+
+    // ) std::string_view and raw pointers are compared without building a key
+    const auto key = longString(1);
+    const std::string_view view = key;
+    const auto before = allocationCount.load();
+    EXPECT_EQ(map.find(view)->second, object);
+    EXPECT_TRUE(map.contains(view));
+    EXPECT_FALSE(map.contains(std::string_view("absent")));
+    EXPECT_EQ(map.find(object.get())->second, key);
+    EXPECT_TRUE(map.contains(object.get()));
+    EXPECT_EQ(map.erase(object.get()), 1);
+    EXPECT_EQ(map.erase(view), 0);
+    EXPECT_EQ(allocationCount.load() - before, 0);
+
+    const auto other = longString(2);
+    EXPECT_EQ(map.erase(std::string_view(other)), 1);
+    EXPECT_TRUE(map.empty());
+}
+
+TEST(UniqueMapTests, transparentUnorderedLookup)
+{
+    TransparentUnorderedMap<std::string, std::shared_ptr<int>> map;
+    const auto object = std::make_shared<int>(1);
+    ASSERT_TRUE(map.insert({longString(1), object}).second);
+    ASSERT_TRUE(map.insert({longString(2), std::make_shared<int>(2)}).second);
+
+    // ) Heterogeneous lookup in C++17 too: std::string_view and raw pointers don't build a key
+    const auto key = longString(1);
+    const std::string_view view = key;
+    const auto before = allocationCount.load();
+    EXPECT_EQ(map.find(view)->second, object);
+    EXPECT_TRUE(map.contains(view));
+    EXPECT_FALSE(map.contains(std::string_view("absent")));
+    EXPECT_EQ(map.find(object.get())->second, key);
+    EXPECT_TRUE(map.contains(object.get()));
+    EXPECT_EQ(map.erase(object.get()), 1);
+    EXPECT_EQ(map.erase(view), 0);
+    EXPECT_EQ(allocationCount.load() - before, 0);
+
+    const auto other = longString(2);
+    EXPECT_EQ(map.erase(std::string_view(other)), 1);
+    EXPECT_TRUE(map.empty());
+}
+
+TEST(UniqueMapTests, lookupKeyBuildKey)
+{
+    // ) Without transparent functors, a std::string is built from the view for each lookup
+    UnorderedMap<std::string, int> unorderedMap;
+    Map<std::string, int> map;
+    ASSERT_TRUE(unorderedMap.insert({longString(1), 1}).second);
+    ASSERT_TRUE(map.insert({longString(1), 1}).second);
+
+    const auto key = longString(1);
+    const std::string_view view = key;
+    EXPECT_EQ(unorderedMap.find(view)->second, 1);
+    EXPECT_TRUE(map.contains(view));
+    EXPECT_FALSE(unorderedMap.contains(std::string_view("absent")));
+    EXPECT_EQ(unorderedMap.erase(view), 1);
+    EXPECT_EQ(map.erase(view), 1);
+    EXPECT_TRUE(unorderedMap.empty());
+    EXPECT_TRUE(map.empty());
+}
+
+TEST(UniqueMapTests, transparentSmartPointer)
+{
+    // ) Smart pointers hash and compare like their raw pointer
+    std::map<std::unique_ptr<int>, int, TransparentLess> map;
+    auto owned = std::make_unique<int>(1);
+    const auto raw = owned.get();
+    map.emplace(std::move(owned), 1);
+    map.emplace(std::make_unique<int>(2), 2);
+    EXPECT_EQ(map.find(raw)->second, 1);
+    EXPECT_EQ(TransparentHash()(map.find(raw)->first), std::hash<int*>()(raw));
+    EXPECT_EQ(TransparentHash()(longString(3)), std::hash<std::string>()(longString(3)));
+    EXPECT_TRUE(TransparentEqual()(map.find(raw)->first, raw));
+}
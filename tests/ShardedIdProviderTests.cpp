@@ -0,0 +1,122 @@
+// C++ Header
+
+// gtest framework
+#include <gtest/gtest.h>
+
+// Unique
+#include <Unique/ShardedIdProvider.hpp>
+
+// Std
+#include <algorithm>
+#include <atomic>
+#include <iterator>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace unique;
+
+TEST(UniqueShardedIdProviderTests, routing)
+{
+    // ) 100 ids in 3 shards: [10, 43), [43, 76), [76, 110)
+    ShardedIdProvider<uint32_t> idProvider(10, 110, 3);
+    ASSERT_EQ(idProvider.shardCount(), 3);
+    ASSERT_EQ(idProvider.shardBegin(1), 43u);
+    ASSERT_EQ(idProvider.shardEnd(1), 76u);
+    ASSERT_EQ(idProvider.shardEnd(2), 110u);
+    ASSERT_EQ(idProvider.shardOf(10), 0);
+    ASSERT_EQ(idProvider.shardOf(42), 0);
+    ASSERT_EQ(idProvider.shardOf(43), 1);
+    ASSERT_EQ(idProvider.shardOf(108), 2);
+    ASSERT_EQ(idProvider.shardOf(109), 2);
+
+    // ) Each shard hand out its own sub-range
+    ASSERT_EQ(10u, idProvider.takeNextId(0));
+    ASSERT_EQ(43u, idProvider.takeNextId(1));
+    ASSERT_EQ(76u, idProvider.takeNextId(2));
+    ASSERT_EQ(44u, idProvider.takeNextId(1));
+    ASSERT_TRUE(idProvider.takeId(100));
+    ASSERT_FALSE(idProvider.takeId(43));
+    EXPECT_EQ(idProvider.countOfTakenIds(), 5);
+
+    // ) Released ids go back to their shard
+    idProvider.releaseId(43);
+    ASSERT_TRUE(idProvider.isIdAvailable(43));
+    ASSERT_EQ(11u, idProvider.takeNextId(0));
+    ASSERT_EQ(43u, idProvider.takeNextId(1));
+
+    idProvider.clear();
+    EXPECT_EQ(idProvider.countOfTakenIds(), 0);
+    ASSERT_EQ(76u, idProvider.takeNextId(2));
+}
+
+TEST(UniqueShardedIdProviderTests, stealing)
+{
+    ShardedIdProvider<uint8_t> idProvider(0, 8, 4);
+
+    // ) Shard 0 own [0, 2) then steal from shard 1, 2 and 3
+    std::vector<uint8_t> ids;
+    for(int i = 0; i < 8; ++i) ids.push_back(idProvider.takeNextId(0));
+    const std::vector<uint8_t> expected = {0, 1, 2, 3, 4, 5, 6, 7};
+    ASSERT_EQ(ids, expected);
+    ASSERT_FALSE(idProvider.areIdsAvailables());
+
+    // ) A stolen id is released to the shard owning it
+    idProvider.releaseId(5);
+    ASSERT_TRUE(idProvider.areIdsAvailables());
+    ASSERT_EQ(5, idProvider.takeNextId(2));
+
+    idProvider.releaseId(1);
+    idProvider.releaseId(6);
+    idProvider.releaseId(7);
+    ids.clear();
+    idProvider.takeNextIds(3, 8, std::back_inserter(ids));
+    const std::vector<uint8_t> stolen = {6, 7, 1};
+    ASSERT_EQ(ids, stolen);
+    EXPECT_EQ(idProvider.countOfTakenIds(), 8);
+}
+
+TEST(UniqueShardedIdProviderTests, uniquenessUnderContention)
+{
+    constexpr uint32_t idSpace = 1 << 12;
+    const auto threadCount = std::max(4u, std::thread::hardware_concurrency());
+    ShardedIdProvider<uint32_t> idProvider(0, idSpace, threadCount);
+
+    // ) Each id own a flag, set by the thread that got it. Setting an already set flag mean the id was handed out twice
+    std::unique_ptr<std::atomic<uint8_t>[]> owned(new std::atomic<uint8_t>[idSpace]);
+    for(uint32_t i = 0; i < idSpace; ++i) owned[i] = 0;
+    std::atomic<bool> duplicate(false);
+
+    std::vector<std::thread> threads;
+    for(unsigned t = 0; t < threadCount; ++t)
+    {
+        threads.emplace_back([&, t]()
+        {
+            // ) Odd threads take more than their shard and steal from even threads, that take less.
+            // There is never more ids asked than idSpace
+            const auto width = idSpace / threadCount;
+            const auto count = (t % 2) ? width + width / 2 : width / 2;
+            std::vector<uint32_t> ids;
+            for(int round = 0; round < 50; ++round)
+            {
+                for(uint32_t i = 0; i < count; ++i)
+                {
+                    const auto id = idProvider.takeNextId(t);
+                    if(owned[id].exchange(1))
+                        duplicate = true;
+                    ids.push_back(id);
+                }
+                for(const auto id: ids)
+                {
+                    owned[id] = 0;
+                    idProvider.releaseId(id);
+                }
+                ids.clear();
+            }
+        });
+    }
+    for(auto& thread: threads) thread.join();
+
+    ASSERT_FALSE(duplicate);
+    EXPECT_EQ(idProvider.countOfTakenIds(), 0);
+}